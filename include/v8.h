@@ -1456,6 +1456,21 @@ enum AccessControl {
 };
 
 
+/**
+ * The kinds of values an internal field accessor can read.
+ *
+ * INTERNAL_FIELD_VALUE reads the value stored in the internal field.
+ * INTERNAL_FIELD_INT32 and INTERNAL_FIELD_DOUBLE read a number at a fixed
+ * byte offset in the C++ object whose pointer was stored in the internal
+ * field with SetPointerInInternalField.
+ */
+enum InternalFieldAccessorType {
+  INTERNAL_FIELD_VALUE  = 0,
+  INTERNAL_FIELD_INT32  = 1,
+  INTERNAL_FIELD_DOUBLE = 2
+};
+
+
 /**
  * A JavaScript object (ECMA-262, 4.3.3)
  */
@@ -2148,6 +2163,29 @@ class V8EXPORT ObjectTemplate : public Template {
                    AccessControl settings = DEFAULT,
                    PropertyAttribute attribute = None);
 
+  /**
+   * Sets a read-only accessor on the object template that reads an
+   * internal field of the object, or a number inside the C++ object the
+   * internal field points to.
+   *
+   * Unlike accessors with a getter callback, loads of these properties
+   * are compiled into inline loads without calling into C++.
+   *
+   * \param name The name of the property for which an accessor is added.
+   * \param index The index of the internal field.
+   * \param type What to read from the internal field.
+   * \param offset The byte offset of the number in the C++ object for
+   *   INTERNAL_FIELD_INT32 and INTERNAL_FIELD_DOUBLE.
+   * \param attribute The attributes of the property for which an accessor
+   *   is added.
+   */
+  void SetInternalFieldAccessor(Handle<String> name,
+                                int index,
+                                InternalFieldAccessorType type =
+                                    INTERNAL_FIELD_VALUE,
+                                int offset = 0,
+                                PropertyAttribute attribute = None);
+
   /**
    * Sets a named property handler on the object template.
    *
@@ -3456,7 +3494,7 @@ class Internals {
   static const int kFullStringRepresentationMask = 0x07;
   static const int kExternalTwoByteRepresentationTag = 0x02;
 
-  static const int kJSObjectType = 0x9f;
+  static const int kJSObjectType = 0xa0;
   static const int kFirstNonstringType = 0x80;
   static const int kProxyType = 0x85;
 
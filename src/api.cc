@@ -874,6 +874,18 @@ static i::Handle<i::AccessorInfo> MakeAccessorInfo(
 }
 
 
+static void AddPropertyAccessor(i::Handle<i::FunctionTemplateInfo> info,
+                                i::Handle<i::AccessorInfo> obj) {
+  i::Handle<i::Object> list(info->property_accessors());
+  if (list->IsUndefined()) {
+    list = NeanderArray().value();
+    info->set_property_accessors(*list);
+  }
+  NeanderArray array(list);
+  array.add(obj);
+}
+
+
 void FunctionTemplate::AddInstancePropertyAccessor(
       v8::Handle<String> name,
       AccessorGetter getter,
@@ -890,13 +902,7 @@ void FunctionTemplate::AddInstancePropertyAccessor(
   i::Handle<i::AccessorInfo> obj = MakeAccessorInfo(name,
                                                     getter, setter, data,
                                                     settings, attributes);
-  i::Handle<i::Object> list(Utils::OpenHandle(this)->property_accessors());
-  if (list->IsUndefined()) {
-    list = NeanderArray().value();
-    Utils::OpenHandle(this)->set_property_accessors(*list);
-  }
-  NeanderArray array(list);
-  array.add(obj);
+  AddPropertyAccessor(Utils::OpenHandle(this), obj);
 }
 
 
@@ -1068,6 +1074,61 @@ void ObjectTemplate::SetAccessor(v8::Handle<String> name,
 }
 
 
+// The getter of accessors set with SetInternalFieldAccessor.  The load
+// ICs inline the same reads instead of calling it.
+static v8::Handle<Value> InternalFieldAccessorGetter(Local<String> property,
+                                                    const AccessorInfo& info) {
+  typedef i::AccessorInfo I;
+  uint32_t descriptor = static_cast<uint32_t>(info.Data()->Int32Value());
+  int index = I::InternalFieldIndexField::decode(descriptor);
+  Local<Object> holder = info.Holder();
+  if (index >= holder->InternalFieldCount()) return Undefined();
+  InternalFieldAccessorType type =
+      I::InternalFieldTypeField::decode(descriptor);
+  if (type == INTERNAL_FIELD_VALUE) return holder->GetInternalField(index);
+  uint8_t* object =
+      reinterpret_cast<uint8_t*>(holder->GetPointerFromInternalField(index));
+  if (object == NULL) return Undefined();
+  int offset = I::InternalFieldOffsetField::decode(descriptor);
+  if (type == INTERNAL_FIELD_INT32) {
+    return Integer::New(*reinterpret_cast<int32_t*>(object + offset));
+  }
+  ASSERT(type == INTERNAL_FIELD_DOUBLE);
+  return Number::New(*reinterpret_cast<double*>(object + offset));
+}
+
+
+void ObjectTemplate::SetInternalFieldAccessor(v8::Handle<String> name,
+                                              int index,
+                                              InternalFieldAccessorType type,
+                                              int offset,
+                                              PropertyAttribute attribute) {
+  if (IsDeadCheck("v8::ObjectTemplate::SetInternalFieldAccessor()")) return;
+  typedef i::AccessorInfo I;
+  if (!ApiCheck(I::InternalFieldIndexField::is_valid(index) &&
+                I::InternalFieldOffsetField::is_valid(offset),
+                "v8::ObjectTemplate::SetInternalFieldAccessor()",
+                "Internal field index or offset out of range")) {
+    return;
+  }
+  ENTER_V8;
+  HandleScope scope;
+  EnsureConstructor(this);
+  i::FunctionTemplateInfo* constructor =
+      i::FunctionTemplateInfo::cast(Utils::OpenHandle(this)->constructor());
+  i::Handle<i::FunctionTemplateInfo> cons(constructor);
+  uint32_t descriptor = I::InternalFieldTypeField::encode(type) |
+                        I::InternalFieldIndexField::encode(index) |
+                        I::InternalFieldOffsetField::encode(offset);
+  i::Handle<i::AccessorInfo> obj =
+      MakeAccessorInfo(name, InternalFieldAccessorGetter, 0,
+                       Integer::New(static_cast<int>(descriptor)), DEFAULT,
+                       attribute);
+  obj->set_is_internal_field_accessor(true);
+  AddPropertyAccessor(cons, obj);
+}
+
+
 void ObjectTemplate::SetNamedPropertyHandler(NamedPropertyGetter getter,
                                              NamedPropertySetter setter,
                                              NamedPropertyQuery query,
@@ -2993,8 +3054,26 @@ int String::WriteUtf8(char* buffer,
     // using StringInputBuffer or Get(i) to access the characters.
     str->TryFlatten();
   }
-  write_input_buffer.Reset(0, *str);
   int len = str->length();
+  bool is_flat = str->IsFlat();
+  if (is_flat && str->IsAsciiRepresentation()) {
+    // Ascii characters are their own UTF-8 encoding, so they can be
+    // copied directly into the buffer.
+    int nchars = (capacity == -1) ? len : i::Max(0, i::Min(len, capacity));
+    i::Vector<const char> chars = str->ToAsciiVector();
+    memcpy(buffer, chars.start(), nchars);
+    if (nchars_ref != NULL) *nchars_ref = nchars;
+    if (nchars == len && (capacity == -1 || nchars < capacity))
+      buffer[nchars++] = '\0';
+    return nchars;
+  }
+  // The characters of a flat string are read directly.
+  i::Vector<const i::uc16> flat_chars;
+  if (is_flat) {
+    flat_chars = str->ToUC16Vector();
+  } else {
+    write_input_buffer.Reset(0, *str);
+  }
   // Encode the first K - 3 bytes directly into the buffer since we
   // know there's room for them.  If no capacity is given we copy all
   // of them here.
@@ -3003,7 +3082,7 @@ int String::WriteUtf8(char* buffer,
   int pos = 0;
   int nchars = 0;
   for (i = 0; i < len && (capacity == -1 || pos < fast_end); i++) {
-    i::uc32 c = write_input_buffer.GetNext();
+    i::uc32 c = is_flat ? flat_chars[i] : write_input_buffer.GetNext();
     int written = unibrow::Utf8::Encode(buffer + pos, c);
     pos += written;
     nchars++;
@@ -3014,7 +3093,7 @@ int String::WriteUtf8(char* buffer,
     // buffer.
     char intermediate[unibrow::Utf8::kMaxEncodedSize];
     for (; i < len && pos < capacity; i++) {
-      i::uc32 c = write_input_buffer.GetNext();
+      i::uc32 c = is_flat ? flat_chars[i] : write_input_buffer.GetNext();
       int written = unibrow::Utf8::Encode(intermediate, c);
       if (pos + written <= capacity) {
         for (int j = 0; j < written; j++)
@@ -1242,6 +1242,23 @@ void Builtins::Generate_FunctionCall(MacroAssembler* masm) {
 }
 
 
+// Load the map of arguments objects from the global context of the
+// current context.
+static void GenerateLoadArgumentsBoilerplateMap(MacroAssembler* masm,
+                                                Register result) {
+  __ ldr(result, MemOperand(cp, Context::SlotOffset(Context::GLOBAL_INDEX)));
+  __ ldr(result, FieldMemOperand(result, GlobalObject::kGlobalContextOffset));
+  __ ldr(result, MemOperand(result, Context::SlotOffset(
+      Context::ARGUMENTS_BOILERPLATE_INDEX)));
+  __ ldr(result, FieldMemOperand(result, HeapObject::kMapOffset));
+}
+
+
+// Function.prototype.apply copies at most this many arguments without
+// calling APPLY_PREPARE; it matches the limit checked there.
+static const int kMaxFastApplyLength = 0x800000;
+
+
 void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   const int kIndexOffset    = -5 * kPointerSize;
   const int kLimitOffset    = -4 * kPointerSize;
@@ -1251,11 +1268,40 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
 
   __ EnterInternalFrame();
 
+  // Skip APPLY_PREPARE if the function is a JSFunction and the arguments
+  // are a JSArray or an arguments object with a small smi length.
+  Label prepare, prepared, arguments_object, check_length;
+  __ ldr(r1, MemOperand(fp, kFunctionOffset));
+  __ tst(r1, Operand(kSmiTagMask));
+  __ b(eq, &prepare);
+  __ CompareObjectType(r1, r2, r2, JS_FUNCTION_TYPE);
+  __ b(ne, &prepare);
+  __ ldr(r1, MemOperand(fp, kArgsOffset));
+  __ tst(r1, Operand(kSmiTagMask));
+  __ b(eq, &prepare);
+  __ CompareObjectType(r1, r2, r3, JS_ARRAY_TYPE);
+  __ b(ne, &arguments_object);
+  __ ldr(r0, FieldMemOperand(r1, JSArray::kLengthOffset));
+  __ b(&check_length);
+  __ bind(&arguments_object);
+  GenerateLoadArgumentsBoilerplateMap(masm, r3);
+  __ cmp(r2, r3);
+  __ b(ne, &prepare);
+  __ ldr(r0, FieldMemOperand(r1, JSObject::kHeaderSize +
+                                 Heap::arguments_length_index * kPointerSize));
+  __ bind(&check_length);
+  __ tst(r0, Operand(kSmiTagMask | 0x80000000));
+  __ b(ne, &prepare);
+  __ cmp(r0, Operand(Smi::FromInt(kMaxFastApplyLength)));
+  __ b(lt, &prepared);
+
+  __ bind(&prepare);
   __ ldr(r0, MemOperand(fp, kFunctionOffset));  // get the function
   __ push(r0);
   __ ldr(r0, MemOperand(fp, kArgsOffset));  // get the args array
   __ push(r0);
   __ InvokeBuiltin(Builtins::APPLY_PREPARE, CALL_JS);
+  __ bind(&prepared);
 
   // Check the stack for overflow. We are not trying need to catch
   // interruptions (e.g. debug break and preemption) here, so the "real stack
@@ -1326,8 +1372,55 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   __ bind(&push_receiver);
   __ push(r0);
 
+  // Copy the elements of a JSArray or an arguments object with a fast
+  // backing store straight onto the stack.  The checks are done here,
+  // after any calls that could have changed the arguments.
+  Label generic, fast_elements, copy, fast_loop, fast_entry, hole, invoke;
+  __ ldr(r1, MemOperand(fp, kArgsOffset));
+  __ tst(r1, Operand(kSmiTagMask));
+  __ b(eq, &generic);
+  __ CompareObjectType(r1, r2, r3, JS_ARRAY_TYPE);
+  __ b(eq, &fast_elements);
+  GenerateLoadArgumentsBoilerplateMap(masm, r3);
+  __ cmp(r2, r3);
+  __ b(ne, &generic);
+  __ bind(&fast_elements);
+  __ ldr(r2, FieldMemOperand(r1, JSObject::kElementsOffset));
+  __ ldr(r3, FieldMemOperand(r2, HeapObject::kMapOffset));
+  __ LoadRoot(ip, Heap::kFixedArrayMapRootIndex);
+  __ cmp(r3, ip);
+  __ b(eq, &copy);
+  __ LoadRoot(ip, Heap::kFixedCOWArrayMapRootIndex);
+  __ cmp(r3, ip);
+  __ b(ne, &generic);
+  __ bind(&copy);
+  __ ldr(r0, MemOperand(fp, kLimitOffset));
+  __ ldr(r3, FieldMemOperand(r2, FixedArray::kLengthOffset));
+  __ cmp(r0, r3);
+  __ b(hi, &generic);
+  // r1: address of the current element, r3: end of the elements.
+  __ add(r1, r2, Operand(FixedArray::kHeaderSize - kHeapObjectTag));
+  __ add(r3, r1, Operand(r0, LSL, kPointerSizeLog2 - kSmiTagSize));
+  __ LoadRoot(r4, Heap::kTheHoleValueRootIndex);
+  __ b(&fast_entry);
+  __ bind(&fast_loop);
+  __ ldr(r2, MemOperand(r1, kPointerSize, PostIndex));
+  __ cmp(r2, r4);
+  __ b(eq, &hole);
+  __ push(r2);
+  __ bind(&fast_entry);
+  __ cmp(r1, r3);
+  __ b(lo, &fast_loop);
+  __ b(&invoke);
+
+  // Holes are looked up in the prototype chain.  Drop the elements
+  // copied so far, keeping the receiver, and use keyed loads instead.
+  __ bind(&hole);
+  __ add(sp, fp, Operand(kIndexOffset - kPointerSize));
+
   // Copy all arguments from the array to the stack.
   Label entry, loop;
+  __ bind(&generic);
   __ ldr(r0, MemOperand(fp, kIndexOffset));
   __ b(&entry);
 
@@ -1356,6 +1449,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   __ b(ne, &loop);
 
   // Invoke the function.
+  __ bind(&invoke);
   ParameterCount actual(r0);
   __ mov(r0, Operand(r0, ASR, kSmiTagSize));
   __ ldr(r1, MemOperand(fp, kFunctionOffset));
@@ -235,6 +235,61 @@ void FastCloneShallowArrayStub::Generate(MacroAssembler* masm) {
 }
 
 
+void FastCloneShallowObjectStub::Generate(MacroAssembler* masm) {
+  // Stack layout on entry:
+  //
+  // [sp]: fast elements flag.
+  // [sp + kPointerSize]: constant properties.
+  // [sp + (2 * kPointerSize)]: literal index.
+  // [sp + (3 * kPointerSize)]: literals array.
+
+  // All properties are expected to be in-object.
+  int size = JSObject::kHeaderSize + length_ * kPointerSize;
+
+  // Load boilerplate object into r3 and check if we need to create a
+  // boilerplate.
+  Label slow_case;
+  __ ldr(r3, MemOperand(sp, 3 * kPointerSize));
+  __ ldr(r0, MemOperand(sp, 2 * kPointerSize));
+  __ add(r3, r3, Operand(FixedArray::kHeaderSize - kHeapObjectTag));
+  __ ldr(r3, MemOperand(r3, r0, LSL, kPointerSizeLog2 - kSmiTagSize));
+  __ LoadRoot(ip, Heap::kUndefinedValueRootIndex);
+  __ cmp(r3, ip);
+  __ b(eq, &slow_case);
+
+  // Check that the boilerplate has the expected size and that it has
+  // neither out-of-object properties nor elements to copy.
+  __ ldr(r0, FieldMemOperand(r3, HeapObject::kMapOffset));
+  __ ldrb(r0, FieldMemOperand(r0, Map::kInstanceSizeOffset));
+  __ cmp(r0, Operand(size >> kPointerSizeLog2));
+  __ b(ne, &slow_case);
+  __ LoadRoot(ip, Heap::kEmptyFixedArrayRootIndex);
+  __ ldr(r0, FieldMemOperand(r3, JSObject::kPropertiesOffset));
+  __ cmp(r0, ip);
+  __ b(ne, &slow_case);
+  __ ldr(r0, FieldMemOperand(r3, JSObject::kElementsOffset));
+  __ cmp(r0, ip);
+  __ b(ne, &slow_case);
+
+  // Allocate the JS object and copy the boilerplate.  The copy is in new
+  // space, so no write barrier is needed.
+  __ AllocateInNewSpace(size,
+                        r0,
+                        r1,
+                        r2,
+                        &slow_case,
+                        TAG_OBJECT);
+  __ CopyFields(r0, r3, r1.bit(), size / kPointerSize);
+
+  // Return and remove the on-stack parameters.
+  __ add(sp, sp, Operand(4 * kPointerSize));
+  __ Ret();
+
+  __ bind(&slow_case);
+  __ TailCallRuntime(Runtime::kCreateObjectLiteralShallow, 4, 1);
+}
+
+
 // Takes a Smi and converts to an IEEE 64 bit floating point value in two
 // registers.  The format is 1 sign bit, 11 exponent bits (biased 1023) and
 // 52 fraction bits (20 in the first word, 32 in the second).  Zeros is a
@@ -3576,6 +3631,7 @@ int CompareStub::MinorKey() {
 
 void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   Label flat_string;
+  Label cons_string;
   Label ascii_string;
   Label got_char_code;
 
@@ -3607,14 +3663,33 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   __ b(eq, &flat_string);
 
   // Handle non-flat strings.
-  __ tst(result_, Operand(kIsConsStringMask));
-  __ b(eq, &call_runtime_);
+  __ and_(result_, result_, Operand(kStringRepresentationMask));
+  __ cmp(result_, Operand(kConsStringTag));
+  __ b(eq, &cons_string);
+  __ cmp(result_, Operand(kSlicedStringTag));
+  __ b(ne, &call_runtime_);
+
+  // SlicedString.
+  // Read the character from the parent if it is sequential.  The runtime
+  // system is called with the slice itself otherwise.
+  __ ldr(result_, FieldMemOperand(object_, SlicedString::kParentOffset));
+  __ ldr(result_, FieldMemOperand(result_, HeapObject::kMapOffset));
+  __ ldrb(result_, FieldMemOperand(result_, Map::kInstanceTypeOffset));
+  STATIC_ASSERT(kSeqStringTag == 0);
+  __ tst(result_, Operand(kStringRepresentationMask));
+  __ b(nz, &call_runtime_);
+  // Both the index and the offset are smis.
+  __ ldr(ip, FieldMemOperand(object_, SlicedString::kOffsetOffset));
+  __ add(scratch_, scratch_, Operand(ip));
+  __ ldr(object_, FieldMemOperand(object_, SlicedString::kParentOffset));
+  __ jmp(&flat_string);
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
   // this is really a flat string in a cons string). If that is not
   // the case we would rather go to the runtime system now to flatten
   // the string.
+  __ bind(&cons_string);
   __ ldr(result_, FieldMemOperand(object_, ConsString::kSecondOffset));
   __ LoadRoot(ip, Heap::kEmptyStringRootIndex);
   __ cmp(result_, Operand(ip));
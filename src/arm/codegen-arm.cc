@@ -3596,10 +3596,16 @@ void CodeGenerator::VisitObjectLiteral(ObjectLiteral* node) {
   frame_->EmitPush(Operand(node->constant_properties()));
   // Should the object literal have fast elements?
   frame_->EmitPush(Operand(Smi::FromInt(node->fast_elements() ? 1 : 0)));
+  int properties_count = node->constant_properties()->length() / 2;
   if (node->depth() > 1) {
     frame_->CallRuntime(Runtime::kCreateObjectLiteral, 4);
-  } else {
+  } else if (!node->fast_elements() ||
+             properties_count >
+                 FastCloneShallowObjectStub::kMaximumClonedProperties) {
     frame_->CallRuntime(Runtime::kCreateObjectLiteralShallow, 4);
+  } else {
+    FastCloneShallowObjectStub stub(properties_count);
+    frame_->CallStub(&stub, 4);
   }
   frame_->EmitPush(r0);  // save the result
 
@@ -4098,7 +4104,18 @@ void CodeGenerator::VisitProperty(Property* node) {
 #endif
   Comment cmnt(masm_, "[ Property");
 
-  { Reference property(this, node);
+  if (node->IsArgumentsReadFromFrame()) {
+    // Read the actual arguments from the frame instead of loading from
+    // an arguments object, which this function never allocates.
+    ZoneList<Expression*>* args = new ZoneList<Expression*>(1);
+    if (node->IsArgumentsLengthReadFromFrame()) {
+      GenerateArgumentsLength(args);
+    } else {
+      args->Add(node->key());
+      GenerateArguments(args);
+    }
+  } else {
+    Reference property(this, node);
     property.GetValue();
   }
   ASSERT_EQ(original_height + 1, frame_->height());
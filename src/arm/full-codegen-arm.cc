@@ -1167,10 +1167,16 @@ void FullCodeGenerator::VisitObjectLiteral(ObjectLiteral* expr) {
   __ mov(r1, Operand(expr->constant_properties()));
   __ mov(r0, Operand(Smi::FromInt(expr->fast_elements() ? 1 : 0)));
   __ Push(r3, r2, r1, r0);
+  int properties_count = expr->constant_properties()->length() / 2;
   if (expr->depth() > 1) {
     __ CallRuntime(Runtime::kCreateObjectLiteral, 4);
-  } else {
+  } else if (!expr->fast_elements() ||
+             properties_count >
+                 FastCloneShallowObjectStub::kMaximumClonedProperties) {
     __ CallRuntime(Runtime::kCreateObjectLiteralShallow, 4);
+  } else {
+    FastCloneShallowObjectStub stub(properties_count);
+    __ CallStub(&stub);
   }
 
   // If result_saved is true the result is on top of the stack.  If
@@ -1686,6 +1692,19 @@ void FullCodeGenerator::VisitProperty(Property* expr) {
   Comment cmnt(masm_, "[ Property");
   Expression* key = expr->key();
 
+  if (expr->IsArgumentsReadFromFrame()) {
+    // Read the actual arguments from the frame instead of loading from
+    // an arguments object, which this function never allocates.
+    ZoneList<Expression*>* args = new ZoneList<Expression*>(1);
+    if (expr->IsArgumentsLengthReadFromFrame()) {
+      EmitArgumentsLength(args);
+    } else {
+      args->Add(key);
+      EmitArguments(args);
+    }
+    return;
+  }
+
   if (key->IsPropertyName()) {
     VisitForAccumulatorValue(expr->obj());
     EmitNamedPropertyLoad(expr);
@@ -126,8 +126,8 @@ static void GenerateStringDictionaryProbes(MacroAssembler* masm,
       StringDictionary::kElementsStartIndex * kPointerSize;
 
   // Generate an unrolled loop that performs a few probes before
-  // giving up. Measurements done on Gmail indicate that 2 probes
-  // cover ~93% of loads from dictionaries.
+  // falling back to a probing loop. Measurements done on Gmail indicate
+  // that 2 probes cover ~93% of loads from dictionaries.
   static const int kProbes = 4;
   for (int i = 0; i < kProbes; i++) {
     // Compute the masked index: (hash + i + i * i) & mask.
@@ -152,12 +152,42 @@ static void GenerateStringDictionaryProbes(MacroAssembler* masm,
     __ add(scratch2, elements, Operand(scratch2, LSL, 2));
     __ ldr(ip, FieldMemOperand(scratch2, kElementsStartOffset));
     __ cmp(name, Operand(ip));
-    if (i != kProbes - 1) {
-      __ b(eq, done);
-    } else {
-      __ b(ne, miss);
-    }
+    __ b(eq, done);
+    // An undefined key ends the probe sequence.
+    __ LoadRoot(scratch2, Heap::kUndefinedValueRootIndex);
+    __ cmp(ip, scratch2);
+    __ b(eq, miss);
   }
+
+  // Keep probing until the name or an undefined key is found, as the
+  // lookup in the runtime does.  The probe number is kept on the stack.
+  Label loop, found;
+  __ mov(ip, Operand(kProbes));
+  __ push(ip);
+  __ bind(&loop);
+  // scratch2 = (i + i * i) / 2.
+  __ ldr(ip, MemOperand(sp, 0));
+  __ mul(scratch2, ip, ip);
+  __ add(scratch2, scratch2, Operand(ip));
+  __ mov(scratch2, Operand(scratch2, LSR, 1));
+  __ add(ip, ip, Operand(1));
+  __ str(ip, MemOperand(sp, 0));
+  __ ldr(ip, FieldMemOperand(name, String::kHashFieldOffset));
+  __ add(scratch2, scratch2, Operand(ip, LSR, String::kHashShift));
+  __ and_(scratch2, scratch2, Operand(scratch1));
+  __ add(scratch2, scratch2, Operand(scratch2, LSL, 1));
+  __ add(scratch2, elements, Operand(scratch2, LSL, 2));
+  __ ldr(ip, FieldMemOperand(scratch2, kElementsStartOffset));
+  __ cmp(name, Operand(ip));
+  __ b(eq, &found);
+  __ LoadRoot(scratch2, Heap::kUndefinedValueRootIndex);
+  __ cmp(ip, scratch2);
+  __ b(ne, &loop);
+  __ add(sp, sp, Operand(kPointerSize));
+  __ b(miss);
+  __ bind(&found);
+  __ add(sp, sp, Operand(kPointerSize));
+  __ b(done);
 }
 
 
@@ -1054,11 +1054,12 @@ int RegExpMacroAssemblerARM::CheckStackGuardState(Address* return_address,
   }
 
   // Otherwise, the content of the string might have moved. It must still
-  // be a sequential or external string with the same content.
+  // be a sequential, external or sliced string with the same content.
   // Update the start and end pointers in the stack frame to the current
   // location (whether it has actually moved or not).
   ASSERT(StringShape(*subject).IsSequential() ||
-      StringShape(*subject).IsExternal());
+      StringShape(*subject).IsExternal() ||
+      StringShape(*subject).IsSliced());
 
   // The original start address of the characters to match.
   const byte* start_address = frame_entry<const byte*>(re_frame, kInputStart);
@@ -49,6 +49,9 @@ static void ProbeTable(Isolate* isolate,
                        Register scratch2) {
   ExternalReference key_offset(isolate->stub_cache()->key_reference(table));
   ExternalReference value_offset(isolate->stub_cache()->value_reference(table));
+  StatsCounter* hit_counter = table == StubCache::kPrimary
+      ? COUNTERS->megamorphic_stub_cache_primary_hits()
+      : COUNTERS->megamorphic_stub_cache_secondary_hits();
 
   uint32_t key_off_addr = reinterpret_cast<uint32_t>(key_offset.address());
   uint32_t value_off_addr = reinterpret_cast<uint32_t>(value_offset.address());
@@ -81,6 +84,8 @@ static void ProbeTable(Isolate* isolate,
   // Re-load code entry from cache.
   __ ldr(offset, MemOperand(offsets_base_addr, offset, LSL, 1));
 
+  __ IncrementCounter(hit_counter, 1, scratch, scratch2);
+
   // Jump to the first instruction in the code stub.
   __ add(offset, offset, Operand(Code::kHeaderSize - kHeapObjectTag));
   __ Jump(offset);
@@ -236,18 +241,25 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   ASSERT(!extra.is(no_reg));
   ASSERT(!extra2.is(no_reg));
 
+  __ IncrementCounter(COUNTERS->megamorphic_stub_cache_probes(), 1,
+                      extra, extra2);
+
   // Check that the receiver isn't a smi.
   __ tst(receiver, Operand(kSmiTagMask));
   __ b(eq, &miss);
 
+  StubCache* stub_cache = isolate->stub_cache();
+  ExternalReference primary_mask(stub_cache->mask_reference(kPrimary));
+  ExternalReference secondary_mask(stub_cache->mask_reference(kSecondary));
+
   // Get the map of the receiver and compute the hash.
   __ ldr(scratch, FieldMemOperand(name, String::kHashFieldOffset));
   __ ldr(ip, FieldMemOperand(receiver, HeapObject::kMapOffset));
   __ add(scratch, scratch, Operand(ip));
   __ eor(scratch, scratch, Operand(flags));
-  __ and_(scratch,
-          scratch,
-          Operand((kPrimaryTableSize - 1) << kHeapObjectTagSize));
+  __ mov(extra, Operand(primary_mask));
+  __ ldr(extra, MemOperand(extra));
+  __ and_(scratch, scratch, Operand(extra));
 
   // Probe the primary table.
   ProbeTable(isolate, masm, flags, kPrimary, name, scratch, extra, extra2);
@@ -255,9 +267,9 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Primary miss: Compute hash for secondary probe.
   __ sub(scratch, scratch, Operand(name));
   __ add(scratch, scratch, Operand(flags));
-  __ and_(scratch,
-          scratch,
-          Operand((kSecondaryTableSize - 1) << kHeapObjectTagSize));
+  __ mov(extra, Operand(secondary_mask));
+  __ ldr(extra, MemOperand(extra));
+  __ and_(scratch, scratch, Operand(extra));
 
   // Probe the secondary table.
   ProbeTable(isolate, masm, flags, kSecondary, name, scratch, extra, extra2);
@@ -265,6 +277,8 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(COUNTERS->megamorphic_stub_cache_misses(), 1,
+                      extra, extra2);
 }
 
 
@@ -1063,6 +1077,51 @@ void StubCompiler::GenerateLoadConstant(JSObject* object,
 }
 
 
+void StubCompiler::GenerateLoadInternalField(JSObject* holder,
+                                             Register holder_reg,
+                                             Register scratch1,
+                                             Register scratch2,
+                                             Register scratch3,
+                                             AccessorInfo* callback,
+                                             Label* miss) {
+  // The receiver and name registers are still needed on a miss, so the
+  // result is only moved to r0 at the end.
+  int index = callback->internal_field_index();
+  __ ldr(scratch2,
+         FieldMemOperand(holder_reg,
+                         holder->GetHeaderSize() + index * kPointerSize));
+  v8::InternalFieldAccessorType type = callback->internal_field_type();
+  if (type == v8::INTERNAL_FIELD_VALUE) {
+    __ mov(r0, scratch2);
+    __ Ret();
+    return;
+  }
+
+  // Get the pointer stored in the field.  Aligned pointers are stored as
+  // smis, others in a proxy.  Leave NULL and fields holding anything else
+  // to the getter.
+  Label not_smi, pointer_loaded;
+  __ tst(scratch2, Operand(kSmiTagMask));
+  __ b(ne, &not_smi);
+  __ cmp(scratch2, Operand(0));
+  __ b(eq, miss);
+  __ b(&pointer_loaded);
+  __ bind(&not_smi);
+  __ CompareObjectType(scratch2, scratch3, scratch3, PROXY_TYPE);
+  __ b(ne, miss);
+  __ ldr(scratch2, FieldMemOperand(scratch2, Proxy::kProxyOffset));
+  __ bind(&pointer_loaded);
+
+  ASSERT(type == v8::INTERNAL_FIELD_INT32);
+  __ ldr(scratch2, MemOperand(scratch2, callback->internal_field_offset()));
+  // Tag the value as a smi, values outside the smi range go to the getter.
+  __ add(scratch3, scratch2, Operand(scratch2), SetCC);
+  __ b(vs, miss);
+  __ mov(r0, scratch3);
+  __ Ret();
+}
+
+
 bool StubCompiler::GenerateLoadCallback(JSObject* object,
                                         JSObject* holder,
                                         Register receiver,
@@ -1083,6 +1142,16 @@ bool StubCompiler::GenerateLoadCallback(JSObject* object,
       CheckPrototypes(object, receiver, holder, scratch1, scratch2, scratch3,
                       name, miss);
 
+  // Doubles are left to the runtime, there are not enough registers here
+  // to allocate the heap number.
+  if (callback->is_internal_field_accessor() &&
+      callback->internal_field_index() < holder->GetInternalFieldCount() &&
+      callback->internal_field_type() != v8::INTERNAL_FIELD_DOUBLE) {
+    GenerateLoadInternalField(holder, reg, scratch1, scratch2, scratch3,
+                              callback, miss);
+    return true;
+  }
+
   // Push the arguments on the JS stack of the caller.
   __ push(receiver);  // Receiver.
   __ mov(scratch3, Operand(Handle<AccessorInfo>(callback)));  // callback data
@@ -73,19 +73,18 @@ function SparseJoin(array, len, convert) {
   var last_key = -1;
   var keys_length = keys.length;
 
-  var elements = new $Array(keys_length);
-  var elements_length = 0;
+  var builder = new StringBuilder(0);
 
   for (var i = 0; i < keys_length; i++) {
     var key = keys[i];
     if (key != last_key) {
       var e = array[key];
       if (!IS_STRING(e)) e = convert(e);
-      elements[elements_length++] = e;
+      builder.add(e);
       last_key = key;
     }
   }
-  return %StringBuilderConcat(elements, elements_length, '');
+  return builder.generate();
 }
 
 
@@ -123,35 +122,29 @@ function Join(array, length, separator, convert) {
       }
     }
 
-    // Construct an array for the elements.
-    var elements;
-    var elements_length = 0;
+    // Collect the elements in a string builder.
+    var builder = new StringBuilder(0);
 
     // We pull the empty separator check outside the loop for speed!
     if (separator.length == 0) {
-      elements = new $Array(length);
       for (var i = 0; i < length; i++) {
         var e = array[i];
         if (!IS_UNDEFINED(e) || (i in array)) {
           if (!IS_STRING(e)) e = convert(e);
-          elements[elements_length++] = e;
+          builder.add(e);
         }
       }
     } else {
-      elements = new $Array(length << 1);
       for (var i = 0; i < length; i++) {
         var e = array[i];
-        if (i != 0) elements[elements_length++] = separator;
+        if (i != 0) builder.add(separator);
         if (!IS_UNDEFINED(e) || (i in array)) {
           if (!IS_STRING(e)) e = convert(e);
-          elements[elements_length++] = e;
+          builder.add(e);
         }
       }
     }
-    elements.length = elements_length;
-    var result = %_FastAsciiArrayJoin(elements, "");
-    if (!IS_UNDEFINED(result)) return result;
-    return %StringBuilderConcat(elements, elements_length, '');
+    return builder.generate();
   } finally {
     // Make sure to pop the visited array no matter what happens.
     if (is_array) visited_arrays.pop();
@@ -645,6 +638,8 @@ function ArraySort(comparefn) {
   // For short (length <= 22) arrays, insertion sort is used for efficiency.
 
   if (!IS_FUNCTION(comparefn)) {
+    // Arrays of numbers and strings without holes are sorted natively.
+    if (IS_ARRAY(this) && %SortArrayDefault(this)) return this;
     comparefn = function (x, y) {
       if (x === y) return 0;
       if (%_IsSmi(x) && %_IsSmi(y)) {
@@ -1152,7 +1147,7 @@ function SetupArray() {
   InstallFunctionsOnHiddenPrototype($Array.prototype, DONT_ENUM, $Array(
     "toString", getFunction("toString", ArrayToString),
     "toLocaleString", getFunction("toLocaleString", ArrayToLocaleString),
-    "join", getFunction("join", ArrayJoin),
+    "join", getFunction("join", ArrayJoin, 1),
     "pop", getFunction("pop", ArrayPop),
     "push", getFunction("push", ArrayPush, 1),
     "concat", getFunction("concat", ArrayConcat, 1),
@@ -117,6 +117,22 @@ void VariableProxy::BindTo(Variable* var) {
 }
 
 
+bool Property::IsArgumentsReadFromFrame() {
+  VariableProxy* proxy = obj_->AsVariableProxy();
+  return proxy != NULL &&
+      proxy->IsArguments() &&
+      proxy->var()->scope()->arguments_read_from_frame();
+}
+
+
+bool Property::IsArgumentsLengthReadFromFrame() {
+  Literal* literal = key_->AsLiteral();
+  return IsArgumentsReadFromFrame() &&
+      literal != NULL &&
+      literal->handle().is_identical_to(FACTORY->length_symbol());
+}
+
+
 Token::Value Assignment::binary_op() const {
   switch (op_) {
     case Token::ASSIGN_BIT_OR: return Token::BIT_OR;
@@ -1078,6 +1078,12 @@ class Property: public Expression {
   int position() const { return pos_; }
   bool is_synthetic() const { return type_ == SYNTHETIC; }
 
+  // Is this a load from 'arguments' in a function that reads the actual
+  // arguments from the stack frame; see Scope::arguments_read_from_frame.
+  bool IsArgumentsReadFromFrame();
+  // Is this such a load of 'arguments.length'.
+  bool IsArgumentsLengthReadFromFrame();
+
  private:
   Expression* obj_;
   Expression* key_;
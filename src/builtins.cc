@@ -314,6 +314,21 @@ static void MoveElements(Heap* heap,
 }
 
 
+static void CopyDoubleElements(FixedDoubleArray* dst,
+                               int dst_index,
+                               FixedDoubleArray* src,
+                               int src_index,
+                               int len) {
+  ASSERT(dst != src);
+  ASSERT(len > 0);
+  memcpy(reinterpret_cast<void*>(
+             dst->address() + FixedDoubleArray::OffsetOfElementAt(dst_index)),
+         reinterpret_cast<void*>(
+             src->address() + FixedDoubleArray::OffsetOfElementAt(src_index)),
+         len * kDoubleSize);
+}
+
+
 static void FillWithHoles(Heap* heap, FixedArray* dst, int from, int to) {
   ASSERT(dst->map() != heap->fixed_cow_array_map());
   MemsetPointer(dst->data_start() + from, heap->the_hole_value(), to - from);
@@ -431,9 +446,47 @@ MUST_USE_RESULT static MaybeObject* CallJsBuiltin(
 }
 
 
+// Appends the arguments to an array with unboxed double elements.  Returns
+// NULL if one of them is not a number.
+MUST_USE_RESULT static MaybeObject* PushDoubleElements(
+    JSArray* array,
+    BuiltinArguments<NO_EXTRA_ARGUMENTS>* args) {
+  ASSERT(array->HasFastDoubleElements());
+  int to_add = args->length() - 1;
+  for (int index = 0; index < to_add; index++) {
+    if (!(*args)[index + 1]->IsNumber()) return NULL;
+  }
+
+  int len = Smi::cast(array->length())->value();
+  int new_length = len + to_add;
+  if (new_length > FixedDoubleArray::cast(array->elements())->length()) {
+    int capacity = new_length + (new_length >> 1) + 16;
+    Object* obj;
+    { MaybeObject* maybe_obj =
+          array->SetFastDoubleElementsCapacityAndLength(capacity, len);
+      if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+    }
+  }
+
+  FixedDoubleArray* elms = FixedDoubleArray::cast(array->elements());
+  for (int index = 0; index < to_add; index++) {
+    elms->set(index + len, (*args)[index + 1]->Number());
+  }
+  array->set_length(Smi::FromInt(new_length));
+  return Smi::FromInt(new_length);
+}
+
+
 BUILTIN(ArrayPush) {
   Heap* heap = isolate->heap();
   Object* receiver = *args.receiver();
+  if (receiver->IsJSArray() &&
+      JSArray::cast(receiver)->HasFastDoubleElements()) {
+    MaybeObject* result =
+        PushDoubleElements(JSArray::cast(receiver), &args);
+    if (result == NULL) return CallJsBuiltin(isolate, "ArrayPush", args);
+    return result;
+  }
   Object* elms_obj;
   { MaybeObject* maybe_elms_obj =
         EnsureJSArrayWithWritableFastElements(heap, receiver);
@@ -459,6 +512,28 @@ BUILTIN(ArrayPush) {
   if (new_length > elms->length()) {
     // New backing storage is needed.
     int capacity = new_length + (new_length >> 1) + 16;
+
+    // Growing an array of numbers with a double unboxes its elements, as
+    // in JSObject::SetFastElement.
+    if (FLAG_unbox_double_arrays) {
+      bool all_numbers = true;
+      bool has_double = false;
+      for (int index = 0; index < to_add; index++) {
+        Object* value = args[index + 1];
+        if (!value->IsNumber()) all_numbers = false;
+        if (value->IsHeapNumber()) has_double = true;
+      }
+      if (all_numbers && has_double &&
+          array->ShouldConvertToFastDoubleElements()) {
+        Object* obj;
+        { MaybeObject* maybe_obj =
+              array->SetFastDoubleElementsCapacityAndLength(capacity, len);
+          if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+        }
+        return PushDoubleElements(array, &args);
+      }
+    }
+
     Object* obj;
     { MaybeObject* maybe_obj = heap->AllocateUninitializedFixedArray(capacity);
       if (!maybe_obj->ToObject(&obj)) return maybe_obj;
@@ -630,13 +705,15 @@ BUILTIN(ArraySlice) {
         EnsureJSArrayWithWritableFastElements(heap, receiver);
     if (!maybe_elms_obj->ToObject(&elms_obj)) return maybe_elms_obj;
   }
-  if (elms_obj == NULL ||
+  bool double_elements = elms_obj == NULL &&
+      receiver->IsJSArray() &&
+      JSArray::cast(receiver)->HasFastDoubleElements();
+  if ((elms_obj == NULL && !double_elements) ||
       !IsJSArrayFastElementMovingAllowed(heap, JSArray::cast(receiver))) {
     return CallJsBuiltin(isolate, "ArraySlice", args);
   }
-  FixedArray* elms = FixedArray::cast(elms_obj);
   JSArray* array = JSArray::cast(receiver);
-  ASSERT(array->HasFastElements());
+  ASSERT(array->HasFastElements() || array->HasFastDoubleElements());
 
   int len = Smi::cast(array->length())->value();
 
@@ -684,6 +761,24 @@ BUILTIN(ArraySlice) {
   }
   JSArray* result_array = JSArray::cast(result);
 
+  if (double_elements) {
+    { MaybeObject* maybe_result =
+          heap->AllocateUninitializedFixedDoubleArray(result_len);
+      if (!maybe_result->ToObject(&result)) return maybe_result;
+    }
+    FixedDoubleArray* result_elms = FixedDoubleArray::cast(result);
+    { MaybeObject* maybe_result = result_array->map()->GetSlowElementsMap();
+      if (!maybe_result->ToObject(&result)) return maybe_result;
+    }
+    CopyDoubleElements(result_elms, 0,
+                       FixedDoubleArray::cast(array->elements()), k,
+                       result_len);
+    result_array->set_map(Map::cast(result));
+    result_array->set_elements(result_elms);
+    result_array->set_length(Smi::FromInt(result_len));
+    return result_array;
+  }
+
   { MaybeObject* maybe_result =
         heap->AllocateUninitializedFixedArray(result_len);
     if (!maybe_result->ToObject(&result)) return maybe_result;
@@ -691,6 +786,7 @@ BUILTIN(ArraySlice) {
   FixedArray* result_elms = FixedArray::cast(result);
 
   AssertNoAllocation no_gc;
+  FixedArray* elms = FixedArray::cast(elms_obj);
   CopyElements(heap, &no_gc, result_elms, 0, elms, k, result_len);
 
   // Set elements.
@@ -880,16 +976,29 @@ BUILTIN(ArrayConcat) {
 
   // Iterate through all the arguments performing checks
   // and calculating total length.
+  // The result has unboxed double elements if all non-empty arguments do.
   int n_arguments = args.length();
   int result_len = 0;
+  bool has_fast_elements = false;
+  bool has_double_elements = false;
   for (int i = 0; i < n_arguments; i++) {
     Object* arg = args[i];
-    if (!arg->IsJSArray() || !JSArray::cast(arg)->HasFastElements()
-        || JSArray::cast(arg)->GetPrototype() != array_proto) {
+    if (!arg->IsJSArray() ||
+        JSArray::cast(arg)->GetPrototype() != array_proto) {
       return CallJsBuiltin(isolate, "ArrayConcat", args);
     }
 
     int len = Smi::cast(JSArray::cast(arg)->length())->value();
+    if (JSArray::cast(arg)->HasFastDoubleElements()) {
+      has_double_elements = true;
+    } else if (!JSArray::cast(arg)->HasFastElements()) {
+      return CallJsBuiltin(isolate, "ArrayConcat", args);
+    } else if (len > 0) {
+      has_fast_elements = true;
+    }
+    if (has_fast_elements && has_double_elements) {
+      return CallJsBuiltin(isolate, "ArrayConcat", args);
+    }
 
     // We shouldn't overflow when adding another len.
     const int kHalfOfMaxInt = 1 << (kBitsPerInt - 2);
@@ -902,6 +1011,9 @@ BUILTIN(ArrayConcat) {
       return CallJsBuiltin(isolate, "ArrayConcat", args);
     }
   }
+  if (has_double_elements && result_len > FixedDoubleArray::kMaxLength) {
+    return CallJsBuiltin(isolate, "ArrayConcat", args);
+  }
 
   if (result_len == 0) {
     return AllocateEmptyJSArray(heap);
@@ -914,6 +1026,33 @@ BUILTIN(ArrayConcat) {
   }
   JSArray* result_array = JSArray::cast(result);
 
+  if (has_double_elements) {
+    { MaybeObject* maybe_result =
+          heap->AllocateUninitializedFixedDoubleArray(result_len);
+      if (!maybe_result->ToObject(&result)) return maybe_result;
+    }
+    FixedDoubleArray* result_elms = FixedDoubleArray::cast(result);
+    { MaybeObject* maybe_result = result_array->map()->GetSlowElementsMap();
+      if (!maybe_result->ToObject(&result)) return maybe_result;
+    }
+    int start_pos = 0;
+    for (int i = 0; i < n_arguments; i++) {
+      JSArray* array = JSArray::cast(args[i]);
+      int len = Smi::cast(array->length())->value();
+      if (len > 0) {
+        CopyDoubleElements(result_elms, start_pos,
+                           FixedDoubleArray::cast(array->elements()), 0, len);
+        start_pos += len;
+      }
+    }
+    ASSERT(start_pos == result_len);
+
+    result_array->set_map(Map::cast(result));
+    result_array->set_length(Smi::FromInt(result_len));
+    result_array->set_elements(result_elms);
+    return result_array;
+  }
+
   { MaybeObject* maybe_result =
         heap->AllocateUninitializedFixedArray(result_len);
     if (!maybe_result->ToObject(&result)) return maybe_result;
@@ -942,6 +1081,294 @@ BUILTIN(ArrayConcat) {
 }
 
 
+// Returns the elements of a JSArray with fast elements, including
+// copy-on-write ones, or NULL.  The elements are only read, so they are
+// not copied.
+static inline FixedArray* GetFastElementsForReading(Heap* heap,
+                                                    Object* receiver) {
+  if (!receiver->IsJSArray()) return NULL;
+  HeapObject* elms = HeapObject::cast(JSArray::cast(receiver)->elements());
+  if (elms->map() == heap->fixed_array_map() ||
+      elms->map() == heap->fixed_cow_array_map()) {
+    return FixedArray::cast(elms);
+  }
+  return NULL;
+}
+
+
+// Searches elements from start towards end, which is excluded, for an
+// element strictly equal to search_element.  Returns its index or -1.
+// Holes never match as search_element is never the hole.
+static int SearchFastElements(FixedArray* elms,
+                              Object* search_element,
+                              int start,
+                              int end,
+                              int step) {
+  if (search_element->IsSmi()) {
+    double value = Smi::cast(search_element)->value();
+    for (int i = start; i != end; i += step) {
+      Object* element = elms->get(i);
+      if (element == search_element) return i;
+      if (element->IsHeapNumber() &&
+          HeapNumber::cast(element)->value() == value) {
+        return i;
+      }
+    }
+  } else if (search_element->IsHeapNumber()) {
+    double value = HeapNumber::cast(search_element)->value();
+    if (isnan(value)) return -1;
+    for (int i = start; i != end; i += step) {
+      Object* element = elms->get(i);
+      if (element->IsNumber() && element->Number() == value) return i;
+    }
+  } else if (search_element->IsString()) {
+    String* string = String::cast(search_element);
+    for (int i = start; i != end; i += step) {
+      Object* element = elms->get(i);
+      if (element == string) return i;
+      if (element->IsString() && string->Equals(String::cast(element))) {
+        return i;
+      }
+    }
+  } else {
+    // Everything else is compared by identity.
+    for (int i = start; i != end; i += step) {
+      if (elms->get(i) == search_element) return i;
+    }
+  }
+  return -1;
+}
+
+
+// As SearchFastElements, for unboxed double elements.
+static int SearchFastDoubleElements(FixedDoubleArray* elms,
+                                    Object* search_element,
+                                    int start,
+                                    int end,
+                                    int step) {
+  if (!search_element->IsNumber()) return -1;
+  double value = search_element->Number();
+  if (isnan(value)) return -1;
+  for (int i = start; i != end; i += step) {
+    if (!elms->is_the_hole(i) && elms->get_scalar(i) == value) return i;
+  }
+  return -1;
+}
+
+
+// Searches a JSArray with fast elements whose holes read as undefined
+// without side effects.  Returns NULL if the array or the arguments need
+// the generic version in array.js.
+static MaybeObject* SearchJSArray(Heap* heap,
+                                  Object* receiver,
+                                  Object* search_element,
+                                  int start,
+                                  int end,
+                                  int step) {
+  FixedArray* elms = GetFastElementsForReading(heap, receiver);
+  if (elms == NULL) {
+    if (!receiver->IsJSArray() ||
+        !JSArray::cast(receiver)->HasFastDoubleElements()) {
+      return NULL;
+    }
+  }
+  if (!IsJSArrayFastElementMovingAllowed(heap, JSArray::cast(receiver))) {
+    return NULL;
+  }
+  int index;
+  if (elms != NULL) {
+    index = SearchFastElements(elms, search_element, start, end, step);
+  } else {
+    index = SearchFastDoubleElements(
+        FixedDoubleArray::cast(JSArray::cast(receiver)->elements()),
+        search_element, start, end, step);
+  }
+  return Smi::FromInt(index);
+}
+
+
+BUILTIN(ArrayIndexOf) {
+  Heap* heap = isolate->heap();
+  Object* receiver = *args.receiver();
+  if (!receiver->IsJSArray() || !JSArray::cast(receiver)->length()->IsSmi()) {
+    return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+  }
+  int len = Smi::cast(JSArray::cast(receiver)->length())->value();
+
+  Object* search_element =
+      args.length() > 1 ? args[1] : heap->undefined_value();
+  // ECMA-262, 5th Edition, Section 15.4.4.14, steps 5 to 7.
+  int start = 0;
+  if (args.length() > 2) {
+    Object* arg = args[2];
+    if (arg->IsSmi()) {
+      start = Smi::cast(arg)->value();
+      if (start < 0) start = Max(len + start, 0);
+    } else if (!arg->IsUndefined()) {
+      return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+    }
+  }
+  if (start >= len) return Smi::FromInt(-1);
+
+  MaybeObject* result =
+      SearchJSArray(heap, receiver, search_element, start, len, 1);
+  if (result == NULL) return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+  return result;
+}
+
+
+BUILTIN(ArrayLastIndexOf) {
+  Heap* heap = isolate->heap();
+  Object* receiver = *args.receiver();
+  if (!receiver->IsJSArray() || !JSArray::cast(receiver)->length()->IsSmi()) {
+    return CallJsBuiltin(isolate, "ArrayLastIndexOf", args);
+  }
+  int len = Smi::cast(JSArray::cast(receiver)->length())->value();
+  if (len == 0) return Smi::FromInt(-1);
+
+  Object* search_element =
+      args.length() > 1 ? args[1] : heap->undefined_value();
+  // ECMA-262, 5th Edition, Section 15.4.4.15, steps 5 to 7.  An explicit
+  // undefined start index converts to 0.
+  int start = len - 1;
+  if (args.length() > 2) {
+    Object* arg = args[2];
+    if (arg->IsSmi()) {
+      start = Smi::cast(arg)->value();
+      if (start < 0) start += len;
+      if (start >= len) start = len - 1;
+    } else if (arg->IsUndefined()) {
+      start = 0;
+    } else {
+      return CallJsBuiltin(isolate, "ArrayLastIndexOf", args);
+    }
+  }
+  if (start < 0) return Smi::FromInt(-1);
+
+  MaybeObject* result =
+      SearchJSArray(heap, receiver, search_element, start, -1, -1);
+  if (result == NULL) return CallJsBuiltin(isolate, "ArrayLastIndexOf", args);
+  return result;
+}
+
+
+// Large enough for any smi converted by IntToCString, including the
+// terminating null character.
+static const int kSmiToCStringBufferSize = 16;
+
+
+// Writes the elements of a join, which must all be strings, smis,
+// undefined, null or holes, separated by separator.
+template <typename Char>
+static void WriteJoinedElements(FixedArray* elms,
+                                int len,
+                                String* separator,
+                                Char* dest) {
+  int separator_length = separator->length();
+  char buffer[kSmiToCStringBufferSize];
+  Vector<char> buffer_vector(buffer, kSmiToCStringBufferSize);
+  for (int i = 0; i < len; i++) {
+    if (i > 0 && separator_length > 0) {
+      String::WriteToFlat(separator, dest, 0, separator_length);
+      dest += separator_length;
+    }
+    Object* element = elms->get(i);
+    if (element->IsString()) {
+      String* string = String::cast(element);
+      String::WriteToFlat(string, dest, 0, string->length());
+      dest += string->length();
+    } else if (element->IsSmi()) {
+      const char* digits =
+          IntToCString(Smi::cast(element)->value(), buffer_vector);
+      while (*digits != '\0') *dest++ = *digits++;
+    }
+  }
+}
+
+
+BUILTIN(ArrayJoin) {
+  Heap* heap = isolate->heap();
+  Object* receiver = *args.receiver();
+  FixedArray* elms = GetFastElementsForReading(heap, receiver);
+  if (elms == NULL ||
+      !IsJSArrayFastElementMovingAllowed(heap, JSArray::cast(receiver))) {
+    return CallJsBuiltin(isolate, "ArrayJoin", args);
+  }
+
+  String* separator;
+  if (args.length() < 2 || args[1]->IsUndefined()) {
+    Object* comma;
+    { MaybeObject* maybe_comma = heap->LookupAsciiSymbol(",");
+      if (!maybe_comma->ToObject(&comma)) return maybe_comma;
+    }
+    separator = String::cast(comma);
+  } else if (args[1]->IsString()) {
+    separator = String::cast(args[1]);
+  } else {
+    return CallJsBuiltin(isolate, "ArrayJoin", args);
+  }
+
+  int len = Smi::cast(JSArray::cast(receiver)->length())->value();
+  if (len == 0) return heap->empty_string();
+
+  // Compute the length of the result.  Elements that are not strings or
+  // smis, other than undefined, null and holes which are joined as empty
+  // strings, need their toString method called by the generic version.
+  int separator_length = separator->length();
+  if (separator_length > 0 &&
+      len - 1 > String::kMaxLength / separator_length) {
+    return CallJsBuiltin(isolate, "ArrayJoin", args);
+  }
+  int result_length = (len - 1) * separator_length;
+  bool is_ascii = separator->HasOnlyAsciiChars();
+  char buffer[kSmiToCStringBufferSize];
+  Vector<char> buffer_vector(buffer, kSmiToCStringBufferSize);
+  for (int i = 0; i < len; i++) {
+    Object* element = elms->get(i);
+    int element_length;
+    if (element->IsString()) {
+      String* string = String::cast(element);
+      if (len == 1) return string;
+      element_length = string->length();
+      if (!string->HasOnlyAsciiChars()) is_ascii = false;
+    } else if (element->IsSmi()) {
+      element_length = StrLength(
+          IntToCString(Smi::cast(element)->value(), buffer_vector));
+    } else if (element->IsUndefined() ||
+               element->IsNull() ||
+               element->IsTheHole()) {
+      element_length = 0;
+    } else {
+      return CallJsBuiltin(isolate, "ArrayJoin", args);
+    }
+    if (element_length > String::kMaxLength - result_length) {
+      return CallJsBuiltin(isolate, "ArrayJoin", args);
+    }
+    result_length += element_length;
+  }
+  if (result_length == 0) return heap->empty_string();
+
+  Object* result;
+  if (is_ascii) {
+    { MaybeObject* maybe_result = heap->AllocateRawAsciiString(result_length);
+      if (!maybe_result->ToObject(&result)) return maybe_result;
+    }
+    AssertNoAllocation no_gc;
+    WriteJoinedElements(elms, len, separator,
+                        SeqAsciiString::cast(result)->GetChars());
+  } else {
+    { MaybeObject* maybe_result =
+          heap->AllocateRawTwoByteString(result_length);
+      if (!maybe_result->ToObject(&result)) return maybe_result;
+    }
+    AssertNoAllocation no_gc;
+    WriteJoinedElements(elms, len, separator,
+                        SeqTwoByteString::cast(result)->GetChars());
+  }
+  return result;
+}
+
+
 // -----------------------------------------------------------------------------
 //
 
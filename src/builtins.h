@@ -53,6 +53,9 @@ enum BuiltinExtraArguments {
   V(ArraySlice, NO_EXTRA_ARGUMENTS)                                 \
   V(ArraySplice, NO_EXTRA_ARGUMENTS)                                \
   V(ArrayConcat, NO_EXTRA_ARGUMENTS)                                \
+  V(ArrayIndexOf, NO_EXTRA_ARGUMENTS)                               \
+  V(ArrayLastIndexOf, NO_EXTRA_ARGUMENTS)                           \
+  V(ArrayJoin, NO_EXTRA_ARGUMENTS)                                  \
                                                                     \
   V(HandleApiCall, NEEDS_CALLED_FUNCTION)                           \
   V(FastHandleApiCall, NO_EXTRA_ARGUMENTS)                          \
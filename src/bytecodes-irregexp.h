@@ -89,7 +89,15 @@ V(CHECK_AT_START,    44, 8)   /* bc8 pad24 addr32                           */ \
 V(CHECK_NOT_AT_START, 45, 8)  /* bc8 pad24 addr32                           */ \
 V(CHECK_GREEDY,      46, 8)   /* bc8 pad24 addr32                           */ \
 V(ADVANCE_CP_AND_GOTO, 47, 8) /* bc8 offset24 addr32                        */ \
-V(SET_CURRENT_POSITION_FROM_END, 48, 4) /* bc8 idx24                        */
+V(SET_CURRENT_POSITION_FROM_END, 48, 4) /* bc8 idx24                        */ \
+V(LOAD_CURRENT_CHAR_CHECK_CHAR, 49, 16)                                        \
+                      /* bc8 offset24 addr32 uint32 addr32                  */ \
+V(LOAD_CURRENT_CHAR_CHECK_NOT_CHAR, 50, 16)                                    \
+                      /* bc8 offset24 addr32 uint32 addr32                  */ \
+V(LOAD_CURRENT_CHAR_UNCHECKED_CHECK_CHAR, 51, 12)                              \
+                      /* bc8 offset24 uint32 addr32                         */ \
+V(LOAD_CURRENT_CHAR_UNCHECKED_CHECK_NOT_CHAR, 52, 12)                          \
+                      /* bc8 offset24 uint32 addr32                         */
 
 #define DECLARE_BYTECODES(name, code, length) \
   static const int BC_##name = code;
@@ -32,6 +32,7 @@
 #include "compiler.h"
 #include "debug.h"
 #include "oprofile-agent.h"
+#include "parser.h"
 #include "prettyprinter.h"
 #include "register-allocator-inl.h"
 #include "rewriter.h"
@@ -408,6 +409,216 @@ void CodeGenerator::CodeForSourcePosition(int pos) {
 }
 
 
+// AST node visitor which checks that an expression only reads the
+// parameters of the function it belongs to and does not need the
+// function's frame, receiver or context.  Such an expression can be
+// compiled in the frame of a caller.  As the frame of the function is
+// never created, the expression must not be able to throw or call out to
+// other JavaScript code, which could observe the missing frame through a
+// stack trace or Function.prototype.caller.  Property loads are therefore
+// never inlined, and operations converting their operands to numbers or
+// primitives are only inlined when all arguments are numbers.
+class InlinedExpressionChecker: public AstVisitor {
+ public:
+  InlinedExpressionChecker()
+      : is_inlinable_(true),
+        needs_number_arguments_(false),
+        node_count_(0) {}
+
+  bool Check(Expression* expr) {
+    Visit(expr);
+    return is_inlinable_ && node_count_ <= FLAG_max_inlined_nodes;
+  }
+
+  bool needs_number_arguments() const { return needs_number_arguments_; }
+
+ private:
+  // AST node visit functions.
+#define DECLARE_VISIT(type) virtual void Visit##type(type* node);
+  AST_NODE_LIST(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+  void VisitNode(Expression* expr) {
+    node_count_++;
+    if (is_inlinable_) Visit(expr);
+  }
+
+  bool is_inlinable_;
+  bool needs_number_arguments_;
+  int node_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(InlinedExpressionChecker);
+};
+
+
+#define REJECT_NODE(type)                                              \
+  void InlinedExpressionChecker::Visit##type(type* node) {             \
+    is_inlinable_ = false;                                             \
+  }
+STATEMENT_NODE_LIST(REJECT_NODE)
+REJECT_NODE(Declaration)
+REJECT_NODE(FunctionLiteral)
+REJECT_NODE(SharedFunctionInfoLiteral)
+REJECT_NODE(Slot)
+REJECT_NODE(Property)
+REJECT_NODE(RegExpLiteral)
+REJECT_NODE(ObjectLiteral)
+REJECT_NODE(ArrayLiteral)
+REJECT_NODE(CatchExtensionObject)
+REJECT_NODE(Assignment)
+REJECT_NODE(Throw)
+REJECT_NODE(Call)
+REJECT_NODE(CallNew)
+REJECT_NODE(CallRuntime)
+REJECT_NODE(IncrementOperation)
+REJECT_NODE(CountOperation)
+REJECT_NODE(ThisFunction)
+#undef REJECT_NODE
+
+
+void InlinedExpressionChecker::VisitConditional(Conditional* expr) {
+  VisitNode(expr->condition());
+  VisitNode(expr->then_expression());
+  VisitNode(expr->else_expression());
+}
+
+
+void InlinedExpressionChecker::VisitVariableProxy(VariableProxy* expr) {
+  // Only the function's own stack allocated parameters can be mapped to
+  // the arguments pushed by the caller.
+  Variable* var = expr->AsVariable();
+  Slot* slot = (var == NULL) ? NULL : var->AsSlot();
+  if (slot == NULL ||
+      slot->type() != Slot::PARAMETER ||
+      slot->index() < 0 ||
+      var->is_this()) {
+    is_inlinable_ = false;
+  }
+}
+
+
+void InlinedExpressionChecker::VisitLiteral(Literal* expr) {
+}
+
+
+void InlinedExpressionChecker::VisitUnaryOperation(UnaryOperation* expr) {
+  switch (expr->op()) {
+    case Token::NOT:
+    case Token::TYPEOF:
+    case Token::VOID:
+      break;
+    case Token::ADD:
+    case Token::SUB:
+    case Token::BIT_NOT:
+      needs_number_arguments_ = true;
+      break;
+    default:
+      is_inlinable_ = false;
+      return;
+  }
+  VisitNode(expr->expression());
+}
+
+
+void InlinedExpressionChecker::VisitBinaryOperation(BinaryOperation* expr) {
+  // Everything but the control flow operators converts its operands.
+  if (expr->op() != Token::COMMA &&
+      expr->op() != Token::OR &&
+      expr->op() != Token::AND) {
+    needs_number_arguments_ = true;
+  }
+  VisitNode(expr->left());
+  VisitNode(expr->right());
+}
+
+
+void InlinedExpressionChecker::VisitCompareOperation(CompareOperation* expr) {
+  switch (expr->op()) {
+    case Token::EQ_STRICT:
+    case Token::NE_STRICT:
+      break;
+    case Token::EQ:
+    case Token::NE:
+    case Token::LT:
+    case Token::GT:
+    case Token::LTE:
+    case Token::GTE:
+      needs_number_arguments_ = true;
+      break;
+    default:
+      // 'in' and 'instanceof' throw for non-object operands.
+      is_inlinable_ = false;
+      return;
+  }
+  VisitNode(expr->left());
+  VisitNode(expr->right());
+}
+
+
+void InlinedExpressionChecker::VisitCompareToNull(CompareToNull* expr) {
+  VisitNode(expr->expression());
+}
+
+
+InlinedCall* InlinedCall::Analyze(CompilationInfo* info, Call* call) {
+  // The target is looked up in the global object of the closure being
+  // compiled, so there is nothing to inline when compiling without one.
+  if (!FLAG_inline_calls || info->closure().is_null()) return NULL;
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  // The inlined body would miss break points and LiveEdit patches.
+  if (info->isolate()->debug()->inlined_calls_disabled()) return NULL;
+#endif
+  Variable* var = call->expression()->AsVariableProxy()->AsVariable();
+  ASSERT(var != NULL && var->is_global());
+
+  Handle<GlobalObject> global(info->closure()->context()->global());
+  LookupResult lookup;
+  global->LocalLookupRealNamedProperty(*var->name(), &lookup);
+  if (!lookup.IsProperty() || lookup.type() != NORMAL) return NULL;
+  Object* value = global->GetNormalizedProperty(&lookup);
+  if (!value->IsJSFunction()) return NULL;
+  Handle<JSFunction> function(JSFunction::cast(value));
+
+  // Builtins and API functions are never inlined.  Only functions that
+  // could be compiled lazily can be reparsed on their own.
+  Handle<SharedFunctionInfo> shared(function->shared());
+  if (*shared == *info->shared_info() ||
+      function->context()->global() != *global ||
+      !shared->allows_lazy_compilation() ||
+      !shared->script()->IsScript() ||
+      Smi::cast(Script::cast(shared->script())->type())->value() !=
+          Script::TYPE_NORMAL ||
+      shared->end_position() - shared->start_position() >
+          FLAG_max_inlined_source_size) {
+    return NULL;
+  }
+
+  CompilationInfo target_info(function);
+  if (!ParserApi::Parse(&target_info)) {
+    // Only a stack overflow can make reparsing fail.  Leave it to the
+    // call to report it.
+    info->isolate()->clear_pending_exception();
+    return NULL;
+  }
+  Scope::Analyze(&target_info);
+  FunctionLiteral* literal = target_info.function();
+  if (literal->scope()->num_heap_slots() > 0 ||
+      literal->scope()->calls_eval()) {
+    return NULL;
+  }
+  ZoneList<Statement*>* body = literal->body();
+  if (body->length() != 1) return NULL;
+  ReturnStatement* statement = body->at(0)->AsReturnStatement();
+  if (statement == NULL) return NULL;
+
+  InlinedExpressionChecker checker;
+  if (!checker.Check(statement->expression())) return NULL;
+  return new InlinedCall(shared,
+                         statement->expression(),
+                         checker.needs_number_arguments());
+}
+
+
 const char* GenericUnaryOpStub::GetName() {
   switch (op_) {
     case Token::SUB:
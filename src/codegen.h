@@ -238,6 +238,41 @@ class DeferredCode: public ZoneObject {
 };
 
 
+// The target of a call to a global function whose body can be inlined at
+// the call site.  The target is the function bound to the global variable
+// when the calling function is compiled.  Only functions whose body is a
+// single return statement of an expression reading nothing but their own
+// parameters are inlined, so the inlined code does not depend on the
+// function's context and the generated code only has to check that the
+// called function still has the same shared function info.
+class InlinedCall: public ZoneObject {
+ public:
+  // Returns NULL if the call cannot be inlined.
+  static InlinedCall* Analyze(CompilationInfo* info, Call* call);
+
+  Handle<SharedFunctionInfo> shared() const { return shared_; }
+
+  // The expression returned by the inlined function.
+  Expression* result() const { return result_; }
+
+  // Whether the result expression may only be evaluated inline when all
+  // arguments are numbers, as it would otherwise call valueOf or toString.
+  bool needs_number_arguments() const { return needs_number_arguments_; }
+
+ private:
+  InlinedCall(Handle<SharedFunctionInfo> shared,
+              Expression* result,
+              bool needs_number_arguments)
+      : shared_(shared),
+        result_(result),
+        needs_number_arguments_(needs_number_arguments) { }
+
+  Handle<SharedFunctionInfo> shared_;
+  Expression* result_;
+  bool needs_number_arguments_;
+};
+
+
 } }  // namespace v8::internal
 
 #endif  // V8_CODEGEN_H_
@@ -54,6 +54,8 @@ namespace internal {
 
 Debug::Debug(Isolate* isolate)
     : has_break_points_(false),
+      functions_live_edited_(false),
+      inlined_calls_disabled_(false),
       script_cache_(NULL),
       debug_info_list_(NULL),
       disable_break_(false),
@@ -1711,7 +1713,7 @@ bool Debug::EnsureDebugInfo(Handle<SharedFunctionInfo> shared) {
   debug_info_list_ = node;
 
   // Now there is at least one break point.
-  has_break_points_ = true;
+  set_has_break_points(true);
 
   return true;
 }
@@ -1735,7 +1737,7 @@ void Debug::RemoveDebugInfo(Handle<DebugInfo> debug_info) {
 
       // If there are no more debug info objects there are not more break
       // points.
-      has_break_points_ = debug_info_list_ != NULL;
+      set_has_break_points(debug_info_list_ != NULL);
 
       return;
     }
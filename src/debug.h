@@ -276,6 +276,18 @@ class Debug {
   // Fast check to see if any break points are active.
   inline bool has_break_points() { return has_break_points_; }
 
+  // Calls to inlined function bodies take the real call while break points
+  // are set and after LiveEdit has patched any function, as the inlined
+  // body would neither stop at break points nor see the patched code.
+  inline bool inlined_calls_disabled() { return inlined_calls_disabled_; }
+  bool* inlined_calls_disabled_address() { return &inlined_calls_disabled_; }
+
+  // Called when LiveEdit replaces the code of a function.
+  void RecordLiveEdit() {
+    functions_live_edited_ = true;
+    inlined_calls_disabled_ = true;
+  }
+
   void NewBreak(StackFrame::Id break_frame_id);
   void SetBreak(StackFrame::Id break_frame_id, int break_id);
   StackFrame::Id break_frame_id() {
@@ -332,7 +344,8 @@ class Debug {
     k_after_break_target_address,
     k_debug_break_return_address,
     k_debug_break_slot_address,
-    k_restarter_frame_function_pointer
+    k_restarter_frame_function_pointer,
+    k_inlined_calls_disabled_address
   };
 
   // Support for setting the address to jump to when returning from break point.
@@ -460,6 +473,10 @@ class Debug {
   void SetAfterBreakTarget(JavaScriptFrame* frame);
   Handle<Object> CheckBreakPoints(Handle<Object> break_point);
   bool CheckBreakPoint(Handle<Object> break_point_object);
+  void set_has_break_points(bool value) {
+    has_break_points_ = value;
+    inlined_calls_disabled_ = value || functions_live_edited_;
+  }
 
   // Global handle to debug context where all the debugger JavaScript code is
   // loaded.
@@ -468,6 +485,12 @@ class Debug {
   // Boolean state indicating whether any break points are set.
   bool has_break_points_;
 
+  // Whether LiveEdit has replaced the code of any function.
+  bool functions_live_edited_;
+
+  // has_break_points_ || functions_live_edited_, read by generated code.
+  bool inlined_calls_disabled_;
+
   // Cache of all scripts in the heap.
   ScriptCache* script_cache_;
 
@@ -991,6 +1014,10 @@ class Debug_Address {
     return Debug_Address(Debug::k_restarter_frame_function_pointer);
   }
 
+  static Debug_Address InlinedCallsDisabled() {
+    return Debug_Address(Debug::k_inlined_calls_disabled_address);
+  }
+
   Address address(Isolate* isolate) const {
     Debug* debug = isolate->debug();
     switch (id_) {
@@ -1003,6 +1030,9 @@ class Debug_Address {
       case Debug::k_restarter_frame_function_pointer:
         return reinterpret_cast<Address>(
             debug->restarter_frame_function_pointer_address());
+      case Debug::k_inlined_calls_disabled_address:
+        return reinterpret_cast<Address>(
+            debug->inlined_calls_disabled_address());
       default:
         UNREACHABLE();
         return NULL;
@@ -1089,6 +1089,8 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpMaxRegisterCountIndex, Smi::FromInt(0));
   store->set(JSRegExp::kIrregexpCaptureCountIndex,
              Smi::FromInt(capture_count));
+  store->set(JSRegExp::kIrregexpLiteralIndex, HEAP->undefined_value());
+  store->set(JSRegExp::kIrregexpLiteralOffsetIndex, Smi::FromInt(-1));
   regexp->set_data(*store);
 }
 
@@ -147,6 +147,11 @@ DEFINE_bool(mask_constants_with_cookie,
 // codegen.cc
 DEFINE_bool(lazy, true, "use lazy compilation")
 DEFINE_bool(debug_info, true, "add debug information to compiled functions")
+DEFINE_bool(inline_calls, true, "inline calls to small global functions")
+DEFINE_int(max_inlined_source_size, 300,
+           "maximum source size in characters of inlined functions")
+DEFINE_int(max_inlined_nodes, 24,
+           "maximum number of AST nodes in inlined function bodies")
 
 // compiler.cc
 DEFINE_bool(strict, false, "strict error checking")
@@ -202,6 +207,8 @@ DEFINE_bool(collect_maps, true,
             "garbage collect maps from which no objects can be reached")
 DEFINE_bool(flush_code, true,
             "flush code that we expect not to use again before full gc")
+DEFINE_bool(string_slices, true,
+            "make long substrings share the characters of their parent")
 
 // v8.cc
 DEFINE_bool(use_idle_notification, true,
@@ -209,6 +216,14 @@ DEFINE_bool(use_idle_notification, true,
 // ic.cc
 DEFINE_bool(use_ic, true, "use inline caching")
 
+// stub-cache.cc
+DEFINE_int(stub_cache_primary_size, 2048,
+           "number of entries in the primary megamorphic stub cache table "
+           "(rounded up to a power of two)")
+DEFINE_int(stub_cache_secondary_size, 512,
+           "number of entries in the secondary megamorphic stub cache table "
+           "(rounded up to a power of two)")
+
 // macro-assembler-ia32.cc
 DEFINE_bool(native_code_counters, false,
             "generate extra code for manipulating stats counters")
@@ -217,9 +232,10 @@ DEFINE_bool(native_code_counters, false,
 DEFINE_bool(always_compact, false, "Perform compaction on every full GC")
 DEFINE_bool(never_compact, false,
             "Never perform compaction on full GC - testing only")
-DEFINE_bool(cleanup_ics_at_gc, true,
-            "Flush inline caches prior to mark compact collection.")
-DEFINE_bool(cleanup_caches_in_maps_at_gc, true,
+DEFINE_bool(cleanup_ics_at_gc, false,
+            "Flush inline caches prior to mark compact collection "
+            "(otherwise only inline caches with dead maps are flushed).")
+DEFINE_bool(cleanup_caches_in_maps_at_gc, false,
             "Flush code caches in maps during mark compact cycle.")
 DEFINE_int(random_seed, 0,
            "Default seed for initializing random generator "
@@ -240,6 +256,10 @@ DEFINE_int(max_map_space_pages, MapSpace::kMaxMapPageIndex - 1,
 DEFINE_bool(h, false, "print this message")
 DEFINE_bool(new_snapshot, true, "use new snapshot implementation")
 
+// objects.cc
+DEFINE_bool(unbox_double_arrays, true,
+            "store the elements of arrays of numbers as unboxed doubles")
+
 // parser.cc
 DEFINE_bool(allow_natives_syntax, false, "allow natives syntax")
 
@@ -267,6 +287,11 @@ DEFINE_bool(preemption, false,
 DEFINE_bool(trace_regexps, false, "trace regexp execution")
 DEFINE_bool(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_bool(regexp_entry_native, true, "use native code to enter regexp")
+DEFINE_int(regexp_backtrack_limit, 1000000,
+           "backtracks after which native regexp code falls back to a "
+           "linear-time matcher (0 for no limit)")
+DEFINE_bool(regexp_interpret_all, false,
+            "execute all regexps with the bytecode interpreter")
 
 // Testing flags test/cctest/test-{flags,api,serialization}.cc
 DEFINE_bool(testing_bool_flag, true, "testing_bool_flag")
@@ -59,6 +59,14 @@ namespace internal {
 #error Host architecture was not detected as supported by v8
 #endif
 
+// String scanning code in the runtime processes sixteen bytes at a time
+// when the host compiler targets SSE2.  Such code includes <emmintrin.h>
+// itself.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define V8_HOST_CAN_USE_SSE2 1
+#endif
+
 // Target architecture detection. This may be set externally. If not, detect
 // in the same way as the host architecture, that is, target the native
 // environment as presented by the compiler.
@@ -239,10 +239,11 @@ AllocationSpace Heap::TargetSpaceId(InstanceType type) {
   ASSERT(type != JS_GLOBAL_PROPERTY_CELL_TYPE);
 
   if (type < FIRST_NONSTRING_TYPE) {
-    // There are three string representations: sequential strings, cons
-    // strings, and external strings.  Only cons strings contain
-    // non-map-word pointers to heap objects.
-    return ((type & kStringRepresentationMask) == kConsStringTag)
+    // There are four string representations: sequential strings, cons
+    // strings, external strings and sliced strings.  Only cons and sliced
+    // strings contain non-map-word pointers to heap objects.
+    uint32_t tag = type & kStringRepresentationMask;
+    return (tag == kConsStringTag || tag == kSlicedStringTag)
         ? OLD_POINTER_SPACE
         : OLD_DATA_SPACE;
   } else {
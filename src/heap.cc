@@ -103,6 +103,7 @@ Heap::Heap()
       mc_count_(0),
       ms_count_(0),
       gc_count_(0),
+      ic_miss_count_(0),
       unflattened_strings_length_(0),
 #ifdef DEBUG
       allocation_allowed_(true),
@@ -271,6 +272,43 @@ GarbageCollector Heap::SelectGarbageCollector(AllocationSpace space) {
 }
 
 
+static bool DescriptorArraysMatch(void* key1, void* key2) {
+  return key1 == key2;
+}
+
+
+void Heap::UpdateMapSpaceCounters() {
+  HashMap seen(DescriptorArraysMatch);
+  int maps = 0;
+  int descriptor_arrays = 0;
+  intptr_t descriptor_array_bytes = 0;
+  HeapObjectIterator iterator(map_space());
+  for (HeapObject* object = iterator.next();
+       object != NULL;
+       object = iterator.next()) {
+    if (!object->IsMap()) continue;  // Could be a ByteArray on the free list.
+    maps++;
+    DescriptorArray* descriptors = Map::cast(object)->instance_descriptors();
+    if (descriptors->IsEmpty()) continue;
+    uint32_t hash = ComputeIntegerHash(
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(descriptors)));
+    HashMap::Entry* entry = seen.Lookup(descriptors, hash, true);
+    if (entry->value != NULL) continue;
+    entry->value = descriptors;
+    descriptor_arrays++;
+    FixedArray* contents =
+        FixedArray::cast(descriptors->get(DescriptorArray::kContentArrayIndex));
+    descriptor_array_bytes += descriptors->Size() + contents->Size();
+  }
+  isolate_->counters()->number_of_maps()->Set(maps);
+  isolate_->counters()->map_space_bytes()->Set(
+      static_cast<int>(map_space()->SizeOfObjects()));
+  isolate_->counters()->map_descriptor_arrays()->Set(descriptor_arrays);
+  isolate_->counters()->map_descriptor_array_bytes()->Set(
+      static_cast<int>(descriptor_array_bytes));
+}
+
+
 // TODO(1238405): Combine the infrastructure for --heap-stats and
 // --log-gc to avoid the complicated preprocessor and flag testing.
 #if defined(DEBUG) || defined(ENABLE_LOGGING_AND_PROFILING)
@@ -424,6 +462,9 @@ void Heap::GarbageCollectionEpilogue() {
       symbol_table()->Capacity());
   isolate_->counters()->number_of_symbols()->Set(
       symbol_table()->NumberOfElements());
+  if (isolate_->counters()->number_of_maps()->Enabled()) {
+    UpdateMapSpaceCounters();
+  }
 #if defined(DEBUG) || defined(ENABLE_LOGGING_AND_PROFILING)
   ReportStatisticsAfterGC();
 #endif
@@ -811,6 +852,8 @@ void Heap::MarkCompact(GCTracer* tracer) {
     ms_count_++;
   }
   tracer->set_full_gc_count(mc_count_ + ms_count_);
+  tracer->set_ic_misses(ic_miss_count_);
+  ic_miss_count_ = 0;
 
   MarkCompactPrologue(is_compacting);
 
@@ -1181,6 +1224,7 @@ class ScavengingVisitor : public StaticVisitorBase {
     table_.Register(kVisitSeqTwoByteString, &EvacuateSeqTwoByteString);
     table_.Register(kVisitShortcutCandidate, &EvacuateShortcutCandidate);
     table_.Register(kVisitByteArray, &EvacuateByteArray);
+    table_.Register(kVisitFixedDoubleArray, &EvacuateFixedDoubleArray);
     table_.Register(kVisitFixedArray, &EvacuateFixedArray);
     table_.Register(kVisitGlobalContext,
                     &ObjectEvacuationStrategy<POINTER_OBJECT>::
@@ -1192,6 +1236,8 @@ class ScavengingVisitor : public StaticVisitorBase {
                     &ObjectEvacuationStrategy<POINTER_OBJECT>::
                         VisitSpecialized<ConsString::kSize>);
 
+    table_.Register(kVisitSlicedString, &EvacuateSlicedString);
+
     table_.Register(kVisitSharedFunctionInfo,
                     &ObjectEvacuationStrategy<POINTER_OBJECT>::
                         VisitSpecialized<SharedFunctionInfo::kSize>);
@@ -1337,6 +1383,15 @@ class ScavengingVisitor : public StaticVisitorBase {
   }
 
 
+  static inline void EvacuateFixedDoubleArray(Map* map,
+                                              HeapObject** slot,
+                                              HeapObject* object) {
+    int object_size =
+        reinterpret_cast<FixedDoubleArray*>(object)->FixedDoubleArraySize();
+    EvacuateObject<DATA_OBJECT, UNKNOWN_SIZE>(map, slot, object, object_size);
+  }
+
+
   static inline void EvacuateSeqAsciiString(Map* map,
                                             HeapObject** slot,
                                             HeapObject* object) {
@@ -1394,6 +1449,81 @@ class ScavengingVisitor : public StaticVisitorBase {
     EvacuateObject<POINTER_OBJECT, SMALL>(map, slot, object, object_size);
   }
 
+  // A slice of a much longer parent keeps all of the parent's characters
+  // alive.  Such slices are replaced by a sequential copy of their
+  // characters when they are evacuated, so the parent can die.
+  static const int kSlicedStringCopyOutRatio = 8;
+
+  static inline void EvacuateSlicedString(Map* map,
+                                          HeapObject** slot,
+                                          HeapObject* object) {
+    SlicedString* slice = reinterpret_cast<SlicedString*>(object);
+    HeapObject* parent = HeapObject::cast(slice->unchecked_parent());
+    MapWord parent_word = parent->map_word();
+    if (parent_word.IsForwardingAddress()) {
+      parent = parent_word.ToForwardingAddress();
+    }
+    String* parent_string = reinterpret_cast<String*>(parent);
+    int length = slice->length();
+    if (parent_string->length() / kSlicedStringCopyOutRatio >= length) {
+      HeapObject* copy = CopyOutSlice(map->heap(),
+                                      parent_string,
+                                      slice->offset(),
+                                      length,
+                                      map->instance_type());
+      if (copy != NULL) {
+        *slot = copy;
+        object->set_map_word(MapWord::FromForwardingAddress(copy));
+        return;
+      }
+    }
+    EvacuateObject<POINTER_OBJECT, SMALL>(map, slot, object,
+                                          SlicedString::kSize);
+  }
+
+  // Returns NULL if there is no room for the copy.  The copy only goes to
+  // new space if it is no bigger than the slice, so scavenging can never
+  // need more new space than was in use before.
+  static inline HeapObject* CopyOutSlice(Heap* heap,
+                                         String* parent,
+                                         int offset,
+                                         int length,
+                                         InstanceType type) {
+    bool is_ascii = (type & kStringEncodingMask) == kAsciiStringTag;
+    int size = is_ascii ? SeqAsciiString::SizeFor(length)
+                        : SeqTwoByteString::SizeFor(length);
+    MaybeObject* maybe_result;
+    if (size <= SlicedString::kSize) {
+      maybe_result = heap->new_space()->AllocateRaw(size);
+    } else {
+      maybe_result = heap->old_data_space()->AllocateRaw(size);
+    }
+    Object* result;
+    if (!maybe_result->ToObject(&result)) return NULL;
+    String* copy = reinterpret_cast<String*>(result);
+    if (is_ascii) {
+      copy->set_map(heap->ascii_string_map());
+      copy->set_length(length);
+      copy->set_hash_field(String::kEmptyHashField);
+      String::WriteToFlat(parent,
+                          SeqAsciiString::cast(copy)->GetChars(),
+                          offset,
+                          offset + length);
+    } else {
+      copy->set_map(heap->string_map());
+      copy->set_length(length);
+      copy->set_hash_field(String::kEmptyHashField);
+      String::WriteToFlat(parent,
+                          SeqTwoByteString::cast(copy)->GetChars(),
+                          offset,
+                          offset + length);
+    }
+    if (!heap->InNewSpace(copy)) {
+      heap->tracer()->increment_promoted_objects_size(size);
+    }
+    return copy;
+  }
+
   template<ObjectContents object_contents>
   class ObjectEvacuationStrategy {
    public:
@@ -1673,6 +1803,12 @@ bool Heap::CreateInitialMaps() {
   }
   set_external_float_array_map(Map::cast(obj));
 
+  { MaybeObject* maybe_obj =
+        AllocateMap(FIXED_DOUBLE_ARRAY_TYPE, kVariableSizeSentinel);
+    if (!maybe_obj->ToObject(&obj)) return false;
+  }
+  set_fixed_double_array_map(Map::cast(obj));
+
   { MaybeObject* maybe_obj = AllocateMap(CODE_TYPE, kVariableSizeSentinel);
     if (!maybe_obj->ToObject(&obj)) return false;
   }
@@ -2419,8 +2555,42 @@ MaybeObject* Heap::AllocateSubString(String* buffer,
     return MakeOrFindTwoCharacterString(this, c1, c2);
   }
 
-  // Make an attempt to flatten the buffer to reduce access time.
-  buffer = buffer->TryFlattenGetString();
+  // Long substrings of flat strings share the characters of the buffer.
+  // Slices are only made in new space, where the scavenger copies out
+  // short slices of long parents.
+  if (FLAG_string_slices &&
+      length >= SlicedString::kMinLength &&
+      pretenure == NOT_TENURED) {
+    String* parent = buffer;
+    if (parent->IsConsString() && parent->IsFlat()) {
+      parent = ConsString::cast(parent)->first();
+    }
+    if (StringShape(parent).IsSliced()) {
+      SlicedString* slice = SlicedString::cast(parent);
+      start += slice->offset();
+      parent = slice->parent();
+    }
+    if (StringShape(parent).IsSequential() ||
+        StringShape(parent).IsExternal()) {
+      Map* map = parent->IsAsciiRepresentation()
+          ? sliced_ascii_string_map()
+          : sliced_string_map();
+      Object* result;
+      { MaybeObject* maybe_result = Allocate(map, NEW_SPACE);
+        if (!maybe_result->ToObject(&result)) return maybe_result;
+      }
+      SlicedString* slice = SlicedString::cast(result);
+      slice->set_length(length);
+      slice->set_hash_field(String::kEmptyHashField);
+      slice->set_parent(parent, SKIP_WRITE_BARRIER);
+      slice->set_offset(start);
+      return slice;
+    }
+  }
+
+  // The buffer is not flattened here.  Copying out of a cons string only
+  // walks the part of the tree that covers the substring, and callers that
+  // read the same cons string repeatedly flatten it themselves.
 
   Object* result;
   { MaybeObject* maybe_result = buffer->IsAsciiRepresentation()
@@ -3163,10 +3333,20 @@ MaybeObject* Heap::CopyJSObject(JSObject* source) {
               object_size);
   }
 
-  FixedArray* elements = FixedArray::cast(source->elements());
+  HeapObject* source_elements = source->elements();
   FixedArray* properties = FixedArray::cast(source->properties());
   // Update elements if necessary.
-  if (elements->length() > 0) {
+  if (source_elements->IsFixedDoubleArray()) {
+    FixedDoubleArray* elements = FixedDoubleArray::cast(source_elements);
+    if (elements->length() > 0) {
+      Object* elem;
+      { MaybeObject* maybe_elem = CopyFixedDoubleArray(elements);
+        if (!maybe_elem->ToObject(&elem)) return maybe_elem;
+      }
+      JSObject::cast(clone)->set_elements(FixedDoubleArray::cast(elem));
+    }
+  } else if (FixedArray::cast(source_elements)->length() > 0) {
+    FixedArray* elements = FixedArray::cast(source_elements);
     Object* elem;
     { MaybeObject* maybe_elem =
           (elements->map() == fixed_cow_array_map()) ?
@@ -3227,46 +3407,48 @@ MaybeObject* Heap::AllocateStringFromAscii(Vector<const char> string,
 
   // Copy the characters into the new object.
   SeqAsciiString* string_result = SeqAsciiString::cast(result);
-  for (int i = 0; i < string.length(); i++) {
-    string_result->SeqAsciiStringSet(i, string[i]);
-  }
+  CopyChars(string_result->GetChars(), string.start(), string.length());
   return result;
 }
 
 
 MaybeObject* Heap::AllocateStringFromUtf8(Vector<const char> string,
                                           PretenureFlag pretenure) {
+  // If the string is ascii, we do not need to convert the characters
+  // since UTF8 is backwards compatible with ascii.
+  int ascii_length = NonAsciiStart(string.start(), string.length());
+  if (ascii_length == string.length()) {
+    return AllocateStringFromAscii(string, pretenure);
+  }
+
   // V8 only supports characters in the Basic Multilingual Plane.
   const uc32 kMaxSupportedChar = 0xFFFF;
-  // Count the number of characters in the UTF-8 string and check if
-  // it is an ASCII string.
+  // Count the number of characters in the UTF-8 string after the ascii
+  // prefix.
+  Vector<const char> rest = string.SubVector(ascii_length, string.length());
   Access<ScannerConstants::Utf8Decoder>
       decoder(isolate_->scanner_constants()->utf8_decoder());
-  decoder->Reset(string.start(), string.length());
-  int chars = 0;
-  bool is_ascii = true;
+  decoder->Reset(rest.start(), rest.length());
+  int chars = ascii_length;
   while (decoder->has_more()) {
-    uc32 r = decoder->GetNext();
-    if (r > String::kMaxAsciiCharCode) is_ascii = false;
+    decoder->GetNext();
     chars++;
   }
 
-  // If the string is ascii, we do not need to convert the characters
-  // since UTF8 is backwards compatible with ascii.
-  if (is_ascii) return AllocateStringFromAscii(string, pretenure);
-
   Object* result;
   { MaybeObject* maybe_result = AllocateRawTwoByteString(chars, pretenure);
     if (!maybe_result->ToObject(&result)) return maybe_result;
   }
 
-  // Convert and copy the characters into the new object.
-  String* string_result = String::cast(result);
-  decoder->Reset(string.start(), string.length());
-  for (int i = 0; i < chars; i++) {
+  // Copy the ascii prefix and convert the rest of the characters into the
+  // new object.
+  uc16* chars_result = SeqTwoByteString::cast(result)->GetChars();
+  CopyChars(chars_result, string.start(), ascii_length);
+  decoder->Reset(rest.start(), rest.length());
+  for (int i = ascii_length; i < chars; i++) {
     uc32 r = decoder->GetNext();
     if (r > kMaxSupportedChar) { r = unibrow::Utf8::kBadChar; }
-    string_result->Set(i, r);
+    chars_result[i] = r;
   }
   return result;
 }
@@ -3514,6 +3696,21 @@ MaybeObject* Heap::CopyFixedArrayWithMap(FixedArray* src, Map* map) {
 }
 
 
+MaybeObject* Heap::CopyFixedDoubleArray(FixedDoubleArray* src) {
+  int len = src->length();
+  Object* obj;
+  { MaybeObject* maybe_obj = AllocateUninitializedFixedDoubleArray(len);
+    if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+  }
+  // Doubles are not tagged, so the block can be copied into any space.
+  HeapObject* dst = HeapObject::cast(obj);
+  CopyBlock(dst->address() + FixedDoubleArray::kHeaderSize,
+            src->address() + FixedDoubleArray::kHeaderSize,
+            FixedDoubleArray::SizeFor(len) - FixedDoubleArray::kHeaderSize);
+  return obj;
+}
+
+
 MaybeObject* Heap::AllocateFixedArray(int length) {
   ASSERT(length >= 0);
   if (length == 0) return empty_fixed_array();
@@ -3596,6 +3793,39 @@ MaybeObject* Heap::AllocateFixedArrayWithHoles(int length,
 }
 
 
+MaybeObject* Heap::AllocateUninitializedFixedDoubleArray(
+    int length,
+    PretenureFlag pretenure) {
+  if (length < 0 || length > FixedDoubleArray::kMaxLength) {
+    return Failure::OutOfMemoryException();
+  }
+  int size = FixedDoubleArray::SizeFor(length);
+  AllocationSpace space = (pretenure == TENURED) ? OLD_DATA_SPACE : NEW_SPACE;
+  AllocationSpace retry_space = OLD_DATA_SPACE;
+
+  if (space == NEW_SPACE) {
+    if (size > kMaxObjectSizeInNewSpace) {
+      // Allocate in large object space, retry space will be ignored.
+      space = LO_SPACE;
+    } else if (size > MaxObjectSizeInPagedSpace()) {
+      // Allocate in new space, retry in large object space.
+      retry_space = LO_SPACE;
+    }
+  } else if (space == OLD_DATA_SPACE && size > MaxObjectSizeInPagedSpace()) {
+    space = LO_SPACE;
+  }
+  Object* result;
+  { MaybeObject* maybe_result = AllocateRaw(size, space, retry_space);
+    if (!maybe_result->ToObject(&result)) return maybe_result;
+  }
+
+  reinterpret_cast<FixedDoubleArray*>(result)->set_map(
+      fixed_double_array_map());
+  reinterpret_cast<FixedDoubleArray*>(result)->set_length(length);
+  return result;
+}
+
+
 MaybeObject* Heap::AllocateUninitializedFixedArray(int length) {
   if (length == 0) return empty_fixed_array();
 
@@ -5226,6 +5456,9 @@ GCTracer::GCTracer(Heap* heap)
       allocated_since_last_gc_(0),
       spent_in_mutator_(0),
       promoted_objects_size_(0),
+      ic_misses_(0),
+      ic_sites_retained_(0),
+      ic_sites_cleared_(0),
       heap_(heap) {
   // These two fields reflect the state of the previous full collection.
   // Set them before they are changed by the collector.
@@ -5317,6 +5550,10 @@ GCTracer::~GCTracer() {
     PrintF("allocated=%" V8_PTR_PREFIX "d ", allocated_since_last_gc_);
     PrintF("promoted=%" V8_PTR_PREFIX "d ", promoted_objects_size_);
 
+    PrintF("ic_misses=%d ", ic_misses_);
+    PrintF("ic_sites_retained=%d ", ic_sites_retained_);
+    PrintF("ic_sites_cleared=%d ", ic_sites_cleared_);
+
     PrintF("\n");
   }
 
@@ -82,6 +82,8 @@ inline Heap* _inline_get_heap_();
   V(Map, external_string_map, ExternalStringMap)                               \
   V(Map, external_string_with_ascii_data_map, ExternalStringWithAsciiDataMap)  \
   V(Map, external_ascii_string_map, ExternalAsciiStringMap)                    \
+  V(Map, sliced_string_map, SlicedStringMap)                                   \
+  V(Map, sliced_ascii_string_map, SlicedAsciiStringMap)                        \
   V(Map, undetectable_string_map, UndetectableStringMap)                       \
   V(Map, undetectable_ascii_string_map, UndetectableAsciiStringMap)            \
   V(Map, pixel_array_map, PixelArrayMap)                                       \
@@ -92,6 +94,7 @@ inline Heap* _inline_get_heap_();
   V(Map, external_int_array_map, ExternalIntArrayMap)                          \
   V(Map, external_unsigned_int_array_map, ExternalUnsignedIntArrayMap)         \
   V(Map, external_float_array_map, ExternalFloatArrayMap)                      \
+  V(Map, fixed_double_array_map, FixedDoubleArrayMap)                          \
   V(Map, context_map, ContextMap)                                              \
   V(Map, catch_context_map, CatchContextMap)                                   \
   V(Map, code_map, CodeMap)                                                    \
@@ -591,6 +594,10 @@ class Heap {
   // Failure::RetryAfterGC(requested_bytes, space) if the allocation failed.
   MUST_USE_RESULT MaybeObject* CopyFixedArrayWithMap(FixedArray* src, Map* map);
 
+  // Make a copy of src and return it. Returns
+  // Failure::RetryAfterGC(requested_bytes, space) if the allocation failed.
+  MUST_USE_RESULT MaybeObject* CopyFixedDoubleArray(FixedDoubleArray* src);
+
   // Allocates a fixed array initialized with the hole values.
   // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
   // failed.
@@ -599,6 +606,14 @@ class Heap {
       int length,
       PretenureFlag pretenure = NOT_TENURED);
 
+  // Allocates a fixed double array with all elements uninitialized.
+  // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
+  // failed.
+  // Please note this does not perform a garbage collection.
+  MUST_USE_RESULT MaybeObject* AllocateUninitializedFixedDoubleArray(
+      int length,
+      PretenureFlag pretenure = NOT_TENURED);
+
   // AllocateHashTable is identical to AllocateFixedArray except
   // that the resulting object has hash_table_map as map.
   MUST_USE_RESULT MaybeObject* AllocateHashTable(
@@ -795,6 +810,10 @@ class Heap {
   // Notify the heap that a context has been disposed.
   int NotifyContextDisposed() { return ++contexts_disposed_; }
 
+  // Notify the heap that an inline cache missed.  The misses are counted
+  // per full collection and reported by the GC tracer.
+  void NotifyICMiss() { ic_miss_count_++; }
+
   // Utility to invoke the scavenger. This is needed in test code to
   // ensure correct callback for weak global handles.
   void PerformScavenge();
@@ -1231,6 +1250,7 @@ class Heap {
   int mc_count_;  // how many mark-compact collections happened
   int ms_count_;  // how many mark-sweep collections happened
   int gc_count_;  // how many gc happened
+  int ic_miss_count_;  // how many IC misses since the last full gc
 
   // Total length of the strings we failed to flatten since the last GC.
   int unflattened_strings_length_;
@@ -1418,6 +1438,10 @@ class Heap {
   // around a GC).
   inline void CompletelyClearInstanceofCache();
 
+  // Update the counters describing the maps in map space and the
+  // descriptor arrays they use.  Shared descriptor arrays are counted once.
+  void UpdateMapSpaceCounters();
+
 #if defined(DEBUG) || defined(ENABLE_LOGGING_AND_PROFILING)
   // Record statistics before and after garbage collection.
   void ReportStatisticsBeforeGC();
@@ -1997,6 +2021,15 @@ class GCTracer BASE_EMBEDDED {
     promoted_objects_size_ += object_size;
   }
 
+  // Sets the number of inline cache misses since the previous full GC.
+  void set_ic_misses(int count) { ic_misses_ = count; }
+
+  // Sets the number of inline cache sites kept and cleared by a full GC.
+  void set_ic_sites(int retained, int cleared) {
+    ic_sites_retained_ = retained;
+    ic_sites_cleared_ = cleared;
+  }
+
  private:
   // Returns a string matching the collector.
   const char* CollectorString();
@@ -2052,6 +2085,15 @@ class GCTracer BASE_EMBEDDED {
   // Size of objects promoted during the current collection.
   intptr_t promoted_objects_size_;
 
+  // Number of inline cache misses between the previous full collection and
+  // the current one.  Zero on a scavenge collection.
+  int ic_misses_;
+
+  // Number of inline cache sites whose targets were kept alive and cleared
+  // by the current full collection.
+  int ic_sites_retained_;
+  int ic_sites_cleared_;
+
   Heap* heap_;
 };
 
@@ -610,12 +610,59 @@ void Builtins::Generate_FunctionCall(MacroAssembler* masm) {
 }
 
 
+// Load the map of arguments objects from the global context of the
+// current context.
+static void GenerateLoadArgumentsBoilerplateMap(MacroAssembler* masm,
+                                                Register result) {
+  __ mov(result, Operand(esi, Context::SlotOffset(Context::GLOBAL_INDEX)));
+  __ mov(result, FieldOperand(result, GlobalObject::kGlobalContextOffset));
+  __ mov(result, Operand(result, Context::SlotOffset(
+      Context::ARGUMENTS_BOILERPLATE_INDEX)));
+  __ mov(result, FieldOperand(result, HeapObject::kMapOffset));
+}
+
+
+// Function.prototype.apply copies at most this many arguments without
+// calling APPLY_PREPARE; it matches the limit checked there.
+static const int kMaxFastApplyLength = 0x800000;
+
+
 void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   __ EnterInternalFrame();
 
+  // Skip APPLY_PREPARE if the function is a JSFunction and the arguments
+  // are a JSArray or an arguments object with a small smi length.
+  Label prepare, prepared, arguments_object, check_length;
+  __ mov(edi, Operand(ebp, 4 * kPointerSize));
+  __ test(edi, Immediate(kSmiTagMask));
+  __ j(zero, &prepare);
+  __ CmpObjectType(edi, JS_FUNCTION_TYPE, ecx);
+  __ j(not_equal, &prepare);
+  __ mov(edx, Operand(ebp, 2 * kPointerSize));
+  __ test(edx, Immediate(kSmiTagMask));
+  __ j(zero, &prepare);
+  __ CmpObjectType(edx, JS_ARRAY_TYPE, ecx);
+  __ j(not_equal, &arguments_object);
+  __ mov(eax, FieldOperand(edx, JSArray::kLengthOffset));
+  __ jmp(&check_length);
+  __ bind(&arguments_object);
+  GenerateLoadArgumentsBoilerplateMap(masm, ebx);
+  __ cmp(ecx, Operand(ebx));
+  __ j(not_equal, &prepare);
+  __ mov(eax, FieldOperand(edx, JSObject::kHeaderSize +
+                                Heap::arguments_length_index * kPointerSize));
+  __ bind(&check_length);
+  // A non-negative smi below the limit.
+  __ test(eax, Immediate(kSmiTagMask | 0x80000000));
+  __ j(not_zero, &prepare);
+  __ cmp(Operand(eax), Immediate(Smi::FromInt(kMaxFastApplyLength)));
+  __ j(less, &prepared);
+
+  __ bind(&prepare);
   __ push(Operand(ebp, 4 * kPointerSize));  // push this
   __ push(Operand(ebp, 2 * kPointerSize));  // push arguments
   __ InvokeBuiltin(Builtins::APPLY_PREPARE, CALL_FUNCTION);
+  __ bind(&prepared);
 
   // Check the stack for overflow. We are not trying need to catch
   // interruptions (e.g. debug break and preemption) here, so the "real stack
@@ -694,8 +741,53 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   __ bind(&push_receiver);
   __ push(ebx);
 
+  // Copy the elements of a JSArray or an arguments object with a fast
+  // backing store straight onto the stack.  The checks are done here,
+  // after any calls that could have changed the arguments.
+  Label generic, fast_elements, copy, fast_loop, fast_entry, hole, invoke;
+  __ mov(edx, Operand(ebp, 2 * kPointerSize));
+  __ test(edx, Immediate(kSmiTagMask));
+  __ j(zero, &generic);
+  __ CmpObjectType(edx, JS_ARRAY_TYPE, ecx);
+  __ j(equal, &fast_elements);
+  GenerateLoadArgumentsBoilerplateMap(masm, ebx);
+  __ cmp(ecx, Operand(ebx));
+  __ j(not_equal, &generic);
+  __ bind(&fast_elements);
+  __ mov(ebx, FieldOperand(edx, JSObject::kElementsOffset));
+  __ mov(ecx, FieldOperand(ebx, HeapObject::kMapOffset));
+  __ cmp(Operand(ecx), Immediate(FACTORY->fixed_array_map()));
+  __ j(equal, &copy);
+  __ cmp(Operand(ecx), Immediate(FACTORY->fixed_cow_array_map()));
+  __ j(not_equal, &generic);
+  __ bind(&copy);
+  __ mov(eax, Operand(ebp, kLimitOffset));
+  __ cmp(eax, FieldOperand(ebx, FixedArray::kLengthOffset));
+  __ j(above, &generic);
+  __ SmiUntag(eax);
+  __ Set(ecx, Immediate(0));
+  __ jmp(&fast_entry);
+  __ bind(&fast_loop);
+  __ mov(edx, FieldOperand(ebx, ecx, times_pointer_size,
+                           FixedArray::kHeaderSize));
+  __ cmp(Operand(edx), Immediate(FACTORY->the_hole_value()));
+  __ j(equal, &hole);
+  __ push(edx);
+  __ inc(ecx);
+  __ bind(&fast_entry);
+  __ cmp(ecx, Operand(eax));
+  __ j(less, &fast_loop);
+  __ mov(eax, Operand(ebp, kLimitOffset));
+  __ jmp(&invoke);
+
+  // Holes are looked up in the prototype chain.  Drop the elements
+  // copied so far, keeping the receiver, and use keyed loads instead.
+  __ bind(&hole);
+  __ lea(esp, Operand(ebp, kIndexOffset - kPointerSize));
+
   // Copy all arguments from the array to the stack.
   Label entry, loop;
+  __ bind(&generic);
   __ mov(eax, Operand(ebp, kIndexOffset));
   __ jmp(&entry);
   __ bind(&loop);
@@ -723,6 +815,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   __ j(not_equal, &loop);
 
   // Invoke the function.
+  __ bind(&invoke);
   ParameterCount actual(eax);
   __ SmiUntag(eax);
   __ mov(edi, Operand(ebp, 4 * kPointerSize));
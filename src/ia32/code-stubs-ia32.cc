@@ -208,6 +208,59 @@ void FastCloneShallowArrayStub::Generate(MacroAssembler* masm) {
 }
 
 
+void FastCloneShallowObjectStub::Generate(MacroAssembler* masm) {
+  // Stack layout on entry:
+  //
+  // [esp + kPointerSize]: fast elements flag.
+  // [esp + (2 * kPointerSize)]: constant properties.
+  // [esp + (3 * kPointerSize)]: literal index.
+  // [esp + (4 * kPointerSize)]: literals array.
+
+  // All properties are expected to be in-object.
+  int size = JSObject::kHeaderSize + length_ * kPointerSize;
+
+  // Load boilerplate object into ecx and check if we need to create a
+  // boilerplate.
+  Label slow_case;
+  __ mov(ecx, Operand(esp, 4 * kPointerSize));
+  __ mov(eax, Operand(esp, 3 * kPointerSize));
+  STATIC_ASSERT(kPointerSize == 4);
+  STATIC_ASSERT(kSmiTagSize == 1);
+  STATIC_ASSERT(kSmiTag == 0);
+  __ mov(ecx, FieldOperand(ecx, eax, times_half_pointer_size,
+                           FixedArray::kHeaderSize));
+  __ cmp(ecx, FACTORY->undefined_value());
+  __ j(equal, &slow_case);
+
+  // Check that the boilerplate has the expected size and that it has
+  // neither out-of-object properties nor elements to copy.
+  __ mov(eax, FieldOperand(ecx, HeapObject::kMapOffset));
+  __ cmpb(FieldOperand(eax, Map::kInstanceSizeOffset),
+          static_cast<int8_t>(size >> kPointerSizeLog2));
+  __ j(not_equal, &slow_case);
+  __ cmp(FieldOperand(ecx, JSObject::kPropertiesOffset),
+         FACTORY->empty_fixed_array());
+  __ j(not_equal, &slow_case);
+  __ cmp(FieldOperand(ecx, JSObject::kElementsOffset),
+         FACTORY->empty_fixed_array());
+  __ j(not_equal, &slow_case);
+
+  // Allocate the JS object and copy the boilerplate.  The copy is in new
+  // space, so no write barrier is needed.
+  __ AllocateInNewSpace(size, eax, ebx, edx, &slow_case, TAG_OBJECT);
+  for (int i = 0; i < size; i += kPointerSize) {
+    __ mov(ebx, FieldOperand(ecx, i));
+    __ mov(FieldOperand(eax, i), ebx);
+  }
+
+  // Return and remove the on-stack parameters.
+  __ ret(4 * kPointerSize);
+
+  __ bind(&slow_case);
+  __ TailCallRuntime(Runtime::kCreateObjectLiteralShallow, 4, 1);
+}
+
+
 // NOTE: The stub does not handle the inlined cases (Smis, Booleans, undefined).
 void ToBooleanStub::Generate(MacroAssembler* masm) {
   NearLabel false_result, true_result, not_string;
@@ -2277,6 +2330,20 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmp(eax, Operand(ebx));
   __ j(above_equal, &runtime);
 
+  // ebx: Length of subject string as a smi
+  // ecx: RegExp data (FixedArray)
+  // Searching for the literal that every match contains is faster than
+  // trying each start position in the regexp code, so long subjects are
+  // matched in the runtime system if there is such a literal.
+  NearLabel no_literal_search;
+  __ cmp(Operand(ebx), Immediate(Smi::FromInt(
+      RegExpImpl::kLiteralSearchMinSubjectLength)));
+  __ j(less, &no_literal_search);
+  __ cmp(FieldOperand(ecx, JSRegExp::kDataIrregexpLiteralOffset),
+         Immediate(FACTORY->undefined_value()));
+  __ j(not_equal, &runtime);
+  __ bind(&no_literal_search);
+
   // ecx: RegExp data (FixedArray)
   // edx: Number of capture registers
   // Check that the fourth object is a JSArray object.
@@ -2434,7 +2501,8 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmp(eax, NativeRegExpMacroAssembler::FAILURE);
   __ j(equal, &failure, taken);
   __ cmp(eax, NativeRegExpMacroAssembler::EXCEPTION);
-  // If not exception it can only be retry. Handle that in the runtime system.
+  // If not exception it can only be retry or the backtrack limit. Handle that
+  // in the runtime system.
   __ j(not_equal, &runtime);
   // Result must now be exception. If there is no pending exception already a
   // stack overflow (on the backtrack stack) was detected in RegExp code but
@@ -3540,6 +3608,7 @@ const char* CompareStub::GetName() {
 
 void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   Label flat_string;
+  Label cons_string;
   Label ascii_string;
   Label got_char_code;
 
@@ -3574,14 +3643,32 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   __ j(zero, &flat_string);
 
   // Handle non-flat strings.
-  __ test(result_, Immediate(kIsConsStringMask));
-  __ j(zero, &call_runtime_);
+  __ and_(result_, kStringRepresentationMask);
+  __ cmp(result_, kConsStringTag);
+  __ j(equal, &cons_string);
+  __ cmp(result_, kSlicedStringTag);
+  __ j(not_equal, &call_runtime_);
+
+  // SlicedString.
+  // Read the character from the parent if it is sequential.  The runtime
+  // system is called with the slice itself otherwise.
+  __ mov(result_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ mov(result_, FieldOperand(result_, HeapObject::kMapOffset));
+  __ movzx_b(result_, FieldOperand(result_, Map::kInstanceTypeOffset));
+  STATIC_ASSERT(kSeqStringTag == 0);
+  __ test(result_, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &call_runtime_);
+  // Both the index and the offset are smis.
+  __ add(scratch_, FieldOperand(object_, SlicedString::kOffsetOffset));
+  __ mov(object_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ jmp(&flat_string);
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
   // this is really a flat string in a cons string). If that is not
   // the case we would rather go to the runtime system now to flatten
   // the string.
+  __ bind(&cons_string);
   __ cmp(FieldOperand(object_, ConsString::kSecondOffset),
          Immediate(FACTORY->empty_string()));
   __ j(not_equal, &call_runtime_);
@@ -3900,22 +3987,21 @@ void StringAddStub::Generate(MacroAssembler* masm) {
   __ AllocateConsString(ecx, edi, no_reg, &string_add_runtime);
   __ jmp(&allocated);
 
-  // Handle creating a flat result. First check that both strings are not
-  // external strings.
+  // Handle creating a flat result. First check that both strings are
+  // sequential strings.
   // eax: first string
   // ebx: length of resulting flat string as a smi
   // edx: second string
   __ bind(&string_add_flat_result);
+  STATIC_ASSERT(kSeqStringTag == 0);
   __ mov(ecx, FieldOperand(eax, HeapObject::kMapOffset));
-  __ movzx_b(ecx, FieldOperand(ecx, Map::kInstanceTypeOffset));
-  __ and_(ecx, kStringRepresentationMask);
-  __ cmp(ecx, kExternalStringTag);
-  __ j(equal, &string_add_runtime);
+  __ test_b(FieldOperand(ecx, Map::kInstanceTypeOffset),
+            kStringRepresentationMask);
+  __ j(not_zero, &string_add_runtime);
   __ mov(ecx, FieldOperand(edx, HeapObject::kMapOffset));
-  __ movzx_b(ecx, FieldOperand(ecx, Map::kInstanceTypeOffset));
-  __ and_(ecx, kStringRepresentationMask);
-  __ cmp(ecx, kExternalStringTag);
-  __ j(equal, &string_add_runtime);
+  __ test_b(FieldOperand(ecx, Map::kInstanceTypeOffset),
+            kStringRepresentationMask);
+  __ j(not_zero, &string_add_runtime);
   // Now check if both strings are ascii strings.
   // eax: first string
   // ebx: length of resulting flat string as a smi
@@ -4393,6 +4479,50 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   // eax: string
   // ebx: instance type
   // ecx: result string length
+  if (FLAG_string_slices) {
+    // Long sub strings of sequential, external and sliced strings share
+    // their characters.
+    Label copy_characters, two_byte_slice, set_slice_header, not_sliced;
+    __ cmp(ecx, SlicedString::kMinLength);
+    __ j(less, &copy_characters);
+    __ mov(edi, ebx);
+    __ and_(edi, kStringRepresentationMask);
+    __ cmp(edi, kConsStringTag);
+    __ j(equal, &runtime);
+    // A sliced string has the same encoding as its parent.
+    STATIC_ASSERT(kAsciiStringTag != 0);
+    __ test(ebx, Immediate(kStringEncodingMask));
+    __ j(zero, &two_byte_slice);
+    __ AllocateAsciiSlicedString(edi, ebx, edx, &runtime);
+    __ jmp(&set_slice_header);
+    __ bind(&two_byte_slice);
+    __ AllocateSlicedString(edi, ebx, edx, &runtime);
+    __ bind(&set_slice_header);
+    __ SmiTag(ecx);
+    __ mov(FieldOperand(edi, SlicedString::kLengthOffset), ecx);
+    __ mov(FieldOperand(edi, SlicedString::kHashFieldOffset),
+           Immediate(String::kEmptyHashField));
+    // edi: sliced string
+    // eax: string
+    // edx: from index in eax (smi)
+    __ mov(edx, Operand(esp, 2 * kPointerSize));
+    __ mov(ebx, FieldOperand(eax, HeapObject::kMapOffset));
+    __ movzx_b(ebx, FieldOperand(ebx, Map::kInstanceTypeOffset));
+    __ and_(ebx, kStringRepresentationMask);
+    __ cmp(ebx, kSlicedStringTag);
+    __ j(not_equal, &not_sliced);
+    // Both the from index and the offset are smis.
+    __ add(edx, FieldOperand(eax, SlicedString::kOffsetOffset));
+    __ mov(eax, FieldOperand(eax, SlicedString::kParentOffset));
+    __ bind(&not_sliced);
+    __ mov(FieldOperand(edi, SlicedString::kParentOffset), eax);
+    __ mov(FieldOperand(edi, SlicedString::kOffsetOffset), edx);
+    __ mov(eax, edi);
+    __ IncrementCounter(COUNTERS->sub_string_native(), 1);
+    __ ret(3 * kPointerSize);
+
+    __ bind(&copy_characters);
+  }
   // Check for flat ascii string
   Label non_ascii_flat;
   __ JumpIfInstanceTypeIsNotSequentialAscii(ebx, ebx, &non_ascii_flat);
@@ -153,6 +153,8 @@ CodeGenerator::CodeGenerator(MacroAssembler* masm)
       in_safe_int32_mode_(false),
       safe_int32_mode_enabled_(true),
       function_return_is_shadowed_(false),
+      inlined_arguments_base_(-1),
+      inlined_argument_count_(0),
       in_spilled_code_(false),
       jit_cookie_((FLAG_mask_constants_with_cookie) ?
                   V8::RandomPrivate(Isolate::Current()) : 0) {
@@ -5039,7 +5041,15 @@ void CodeGenerator::LoadFromSlot(Slot* slot, TypeofState typeof_state) {
     frame()->EmitPush(ecx);
 
   } else if (slot->type() == Slot::PARAMETER) {
-    frame()->PushParameterAt(slot->index());
+    if (!in_inlined_call()) {
+      frame()->PushParameterAt(slot->index());
+    } else if (slot->index() < inlined_argument_count_) {
+      // A parameter of an inlined function is the argument on the frame.
+      int index = inlined_arguments_base_ + slot->index();
+      frame()->PushElementAt(frame()->element_count() - index - 1);
+    } else {
+      frame()->Push(FACTORY->undefined_value());
+    }
 
   } else if (slot->type() == Slot::LOCAL) {
     frame()->PushLocalAt(slot->index());
@@ -5563,11 +5573,17 @@ void CodeGenerator::VisitObjectLiteral(ObjectLiteral* node) {
   frame_->Push(node->constant_properties());
   // Should the object literal have fast elements?
   frame_->Push(Smi::FromInt(node->fast_elements() ? 1 : 0));
+  int properties_count = node->constant_properties()->length() / 2;
   Result clone;
   if (node->depth() > 1) {
     clone = frame_->CallRuntime(Runtime::kCreateObjectLiteral, 4);
-  } else {
+  } else if (!node->fast_elements() ||
+             properties_count >
+                 FastCloneShallowObjectStub::kMaximumClonedProperties) {
     clone = frame_->CallRuntime(Runtime::kCreateObjectLiteralShallow, 4);
+  } else {
+    FastCloneShallowObjectStub stub(properties_count);
+    clone = frame_->CallStub(&stub, 4);
   }
   frame_->Push(&clone);
 
@@ -6032,6 +6048,18 @@ void CodeGenerator::VisitThrow(Throw* node) {
 void CodeGenerator::VisitProperty(Property* node) {
   ASSERT(!in_safe_int32_mode());
   Comment cmnt(masm_, "[ Property");
+  if (node->IsArgumentsReadFromFrame()) {
+    // Read the actual arguments from the frame instead of loading from
+    // an arguments object, which this function never allocates.
+    ZoneList<Expression*>* args = new ZoneList<Expression*>(1);
+    if (node->IsArgumentsLengthReadFromFrame()) {
+      GenerateArgumentsLength(args);
+    } else {
+      args->Add(node->key());
+      GenerateArguments(args);
+    }
+    return;
+  }
   Reference property(this, node);
   property.GetValue();
 }
@@ -6168,15 +6196,29 @@ void CodeGenerator::VisitCall(Call* node) {
       frame_->SpillTop();
     }
 
+    // Use the body of the called function instead of calling it if it is
+    // small enough.  The call IC is used when the global variable has
+    // changed since this code was generated.
+    InlinedCall* inlined = InlinedCall::Analyze(info_, node);
+    JumpTarget slow;
+    JumpTarget done;
+    Result result;
+    if (inlined != NULL) {
+      result = GenerateInlinedCall(node, inlined, &slow);
+      done.Jump(&result);
+      slow.Bind();
+    }
+
     // Push the name of the function onto the frame.
     frame_->Push(var->name());
 
     // Call the IC initialization code.
     CodeForSourcePosition(node->position());
-    Result result = frame_->CallCallIC(RelocInfo::CODE_TARGET_CONTEXT,
-                                       arg_count,
-                                       loop_nesting());
+    result = frame_->CallCallIC(RelocInfo::CODE_TARGET_CONTEXT,
+                                arg_count,
+                                loop_nesting());
     frame_->RestoreContextRegister();
+    if (done.is_linked()) done.Bind(&result);
     frame_->Push(&result);
 
   } else if (var != NULL && var->AsSlot() != NULL &&
@@ -6354,6 +6396,76 @@ void CodeGenerator::VisitCall(Call* node) {
 }
 
 
+Result CodeGenerator::GenerateInlinedCall(Call* node,
+                                          InlinedCall* inlined,
+                                          JumpTarget* slow) {
+  Comment cmnt(masm_, "[ Inlined call");
+  ASSERT(!in_inlined_call());
+  int arg_count = node->arguments()->length();
+  Handle<String> name = node->expression()->AsVariableProxy()->name();
+
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  // Make the real call once break points are set or LiveEdit has been used.
+  __ cmpb(Operand::StaticVariable(
+              ExternalReference(Debug_Address::InlinedCallsDisabled())),
+          0);
+  slow->Branch(not_equal);
+#endif
+
+  // The function is resolved after the arguments have been evaluated.
+  // Load it from the global object and check that it is still a function
+  // with the shared function info of the inlined one.
+  CodeForSourcePosition(node->position());
+  frame_->PushElementAt(arg_count);
+  Result function = EmitNamedLoad(name, true);
+  function.ToRegister();
+  __ test(function.reg(), Immediate(kSmiTagMask));
+  slow->Branch(zero);
+  Result map = allocator()->Allocate();
+  ASSERT(map.is_valid());
+  __ CmpObjectType(function.reg(), JS_FUNCTION_TYPE, map.reg());
+  map.Unuse();
+  slow->Branch(not_equal);
+  __ cmp(FieldOperand(function.reg(), JSFunction::kSharedFunctionInfoOffset),
+         Immediate(inlined->shared()));
+  function.Unuse();
+  slow->Branch(not_equal);
+
+  // Converting an object argument could call valueOf or toString, which
+  // would see the frame of the inlined function missing.
+  if (inlined->needs_number_arguments()) {
+    for (int i = 0; i < arg_count; i++) {
+      frame_->PushElementAt(arg_count - 1 - i);
+      Result arg = frame_->Pop();
+      if (arg.is_constant() && arg.handle()->IsNumber()) continue;
+      arg.ToRegister();
+      NearLabel is_number;
+      __ test(arg.reg(), Immediate(kSmiTagMask));
+      __ j(zero, &is_number);
+      __ cmp(FieldOperand(arg.reg(), HeapObject::kMapOffset),
+             FACTORY->heap_number_map());
+      arg.Unuse();
+      slow->Branch(not_equal);
+      __ bind(&is_number);
+    }
+  }
+
+  // Load the returned expression with the parameters of the inlined
+  // function bound to the arguments on the frame.
+  inlined_arguments_base_ = frame_->element_count() - arg_count;
+  inlined_argument_count_ = arg_count;
+  Load(inlined->result());
+  inlined_arguments_base_ = -1;
+  inlined_argument_count_ = 0;
+
+  // Drop the arguments and the receiver.
+  Result result = frame_->Pop();
+  frame_->Drop(arg_count + 1);
+  __ IncrementCounter(COUNTERS->inlined_calls(), 1);
+  return result;
+}
+
+
 void CodeGenerator::VisitCallNew(CallNew* node) {
   ASSERT(!in_safe_int32_mode());
   Comment cmnt(masm_, "[ CallNew");
@@ -9374,10 +9486,21 @@ class DeferredReferenceGetKeyedValue: public DeferredCode {
 
   virtual void Generate();
 
+  // Registers are saved around the IC call only, so that the external
+  // array case can exit without restoring them.
+  virtual bool AutoSaveAndRestore() { return false; }
+
   Label* patch_site() { return &patch_site_; }
 
+  // Entry for receivers that passed the map check but do not have fast
+  // elements.
+  Label* external_array_label() { return &external_array_; }
+
  private:
+  void GenerateExternalArrayLoad();
+
   Label patch_site_;
+  Label external_array_;
   Register dst_;
   Register receiver_;
   Register key_;
@@ -9385,6 +9508,7 @@ class DeferredReferenceGetKeyedValue: public DeferredCode {
 
 
 void DeferredReferenceGetKeyedValue::Generate() {
+  SaveRegisters();
   if (!receiver_.is(eax)) {
     // Register eax is available for key.
     if (!key_.is(eax)) {
@@ -9425,6 +9549,102 @@ void DeferredReferenceGetKeyedValue::Generate() {
   __ IncrementCounter(COUNTERS->keyed_load_inline_miss(), 1);
 
   if (!dst_.is(eax)) __ mov(dst_, eax);
+  RestoreRegisters();
+  Exit();
+
+  if (external_array_.is_linked()) GenerateExternalArrayLoad();
+}
+
+
+void DeferredReferenceGetKeyedValue::GenerateExternalArrayLoad() {
+  // Only dst_ is clobbered here, and the key is untagged in place only
+  // while indexing.  All bailouts go to the IC call above, which saves the
+  // frame registers itself.
+  __ bind(&external_array_);
+  __ test(key_, Immediate(kSmiTagMask));
+  __ j(not_zero, entry_label());
+  __ mov(dst_, FieldOperand(receiver_, JSObject::kElementsOffset));
+
+  // Dispatch on the map of the elements array.
+  static const int kTypeCount = kExternalFloatArray - kExternalByteArray + 1;
+  Label elements_of_type[kTypeCount];
+  for (int i = 0; i < kTypeCount; i++) {
+    ExternalArrayType type = static_cast<ExternalArrayType>(
+        kExternalByteArray + i);
+    Handle<Map> map(HEAP->MapForExternalArrayType(type));
+    __ cmp(FieldOperand(dst_, HeapObject::kMapOffset), Immediate(map));
+    __ j(equal, &elements_of_type[i]);
+  }
+  __ jmp(entry_label());
+
+  Label out_of_range, failed_allocation, done;
+  for (int i = 0; i < kTypeCount; i++) {
+    ExternalArrayType type = static_cast<ExternalArrayType>(
+        kExternalByteArray + i);
+    __ bind(&elements_of_type[i]);
+    __ SmiUntag(key_);
+    __ cmp(key_, FieldOperand(dst_, ExternalArray::kLengthOffset));
+    // Unsigned comparison catches both negative and too-large values.
+    __ j(above_equal, &out_of_range);
+    __ mov(dst_, FieldOperand(dst_, ExternalArray::kExternalPointerOffset));
+    switch (type) {
+      case kExternalByteArray:
+        __ movsx_b(dst_, Operand(dst_, key_, times_1, 0));
+        break;
+      case kExternalUnsignedByteArray:
+        __ movzx_b(dst_, Operand(dst_, key_, times_1, 0));
+        break;
+      case kExternalShortArray:
+        __ movsx_w(dst_, Operand(dst_, key_, times_2, 0));
+        break;
+      case kExternalUnsignedShortArray:
+        __ movzx_w(dst_, Operand(dst_, key_, times_2, 0));
+        break;
+      case kExternalIntArray:
+      case kExternalUnsignedIntArray:
+        __ mov(dst_, Operand(dst_, key_, times_4, 0));
+        break;
+      case kExternalFloatArray:
+        __ fld_s(Operand(dst_, key_, times_4, 0));
+        break;
+      default:
+        UNREACHABLE();
+        break;
+    }
+    __ SmiTag(key_);
+
+    if (type == kExternalFloatArray) {
+      __ AllocateHeapNumber(dst_, no_reg, no_reg, &failed_allocation);
+      __ fstp_d(FieldOperand(dst_, HeapNumber::kValueOffset));
+      __ jmp(&done);
+      continue;
+    }
+    // Integers that do not fit in a smi are boxed by the IC.
+    if (type == kExternalIntArray) {
+      __ cmp(dst_, 0xC0000000);
+      __ j(sign, entry_label());
+    } else if (type == kExternalUnsignedIntArray) {
+      __ test(dst_, Immediate(0xC0000000));
+      __ j(not_zero, entry_label());
+    }
+    __ SmiTag(dst_);
+    __ jmp(&done);
+  }
+
+  __ bind(&out_of_range);
+  __ SmiTag(key_);
+  __ jmp(entry_label());
+
+  // If we fail allocation of the HeapNumber, we still have a value on
+  // top of the FPU stack. Remove it.
+  __ bind(&failed_allocation);
+  __ ffree();
+  __ fincstp();
+  __ jmp(entry_label());
+
+  __ bind(&done);
+  __ IncrementCounter(COUNTERS->keyed_load_external_array_inline(), 1);
+  Exit();
 }
 
 
@@ -9433,31 +9653,50 @@ class DeferredReferenceSetKeyedValue: public DeferredCode {
   DeferredReferenceSetKeyedValue(Register value,
                                  Register key,
                                  Register receiver,
-                                 Register scratch)
+                                 Register scratch,
+                                 Register scratch2)
       : value_(value),
         key_(key),
         receiver_(receiver),
-        scratch_(scratch) {
+        scratch_(scratch),
+        scratch2_(scratch2) {
     set_comment("[ DeferredReferenceSetKeyedValue");
   }
 
   virtual void Generate();
 
+  // Registers are saved around the IC call only, so that the external
+  // array case can exit without restoring them.
+  virtual bool AutoSaveAndRestore() { return false; }
+
   Label* patch_site() { return &patch_site_; }
 
+  // Entry for receivers whose elements failed the fixed array map check,
+  // with the map checked against in scratch2.
+  Label* external_array_label() { return &external_array_; }
+
  private:
+  void GenerateExternalArrayStore(Register value,
+                                  Register key,
+                                  Register receiver);
+
   Register value_;
   Register key_;
   Register receiver_;
   Register scratch_;
+  Register scratch2_;
   Label patch_site_;
+  Label external_array_;
 };
 
 
 void DeferredReferenceSetKeyedValue::Generate() {
+  SaveRegisters();
   __ IncrementCounter(COUNTERS->keyed_store_inline_miss(), 1);
   // Move value_ to eax, key_ to ecx, and receiver_ to edx.
   Register old_value = value_;
+  Register old_key = key_;
+  Register old_receiver = receiver_;
 
   // First, move value to eax.
   if (!value_.is(eax)) {
@@ -9523,6 +9762,130 @@ void DeferredReferenceSetKeyedValue::Generate() {
   masm_->test(eax, Immediate(-delta_to_patch_site));
   // Restore value (returned from store IC) register.
   if (!old_value.is(eax)) __ mov(old_value, eax);
+  RestoreRegisters();
+  Exit();
+
+  if (external_array_.is_linked()) {
+    GenerateExternalArrayStore(old_value, old_key, old_receiver);
+  }
+}
+
+
+void DeferredReferenceSetKeyedValue::GenerateExternalArrayStore(
+    Register value,
+    Register key,
+    Register receiver) {
+  // The receiver is a heap object and the key a smi.  Only the scratch
+  // registers are clobbered here.  All bailouts go to the IC call above.
+  // Byte stores need a byte register for the value.
+  Register element_value = scratch_.is_byte_register() ? scratch_ : scratch2_;
+  Register elements = element_value.is(scratch_) ? scratch2_ : scratch_;
+  ASSERT(element_value.is_byte_register());
+
+  __ bind(&external_array_);
+  // A cleared inline cache has replaced the fixed array map, so that all
+  // stores go through the IC call.
+  __ cmp(scratch2_, FACTORY->fixed_array_map());
+  __ j(not_equal, entry_label());
+  __ mov(elements, FieldOperand(receiver, HeapObject::kMapOffset));
+  // Nothing but the receiver type is checked, so objects requiring access
+  // checks must go through the IC.
+  __ test_b(FieldOperand(elements, Map::kBitFieldOffset),
+            1 << Map::kIsAccessCheckNeeded);
+  __ j(not_zero, entry_label());
+  __ CmpInstanceType(elements, JS_OBJECT_TYPE);
+  __ j(not_equal, entry_label());
+  __ mov(elements, FieldOperand(receiver, JSObject::kElementsOffset));
+
+  // Dispatch on the map of the elements array.  Signed and unsigned
+  // elements of the same size are stored the same way.
+  Label byte_elements, short_elements, int_elements, float_elements;
+  static const int kTypeCount = kExternalFloatArray - kExternalByteArray + 1;
+  for (int i = 0; i < kTypeCount; i++) {
+    ExternalArrayType type = static_cast<ExternalArrayType>(
+        kExternalByteArray + i);
+    Label* target = NULL;
+    switch (type) {
+      case kExternalByteArray:
+      case kExternalUnsignedByteArray:
+        target = &byte_elements;
+        break;
+      case kExternalShortArray:
+      case kExternalUnsignedShortArray:
+        target = &short_elements;
+        break;
+      case kExternalIntArray:
+      case kExternalUnsignedIntArray:
+        target = &int_elements;
+        break;
+      case kExternalFloatArray:
+        target = &float_elements;
+        break;
+      default:
+        UNREACHABLE();
+        break;
+    }
+    Handle<Map> map(HEAP->MapForExternalArrayType(type));
+    __ cmp(FieldOperand(elements, HeapObject::kMapOffset), Immediate(map));
+    __ j(equal, target);
+  }
+  __ jmp(entry_label());
+
+  Label done;
+  Label* element_labels[] = {
+    &byte_elements, &short_elements, &int_elements, &float_elements
+  };
+  ScaleFactor scales[] = { times_1, times_2, times_4, times_4 };
+  for (int i = 0; i < 4; i++) {
+    Label* element_label = element_labels[i];
+    bool is_float = element_label == &float_elements;
+    __ bind(element_label);
+    __ mov(element_value, key);
+    __ SmiUntag(element_value);
+    __ cmp(element_value, FieldOperand(elements, ExternalArray::kLengthOffset));
+    // Unsigned comparison catches both negative and too-large values.
+    __ j(above_equal, entry_label());
+    __ mov(elements,
+           FieldOperand(elements, ExternalArray::kExternalPointerOffset));
+    // Compute the address of the element.
+    __ lea(elements, Operand(elements, element_value, scales[i], 0));
+    Operand element(elements, 0);
+
+    // Smis are stored into all types of elements, heap numbers only into
+    // float elements.  Other values are converted by the IC.
+    Label heap_number;
+    __ test(value, Immediate(kSmiTagMask));
+    __ j(not_zero, is_float ? &heap_number : entry_label());
+    __ mov(element_value, value);
+    __ SmiUntag(element_value);
+    if (is_float) {
+      __ push(element_value);
+      __ fild_s(Operand(esp, 0));
+      __ pop(element_value);
+      __ fstp_s(element);
+    } else if (scales[i] == times_1) {
+      __ mov_b(element, element_value);
+    } else if (scales[i] == times_2) {
+      __ mov_w(element, element_value);
+    } else {
+      __ mov(element, element_value);
+    }
+    __ jmp(&done);
+
+    if (is_float) {
+      __ bind(&heap_number);
+      __ cmp(FieldOperand(value, HeapObject::kMapOffset),
+             Immediate(FACTORY->heap_number_map()));
+      __ j(not_equal, entry_label());
+      __ fld_d(FieldOperand(value, HeapNumber::kValueOffset));
+      __ fstp_s(element);
+      __ jmp(&done);
+    }
+  }
+
+  __ bind(&done);
+  __ IncrementCounter(COUNTERS->keyed_store_external_array_inline(), 1);
+  Exit();
 }
 
 
@@ -9794,6 +10157,14 @@ Result CodeGenerator::EmitKeyedLoad() {
                Immediate(FACTORY->null_value()));
     deferred->Branch(not_equal);
 
+    // The map is also patched in for receivers with external array
+    // elements.  Those are handled out of line.
+    __ mov(elements.reg(),
+           FieldOperand(receiver.reg(), HeapObject::kMapOffset));
+    __ test_b(FieldOperand(elements.reg(), Map::kBitField2Offset),
+              1 << Map::kHasFastElements);
+    __ j(zero, deferred->external_array_label());
+
     // Check that the key is a smi.
     if (!key.is_smi()) {
       __ test(key.reg(), Immediate(kSmiTagMask));
@@ -9874,7 +10245,8 @@ Result CodeGenerator::EmitKeyedStore(StaticType* key_type) {
         new DeferredReferenceSetKeyedValue(result.reg(),
                                            key.reg(),
                                            receiver.reg(),
-                                           tmp.reg());
+                                           tmp.reg(),
+                                           tmp2.reg());
 
     // Check that the receiver is not a smi.
     __ test(receiver.reg(), Immediate(kSmiTagMask));
@@ -9888,21 +10260,32 @@ Result CodeGenerator::EmitKeyedStore(StaticType* key_type) {
       if (FLAG_debug_code) __ AbortIfNotSmi(key.reg());
     }
 
-    // Check that the receiver is a JSArray.
-    __ CmpObjectType(receiver.reg(), JS_ARRAY_TYPE, tmp.reg());
-    deferred->Branch(not_equal);
+    // Check that the receiver is a JSObject and get its elements array.
+    __ CmpObjectType(receiver.reg(), FIRST_JS_OBJECT_TYPE, tmp.reg());
+    deferred->Branch(below);
+    __ mov(tmp.reg(),
+           FieldOperand(receiver.reg(), JSObject::kElementsOffset));
 
-    // Check that the key is within bounds.  Both the key and the length of
-    // the JSArray are smis. Use unsigned comparison to handle negative keys.
+    // Bind the deferred code patch site to be able to locate the fixed
+    // array map comparison.  When debugging, we patch this comparison to
+    // always fail so that we will hit the IC call in the deferred code
+    // which will allow the debugger to break for fast case stores.  The
+    // map is loaded into tmp2 so that the external array case, which is
+    // handled out of line, can tell whether the check has been disabled.
+    __ bind(deferred->patch_site());
+    masm()->mov(tmp2.reg(), Immediate(FACTORY->fixed_array_map()));
+    __ cmp(tmp2.reg(), FieldOperand(tmp.reg(), HeapObject::kMapOffset));
+    __ j(not_equal, deferred->external_array_label());
+
+    // Check that the receiver is a JSArray and that the key is within
+    // bounds.  Both the key and the length of the JSArray are smis.  Use
+    // unsigned comparison to handle negative keys.
+    __ CmpObjectType(receiver.reg(), JS_ARRAY_TYPE, tmp2.reg());
+    deferred->Branch(not_equal);
     __ cmp(key.reg(),
            FieldOperand(receiver.reg(), JSArray::kLengthOffset));
     deferred->Branch(above_equal);
 
-    // Get the elements array from the receiver and check that it is not a
-    // dictionary.
-    __ mov(tmp.reg(),
-           FieldOperand(receiver.reg(), JSArray::kElementsOffset));
-
     // Check whether it is possible to omit the write barrier. If the elements
     // array is in new space or the value written is a smi we can safely update
     // the elements array without write barrier.
@@ -9914,15 +10297,6 @@ Result CodeGenerator::EmitKeyedStore(StaticType* key_type) {
     }
 
     __ bind(&in_new_space);
-    // Bind the deferred code patch site to be able to locate the fixed
-    // array map comparison.  When debugging, we patch this comparison to
-    // always fail so that we will hit the IC call in the deferred code
-    // which will allow the debugger to break for fast case stores.
-    __ bind(deferred->patch_site());
-    __ cmp(FieldOperand(tmp.reg(), HeapObject::kMapOffset),
-           Immediate(FACTORY->fixed_array_map()));
-    deferred->Branch(not_equal);
-
     // Store the value.
     __ mov(FixedArrayElementOperand(tmp.reg(), key.reg()), result.reg());
     __ IncrementCounter(COUNTERS->keyed_store_inline(), 1);
@@ -9968,9 +10342,11 @@ void Reference::GetValue() {
   ASSERT(!is_illegal());
   MacroAssembler* masm = cgen_->masm();
 
-  // Record the source position for the property load.
+  // Record the source position for the property load.  Positions in the
+  // body of an inlined function belong to another function, so its code
+  // keeps the position of the call.
   Property* property = expression_->AsProperty();
-  if (property != NULL) {
+  if (property != NULL && !cgen_->in_inlined_call()) {
     cgen_->CodeForSourcePosition(property->position());
   }
 
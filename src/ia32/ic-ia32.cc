@@ -117,8 +117,8 @@ static void GenerateStringDictionaryProbes(MacroAssembler* masm,
   __ dec(r1);
 
   // Generate an unrolled loop that performs a few probes before
-  // giving up. Measurements done on Gmail indicate that 2 probes
-  // cover ~93% of loads from dictionaries.
+  // falling back to a probing loop. Measurements done on Gmail indicate
+  // that 2 probes cover ~93% of loads from dictionaries.
   static const int kProbes = 4;
   const int kElementsStartOffset =
       StringDictionary::kHeaderSize +
@@ -136,15 +136,49 @@ static void GenerateStringDictionaryProbes(MacroAssembler* masm,
     ASSERT(StringDictionary::kEntrySize == 3);
     __ lea(r0, Operand(r0, r0, times_2, 0));  // r0 = r0 * 3
 
-    // Check if the key is identical to the name.
+    // Check if the key is identical to the name.  An undefined key ends
+    // the probe sequence.
     __ cmp(name, Operand(elements, r0, times_4,
                          kElementsStartOffset - kHeapObjectTag));
-    if (i != kProbes - 1) {
-      __ j(equal, done, taken);
-    } else {
-      __ j(not_equal, miss, not_taken);
-    }
+    __ j(equal, done, taken);
+    __ cmp(Operand(elements, r0, times_4,
+                   kElementsStartOffset - kHeapObjectTag),
+           Immediate(FACTORY->undefined_value()));
+    __ j(equal, miss, not_taken);
   }
+
+  // Keep probing until the name or an undefined key is found, as the
+  // lookup in the runtime does.  There are no registers left for the
+  // probe number, so it is kept on the stack.
+  Label loop, found;
+  __ push(Immediate(kProbes));
+  __ bind(&loop);
+  __ mov(r0, Operand(esp, 0));
+  __ inc(Operand(esp, 0));
+  __ mov(r1, r0);
+  __ imul(r1, Operand(r0));
+  __ add(r1, Operand(r0));
+  __ shr(r1, 1);  // r1 = (i + i * i) / 2
+  __ mov(r0, FieldOperand(name, String::kHashFieldOffset));
+  __ shr(r0, String::kHashShift);
+  __ add(r0, Operand(r1));
+  __ mov(r1, FieldOperand(elements, kCapacityOffset));
+  __ shr(r1, kSmiTagSize);  // convert smi to int
+  __ dec(r1);
+  __ and_(r0, Operand(r1));
+  __ lea(r0, Operand(r0, r0, times_2, 0));  // r0 = r0 * 3
+  __ cmp(name, Operand(elements, r0, times_4,
+                       kElementsStartOffset - kHeapObjectTag));
+  __ j(equal, &found);
+  __ cmp(Operand(elements, r0, times_4,
+                 kElementsStartOffset - kHeapObjectTag),
+         Immediate(FACTORY->undefined_value()));
+  __ j(not_equal, &loop);
+  __ add(Operand(esp), Immediate(kPointerSize));
+  __ jmp(miss);
+  __ bind(&found);
+  __ add(Operand(esp), Immediate(kPointerSize));
+  __ jmp(done);
 }
 
 
@@ -525,7 +559,8 @@ void KeyedLoadIC::GenerateGeneric(MacroAssembler* masm) {
   //  -- esp[0] : return address
   // -----------------------------------
   Label slow, check_string, index_smi, index_string, property_array_property;
-  Label check_pixel_array, probe_dictionary, check_number_dictionary;
+  Label check_pixel_array, check_double_array, probe_dictionary;
+  Label check_number_dictionary;
 
   // Check that the key is a smi.
   __ test(eax, Immediate(kSmiTagMask));
@@ -560,7 +595,7 @@ void KeyedLoadIC::GenerateGeneric(MacroAssembler* masm) {
   __ mov(ecx, FieldOperand(edx, JSObject::kElementsOffset));
   __ mov(ebx, eax);
   __ SmiUntag(ebx);
-  __ CheckMap(ecx, FACTORY->pixel_array_map(), &check_number_dictionary, true);
+  __ CheckMap(ecx, FACTORY->pixel_array_map(), &check_double_array, true);
   __ cmp(ebx, FieldOperand(ecx, PixelArray::kLengthOffset));
   __ j(above_equal, &slow);
   __ mov(eax, FieldOperand(ecx, PixelArray::kExternalPointerOffset));
@@ -568,6 +603,32 @@ void KeyedLoadIC::GenerateGeneric(MacroAssembler* masm) {
   __ SmiTag(eax);
   __ ret(0);
 
+  __ bind(&check_double_array);
+  // Check whether the elements is an array of unboxed doubles.
+  // edx: receiver
+  // ebx: untagged index
+  // eax: key
+  // ecx: elements
+  __ CheckMap(ecx,
+              FACTORY->fixed_double_array_map(),
+              &check_number_dictionary,
+              true);
+  __ cmp(eax, FieldOperand(ecx, FixedDoubleArray::kLengthOffset));
+  __ j(above_equal, &slow);
+  // Holes are looked up in the prototype chain by the runtime.
+  __ cmp(FieldOperand(ecx, ebx, times_8,
+                      FixedDoubleArray::kHeaderSize + kIntSize),
+         Immediate(FixedDoubleArray::kHoleNanUpper32));
+  __ j(equal, &slow);
+  __ lea(ecx, FieldOperand(ecx, ebx, times_8, FixedDoubleArray::kHeaderSize));
+  __ AllocateHeapNumber(edi, ebx, no_reg, &slow);
+  __ mov(ebx, Operand(ecx, 0));
+  __ mov(FieldOperand(edi, HeapNumber::kValueOffset), ebx);
+  __ mov(ebx, Operand(ecx, kIntSize));
+  __ mov(FieldOperand(edi, HeapNumber::kValueOffset + kIntSize), ebx);
+  __ mov(eax, edi);
+  __ ret(0);
+
   __ bind(&check_number_dictionary);
   // Check whether the elements is a number dictionary.
   // edx: receiver
@@ -921,7 +982,7 @@ void KeyedStoreIC::GenerateGeneric(MacroAssembler* masm) {
   //  -- edx    : receiver
   //  -- esp[0] : return address
   // -----------------------------------
-  Label slow, fast, array, extra, check_pixel_array;
+  Label slow, fast, array, extra, check_pixel_array, double_array;
 
   // Check that the object isn't a smi.
   __ test(edx, Immediate(kSmiTagMask));
@@ -1010,7 +1071,7 @@ void KeyedStoreIC::GenerateGeneric(MacroAssembler* masm) {
   // edx: receiver, a JSArray
   // ecx: key, a smi.
   __ mov(edi, FieldOperand(edx, JSObject::kElementsOffset));
-  __ CheckMap(edi, FACTORY->fixed_array_map(), &check_pixel_array, true);
+  __ CheckMap(edi, FACTORY->fixed_array_map(), &double_array, true);
 
   // Check the key against the length in the array, compute the
   // address to store into and fall through to fast case.
@@ -1028,6 +1089,43 @@ void KeyedStoreIC::GenerateGeneric(MacroAssembler* masm) {
   __ mov(edx, Operand(eax));
   __ RecordWrite(edi, 0, edx, ecx);
   __ ret(0);
+
+  // Array of unboxed doubles case: store a number within the length of
+  // the array.  Other values and stores that grow the array go to the
+  // runtime.
+  __ bind(&double_array);
+  // eax: value
+  // ecx: key (a smi)
+  // edx: receiver, a JSArray
+  // edi: receiver->elements
+  __ CheckMap(edi, FACTORY->fixed_double_array_map(), &check_pixel_array, true);
+  __ cmp(ecx, FieldOperand(edx, JSArray::kLengthOffset));  // Compare smis.
+  __ j(above_equal, &slow, not_taken);
+  Label non_smi_double_value;
+  __ test(eax, Immediate(kSmiTagMask));
+  __ j(not_zero, &non_smi_double_value);
+  __ mov(ebx, eax);
+  __ SmiUntag(ebx);
+  __ push(ebx);
+  __ fild_s(Operand(esp, 0));
+  __ pop(ebx);
+  __ fstp_d(FieldOperand(edi, ecx, times_4, FixedDoubleArray::kHeaderSize));
+  __ ret(0);  // Return value in eax.
+  __ bind(&non_smi_double_value);
+  __ CheckMap(eax, FACTORY->heap_number_map(), &slow, true);
+  // The runtime canonicalizes NaNs so they cannot be taken for the hole.
+  // Infinities share their exponent and take the same path.
+  __ mov(ebx, FieldOperand(eax, HeapNumber::kExponentOffset));
+  __ and_(ebx, HeapNumber::kExponentMask);
+  __ cmp(ebx, HeapNumber::kExponentMask);
+  __ j(equal, &slow);
+  __ mov(ebx, FieldOperand(eax, HeapNumber::kValueOffset));
+  __ mov(FieldOperand(edi, ecx, times_4, FixedDoubleArray::kHeaderSize), ebx);
+  __ mov(ebx, FieldOperand(eax, HeapNumber::kValueOffset + kIntSize));
+  __ mov(FieldOperand(edi, ecx, times_4,
+                      FixedDoubleArray::kHeaderSize + kIntSize),
+         ebx);
+  __ ret(0);  // Return value in eax.
 }
 
 
@@ -1761,7 +1859,7 @@ bool StoreIC::PatchInlinedStore(Address address, Object* map, int offset) {
 }
 
 
-static bool PatchInlinedMapCheck(Address address, Object* map) {
+static bool PatchInlinedMapCheck(Address address, Object* map, int map_offset) {
   Address test_instruction_address =
       address + Assembler::kCallTargetAddressOffset;
   // The keyed load has a fast inlined case if the IC call instruction
@@ -1773,10 +1871,9 @@ static bool PatchInlinedMapCheck(Address address, Object* map) {
   // byte test instruction.
   Address delta_address = test_instruction_address + 1;
   int delta = *reinterpret_cast<int*>(delta_address);
-  // Compute the map address.  The map address is in the last 4 bytes
-  // of the 7-byte operand-immediate compare instruction, so we add 3
-  // to the offset to get the map address.
-  Address map_address = test_instruction_address + delta + 3;
+  // Compute the map address from the offset of the 32-bit immediate in
+  // that instruction.
+  Address map_address = test_instruction_address + delta + map_offset;
   // Patch the map check.
   *(reinterpret_cast<Object**>(map_address)) = map;
   return true;
@@ -1784,12 +1881,16 @@ static bool PatchInlinedMapCheck(Address address, Object* map) {
 
 
 bool KeyedLoadIC::PatchInlinedLoad(Address address, Object* map) {
-  return PatchInlinedMapCheck(address, map);
+  // The map is in the last 4 bytes of the 7-byte operand-immediate compare
+  // instruction.
+  return PatchInlinedMapCheck(address, map, 3);
 }
 
 
 bool KeyedStoreIC::PatchInlinedStore(Address address, Object* map) {
-  return PatchInlinedMapCheck(address, map);
+  // The map is in the last 4 bytes of the 5-byte register-immediate move
+  // instruction.
+  return PatchInlinedMapCheck(address, map, 1);
 }
 
 
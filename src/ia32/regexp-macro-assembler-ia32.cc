@@ -124,6 +124,7 @@ RegExpMacroAssemblerIA32::~RegExpMacroAssemblerIA32() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -150,6 +151,11 @@ void RegExpMacroAssemblerIA32::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerIA32::Backtrack() {
   CheckPreemption();
+  if (backtrack_limit() > 0) {
+    __ inc(Operand(ebp, kBacktrackCount));
+    __ cmp(Operand(ebp, kBacktrackCount), Immediate(backtrack_limit()));
+    __ j(equal, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(ebx);
   __ add(Operand(ebx), Immediate(masm_->CodeObject()));
@@ -675,6 +681,7 @@ Handle<Object> RegExpMacroAssemblerIA32::GetCode(Handle<String> source) {
   __ push(edi);
   __ push(ebx);  // Callee-save on MacOS.
   __ push(Immediate(0));  // Make room for "input start - 1" constant.
+  __ push(Immediate(0));  // Backtrack counter.
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -867,6 +874,14 @@ Handle<Object> RegExpMacroAssemblerIA32::GetCode(Handle<String> source) {
     __ jmp(&exit_label_);
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    // Exit with Result BACKTRACK_LIMIT(-3) to have the caller match with
+    // RegExpNfa.
+    __ bind(&backtrack_limit_label_);
+    __ mov(eax, BACKTRACK_LIMIT);
+    __ jmp(&exit_label_);
+  }
+
   CodeDesc code_desc;
   masm_->GetCode(&code_desc);
   Handle<Code> code = FACTORY->NewCode(code_desc,
@@ -1091,11 +1106,12 @@ int RegExpMacroAssemblerIA32::CheckStackGuardState(Address* return_address,
   }
 
   // Otherwise, the content of the string might have moved. It must still
-  // be a sequential or external string with the same content.
+  // be a sequential, external or sliced string with the same content.
   // Update the start and end pointers in the stack frame to the current
   // location (whether it has actually moved or not).
   ASSERT(StringShape(*subject).IsSequential() ||
-      StringShape(*subject).IsExternal());
+      StringShape(*subject).IsExternal() ||
+      StringShape(*subject).IsSliced());
 
   // The original start address of the characters to match.
   const byte* start_address = frame_entry<const byte*>(re_frame, kInputStart);
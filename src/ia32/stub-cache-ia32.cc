@@ -48,6 +48,9 @@ static void ProbeTable(Isolate* isolate,
                        Register extra) {
   ExternalReference key_offset(isolate->stub_cache()->key_reference(table));
   ExternalReference value_offset(isolate->stub_cache()->value_reference(table));
+  StatsCounter* hit_counter = table == StubCache::kPrimary
+      ? COUNTERS->megamorphic_stub_cache_primary_hits()
+      : COUNTERS->megamorphic_stub_cache_secondary_hits();
 
   Label miss;
 
@@ -65,6 +68,8 @@ static void ProbeTable(Isolate* isolate,
     __ cmp(offset, flags);
     __ j(not_equal, &miss);
 
+    __ IncrementCounter(hit_counter, 1);
+
     // Jump to the first instruction in the code stub.
     __ add(Operand(extra), Immediate(Code::kHeaderSize - kHeapObjectTag));
     __ jmp(Operand(extra));
@@ -91,6 +96,8 @@ static void ProbeTable(Isolate* isolate,
     __ pop(offset);
     __ mov(offset, Operand::StaticArray(offset, times_2, value_offset));
 
+    __ IncrementCounter(hit_counter, 1);
+
     // Jump to the first instruction in the code stub.
     __ add(Operand(offset), Immediate(Code::kHeaderSize - kHeapObjectTag));
     __ jmp(Operand(offset));
@@ -231,15 +238,21 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   ASSERT(!scratch.is(no_reg));
   ASSERT(extra2.is(no_reg));
 
+  __ IncrementCounter(COUNTERS->megamorphic_stub_cache_probes(), 1);
+
   // Check that the receiver isn't a smi.
   __ test(receiver, Immediate(kSmiTagMask));
   __ j(zero, &miss, not_taken);
 
+  StubCache* stub_cache = isolate->stub_cache();
+  ExternalReference primary_mask(stub_cache->mask_reference(kPrimary));
+  ExternalReference secondary_mask(stub_cache->mask_reference(kSecondary));
+
   // Get the map of the receiver and compute the hash.
   __ mov(scratch, FieldOperand(name, String::kHashFieldOffset));
   __ add(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, flags);
-  __ and_(scratch, (kPrimaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(primary_mask));
 
   // Probe the primary table.
   ProbeTable(isolate, masm, flags, kPrimary, name, scratch, extra);
@@ -248,10 +261,10 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ mov(scratch, FieldOperand(name, String::kHashFieldOffset));
   __ add(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, flags);
-  __ and_(scratch, (kPrimaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(primary_mask));
   __ sub(scratch, Operand(name));
   __ add(Operand(scratch), Immediate(flags));
-  __ and_(scratch, (kSecondaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(secondary_mask));
 
   // Probe the secondary table.
   ProbeTable(isolate, masm, flags, kSecondary, name, scratch, extra);
@@ -259,6 +272,7 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(COUNTERS->megamorphic_stub_cache_misses(), 1);
 }
 
 
@@ -453,12 +467,15 @@ static void FreeSpaceForFastApiCall(MacroAssembler* masm, Register scratch) {
 }
 
 
-// Generates call to API function.
+// Generates call to API function.  The function is passed in edi rather
+// than embedded in the code, so that the global call stub can call any
+// closure of the api function that it found in the property cell.
 static bool GenerateFastApiCall(MacroAssembler* masm,
                                 const CallOptimization& optimization,
                                 int argc,
                                 Failure** failure) {
   // ----------- S t a t e -------------
+  //  -- edi                 : api function
   //  -- esp[0]              : return address
   //  -- esp[4]              : object passing the type check
   //                           (last fast api call extra argument,
@@ -471,9 +488,7 @@ static bool GenerateFastApiCall(MacroAssembler* masm,
   //  -- esp[(argc + 3) * 4] : first argument
   //  -- esp[(argc + 4) * 4] : receiver
   // -----------------------------------
-  // Get the function and setup the context.
-  JSFunction* function = optimization.constant_function();
-  __ mov(edi, Immediate(Handle<JSFunction>(function)));
+  // Setup the context.
   __ mov(esi, FieldOperand(edi, JSFunction::kContextOffset));
 
   // Pass the additional arguments.
@@ -515,6 +530,10 @@ static bool GenerateFastApiCall(MacroAssembler* masm,
   __ lea(eax, ApiParameterOperand(1));
   __ mov(ApiParameterOperand(0), eax);
 
+  // The callback returns a v8::Handle<Value>, so it needs an open handle
+  // scope to allocate its result in.  The scope is entered and left inline
+  // by bumping the isolate's handle scope data; returning the value
+  // without a handle would need a different InvocationCallback signature.
   // Emitting a stub call may try to allocate (if the code is not
   // already generated).  Do not allow the assembler to perform a
   // garbage collection but instead return the allocation failure
@@ -659,6 +678,8 @@ class CallInterceptorCompiler BASE_EMBEDDED {
 
     // Invoke function.
     if (can_do_fast_api_call) {
+      __ mov(edi, Immediate(Handle<JSFunction>(
+          optimization.constant_function())));
       bool success = GenerateFastApiCall(masm, optimization,
                                          arguments_.immediate(), failure);
       if (!success) {
@@ -1055,6 +1076,62 @@ void StubCompiler::GenerateLoadField(JSObject* object,
 }
 
 
+void StubCompiler::GenerateLoadInternalField(JSObject* holder,
+                                             Register holder_reg,
+                                             Register scratch1,
+                                             Register scratch2,
+                                             Register scratch3,
+                                             AccessorInfo* callback,
+                                             Label* miss) {
+  // The receiver and name registers are still needed on a miss, so the
+  // result is only moved to eax at the end.
+  int index = callback->internal_field_index();
+  __ mov(scratch2,
+         FieldOperand(holder_reg,
+                      holder->GetHeaderSize() + index * kPointerSize));
+  v8::InternalFieldAccessorType type = callback->internal_field_type();
+  if (type == v8::INTERNAL_FIELD_VALUE) {
+    __ mov(eax, scratch2);
+    __ ret(0);
+    return;
+  }
+
+  // Get the pointer stored in the field.  Aligned pointers are stored as
+  // smis, others in a proxy.  Leave NULL and fields holding anything else
+  // to the getter.
+  Label not_smi, pointer_loaded;
+  __ test(scratch2, Immediate(kSmiTagMask));
+  __ j(not_zero, &not_smi);
+  __ test(scratch2, Operand(scratch2));
+  __ j(zero, miss, not_taken);
+  __ jmp(&pointer_loaded);
+  __ bind(&not_smi);
+  __ CmpObjectType(scratch2, PROXY_TYPE, scratch3);
+  __ j(not_equal, miss, not_taken);
+  __ mov(scratch2, FieldOperand(scratch2, Proxy::kProxyOffset));
+  __ bind(&pointer_loaded);
+
+  int offset = callback->internal_field_offset();
+  if (type == v8::INTERNAL_FIELD_INT32) {
+    __ mov(scratch3, Operand(scratch2, offset));
+    // Values outside the smi range are left to the getter.
+    __ SmiTag(scratch3);
+    __ j(overflow, miss, not_taken);
+    __ mov(eax, scratch3);
+  } else {
+    ASSERT(type == v8::INTERNAL_FIELD_DOUBLE);
+    __ AllocateHeapNumber(scratch1, scratch3, no_reg, miss);
+    __ mov(scratch3, Operand(scratch2, offset));
+    __ mov(FieldOperand(scratch1, HeapNumber::kValueOffset), scratch3);
+    __ mov(scratch3, Operand(scratch2, offset + kPointerSize));
+    __ mov(FieldOperand(scratch1, HeapNumber::kValueOffset + kPointerSize),
+           scratch3);
+    __ mov(eax, scratch1);
+  }
+  __ ret(0);
+}
+
+
 bool StubCompiler::GenerateLoadCallback(JSObject* object,
                                         JSObject* holder,
                                         Register receiver,
@@ -1075,6 +1152,13 @@ bool StubCompiler::GenerateLoadCallback(JSObject* object,
       CheckPrototypes(object, receiver, holder, scratch1,
                       scratch2, scratch3, name, miss);
 
+  if (callback->is_internal_field_accessor() &&
+      callback->internal_field_index() < holder->GetInternalFieldCount()) {
+    GenerateLoadInternalField(holder, reg, scratch1, scratch2, scratch3,
+                              callback, miss);
+    return true;
+  }
+
   Handle<AccessorInfo> callback_handle(callback);
 
   // Insert additional parameters into the stack frame above return address.
@@ -1461,7 +1545,7 @@ MaybeObject* CallStubCompiler::CompileArrayPushCall(Object* object,
     __ mov(eax, FieldOperand(edx, JSArray::kLengthOffset));
     __ ret((argc + 1) * kPointerSize);
   } else {
-    Label call_builtin;
+    Label call_builtin, double_elements;
 
     // Get the elements array of the object.
     __ mov(ebx, FieldOperand(edx, JSArray::kElementsOffset));
@@ -1469,7 +1553,7 @@ MaybeObject* CallStubCompiler::CompileArrayPushCall(Object* object,
     // Check that the elements are in fast mode and writable.
     __ cmp(FieldOperand(ebx, HeapObject::kMapOffset),
            Immediate(FACTORY->fixed_array_map()));
-    __ j(not_equal, &call_builtin);
+    __ j(not_equal, argc == 1 ? &double_elements : &call_builtin);
 
     if (argc == 1) {  // Otherwise fall through to call builtin.
       Label exit, with_write_barrier, attempt_to_grow_elements;
@@ -1557,6 +1641,49 @@ MaybeObject* CallStubCompiler::CompileArrayPushCall(Object* object,
 
       // Elements are in new space, so write barrier is not required.
       __ ret((argc + 1) * kPointerSize);
+
+      // Push a number onto an array of unboxed doubles with spare capacity.
+      // Growing the elements is left to the builtin.
+      __ bind(&double_elements);
+      __ cmp(FieldOperand(ebx, HeapObject::kMapOffset),
+             Immediate(FACTORY->fixed_double_array_map()));
+      __ j(not_equal, &call_builtin);
+      __ mov(eax, FieldOperand(edx, JSArray::kLengthOffset));
+      __ cmp(eax, FieldOperand(ebx, FixedDoubleArray::kLengthOffset));
+      __ j(above_equal, &call_builtin);
+
+      Label not_smi;
+      __ mov(ecx, Operand(esp, argc * kPointerSize));
+      __ test(ecx, Immediate(kSmiTagMask));
+      __ j(not_zero, &not_smi);
+      __ SmiUntag(ecx);
+      __ push(ecx);
+      __ fild_s(Operand(esp, 0));
+      __ pop(ecx);
+      __ fstp_d(FieldOperand(ebx, eax, times_4, FixedDoubleArray::kHeaderSize));
+      __ add(Operand(eax), Immediate(Smi::FromInt(argc)));
+      __ mov(FieldOperand(edx, JSArray::kLengthOffset), eax);
+      __ ret((argc + 1) * kPointerSize);
+
+      __ bind(&not_smi);
+      __ cmp(FieldOperand(ecx, HeapObject::kMapOffset),
+             Immediate(FACTORY->heap_number_map()));
+      __ j(not_equal, &call_builtin);
+      // NaNs are canonicalized by the builtin.
+      __ mov(edi, FieldOperand(ecx, HeapNumber::kExponentOffset));
+      __ and_(edi, HeapNumber::kExponentMask);
+      __ cmp(edi, HeapNumber::kExponentMask);
+      __ j(equal, &call_builtin);
+      __ mov(edi, FieldOperand(ecx, HeapNumber::kValueOffset));
+      __ mov(FieldOperand(ebx, eax, times_4, FixedDoubleArray::kHeaderSize),
+             edi);
+      __ mov(edi, FieldOperand(ecx, HeapNumber::kValueOffset + kIntSize));
+      __ mov(FieldOperand(ebx, eax, times_4,
+                          FixedDoubleArray::kHeaderSize + kIntSize),
+             edi);
+      __ add(Operand(eax), Immediate(Smi::FromInt(argc)));
+      __ mov(FieldOperand(edx, JSArray::kLengthOffset), eax);
+      __ ret((argc + 1) * kPointerSize);
     }
 
     __ bind(&call_builtin);
@@ -2260,6 +2387,7 @@ MaybeObject* CallStubCompiler::CompileCallConstant(Object* object,
 
     // esp[2 * kPointerSize] is uninitialized, esp[3 * kPointerSize] contains
     // duplicate of return address and will be overwritten.
+    __ mov(edi, Immediate(Handle<JSFunction>(function)));
     bool success = GenerateFastApiCall(masm(), optimization, argc, &failure);
     if (!success) {
       return failure;
@@ -2397,16 +2525,33 @@ MaybeObject* CallStubCompiler::CompileCallGlobal(JSObject* object,
     __ mov(Operand(esp, (argc + 1) * kPointerSize), edx);
   }
 
-  // Setup the context (function already in edi).
-  __ mov(esi, FieldOperand(edi, JSFunction::kContextOffset));
-
-  // Jump to the cached code (tail call).
-  __ IncrementCounter(COUNTERS->call_global_inline(), 1);
-  ASSERT(function->is_compiled());
-  Handle<Code> code(function->code());
-  ParameterCount expected(function->shared()->formal_parameter_count());
-  __ InvokeCode(code, expected, arguments(),
-                RelocInfo::CODE_TARGET, JUMP_FUNCTION);
+  // Call api functions without a receiver signature straight from the
+  // stub instead of through the HandleApiCall builtin.  Their type check
+  // always passes and the holder is the receiver.
+  CallOptimization optimization(function);
+  if (optimization.is_simple_api_call() &&
+      optimization.expected_receiver_type() == NULL) {
+    __ IncrementCounter(COUNTERS->call_global_fast_api(), 1);
+    __ mov(edx, Operand(esp, (argc + 1) * kPointerSize));
+    ReserveSpaceForFastApiCall(masm(), eax);
+    __ mov(Operand(esp, 1 * kPointerSize), edx);
+    Failure* failure;
+    bool success = GenerateFastApiCall(masm(), optimization, argc, &failure);
+    if (!success) {
+      return failure;
+    }
+  } else {
+    // Setup the context (function already in edi).
+    __ mov(esi, FieldOperand(edi, JSFunction::kContextOffset));
+
+    // Jump to the cached code (tail call).
+    __ IncrementCounter(COUNTERS->call_global_inline(), 1);
+    ASSERT(function->is_compiled());
+    Handle<Code> code(function->code());
+    ParameterCount expected(function->shared()->formal_parameter_count());
+    __ InvokeCode(code, expected, arguments(),
+                  RelocInfo::CODE_TARGET, JUMP_FUNCTION);
+  }
 
   // Handle call cache miss.
   __ bind(&miss);
@@ -38,6 +38,14 @@
 namespace v8 {
 namespace internal {
 
+// The inlined keyed loads of these code generators handle receivers with
+// external array elements out of line after the patched map check.
+#if V8_TARGET_ARCH_IA32 || V8_TARGET_ARCH_X64
+static const bool kInlinedExternalArrayLoads = true;
+#else
+static const bool kInlinedExternalArrayLoads = false;
+#endif
+
 #ifdef DEBUG
 static char TransitionMarkFromState(IC::State state) {
   switch (state) {
@@ -268,6 +276,30 @@ void IC::Clear(Address address) {
 }
 
 
+bool IC::ClearIfInlined(Address address) {
+  Code* target = GetTargetAtAddress(address);
+  bool inlined = false;
+  switch (target->kind()) {
+    case Code::LOAD_IC:
+      inlined = LoadIC::ClearInlinedVersion(address);
+      break;
+    case Code::KEYED_LOAD_IC:
+      inlined = KeyedLoadIC::ClearInlinedVersion(address);
+      break;
+    case Code::STORE_IC:
+      inlined = StoreIC::ClearInlinedVersion(address);
+      break;
+    case Code::KEYED_STORE_IC:
+      inlined = KeyedStoreIC::ClearInlinedVersion(address);
+      break;
+    default:
+      break;
+  }
+  if (inlined) Clear(address);
+  return inlined;
+}
+
+
 void CallICBase::Clear(Address address, Code* target) {
   State state = target->ic_state();
   if (state == UNINITIALIZED) return;
@@ -280,10 +312,10 @@ void CallICBase::Clear(Address address, Code* target) {
 }
 
 
-void KeyedLoadIC::ClearInlinedVersion(Address address) {
+bool KeyedLoadIC::ClearInlinedVersion(Address address) {
   // Insert null as the map to check for to make sure the map check fails
   // sending control flow to the IC instead of the inlined version.
-  PatchInlinedLoad(address, HEAP->null_value());
+  return PatchInlinedLoad(address, HEAP->null_value());
 }
 
 
@@ -297,16 +329,19 @@ void KeyedLoadIC::Clear(Address address, Code* target) {
 }
 
 
-void LoadIC::ClearInlinedVersion(Address address) {
+bool LoadIC::ClearInlinedVersion(Address address) {
   // Reset the map check of the inlined inobject property load (if
   // present) to guarantee failure by holding an invalid map (the null
   // value).  The offset can be patched to anything.
   Heap* heap = HEAP;
-  PatchInlinedLoad(address, heap->null_value(), 0);
-  PatchInlinedContextualLoad(address,
-                             heap->null_value(),
-                             heap->null_value(),
-                             true);
+  bool inlined = PatchInlinedLoad(address, heap->null_value(), 0);
+  if (PatchInlinedContextualLoad(address,
+                                 heap->null_value(),
+                                 heap->null_value(),
+                                 true)) {
+    inlined = true;
+  }
+  return inlined;
 }
 
 
@@ -317,11 +352,11 @@ void LoadIC::Clear(Address address, Code* target) {
 }
 
 
-void StoreIC::ClearInlinedVersion(Address address) {
+bool StoreIC::ClearInlinedVersion(Address address) {
   // Reset the map check of the inlined inobject property store (if
   // present) to guarantee failure by holding an invalid map (the null
   // value).  The offset can be patched to anything.
-  PatchInlinedStore(address, HEAP->null_value(), 0);
+  return PatchInlinedStore(address, HEAP->null_value(), 0);
 }
 
 
@@ -332,11 +367,11 @@ void StoreIC::Clear(Address address, Code* target) {
 }
 
 
-void KeyedStoreIC::ClearInlinedVersion(Address address) {
+bool KeyedStoreIC::ClearInlinedVersion(Address address) {
   // Insert null as the elements map to check for.  This will make
   // sure that the elements fast-case map check fails so that control
   // flows to the IC instead of the inlined version.
-  PatchInlinedStore(address, HEAP->null_value());
+  return PatchInlinedStore(address, HEAP->null_value());
 }
 
 
@@ -773,6 +808,27 @@ MaybeObject* KeyedCallIC::LoadFunction(State state,
 #endif
 
 
+// Objects that went to dictionary mode when many properties were added
+// but are no longer changing shape are turned back into fast mode the
+// second time a load site sees them, so the site can go monomorphic.
+// Dictionaries with deleted entries are likely used as hash tables and
+// are left alone, as are large ones.
+static const int kMaxRefastifiedProperties = 128;
+
+static void MaybeTransformToFastProperties(Handle<Object> object) {
+  if (!object->IsJSObject() || object->IsGlobalObject()) return;
+  Handle<JSObject> receiver = Handle<JSObject>::cast(object);
+  if (receiver->HasFastProperties() || receiver->IsAccessCheckNeeded()) return;
+  StringDictionary* dictionary = receiver->property_dictionary();
+  if (dictionary->NumberOfDeletedElements() > 0) return;
+  int number_of_properties = dictionary->NumberOfElements();
+  if (number_of_properties > kMaxRefastifiedProperties) return;
+  // Leave some room for properties added later, so a few more
+  // additions do not send the object straight back to dictionary mode.
+  TransformToFastProperties(receiver, number_of_properties / 4);
+}
+
+
 MaybeObject* LoadIC::Load(State state,
                           Handle<Object> object,
                           Handle<String> name) {
@@ -843,6 +899,10 @@ MaybeObject* LoadIC::Load(State state,
   uint32_t index;
   if (name->AsArrayIndex(&index)) return object->GetElement(index);
 
+  if (FLAG_use_ic && state == PREMONOMORPHIC) {
+    MaybeTransformToFastProperties(object);
+  }
+
   // Named lookup in the object.
   LookupResult lookup;
   LookupForRead(*object, *name, &lookup);
@@ -1173,11 +1233,14 @@ MaybeObject* KeyedLoadIC::Load(State state,
     // For JSObjects with fast elements that are not value wrappers
     // and that do not have indexed interceptors, we initialize the
     // inlined fast case (if present) by patching the inlined map
-    // check.
+    // check.  Where the inlined code handles external arrays, this
+    // is done for JSObjects with external array elements too.
     if (object->IsJSObject() &&
         !object->IsJSValue() &&
         !JSObject::cast(*object)->HasIndexedInterceptor() &&
-        JSObject::cast(*object)->HasFastElements()) {
+        (JSObject::cast(*object)->HasFastElements() ||
+         (kInlinedExternalArrayLoads &&
+          JSObject::cast(*object)->HasExternalArrayElements()))) {
       Map* map = JSObject::cast(*object)->map();
       PatchInlinedLoad(address(), map);
     }
@@ -1641,6 +1704,7 @@ static JSFunction* CompileFunction(JSFunction* function,
 MUST_USE_RESULT MaybeObject* CallIC_Miss(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation na;
+  isolate->heap()->NotifyICMiss();
   ASSERT(args.length() == 2);
   CallIC ic(isolate);
   IC::State state = IC::StateFrom(ic.target(), args[0], args[1]);
@@ -1668,6 +1732,7 @@ MUST_USE_RESULT MaybeObject* CallIC_Miss(RUNTIME_CALLING_CONVENTION) {
 MUST_USE_RESULT MaybeObject* KeyedCallIC_Miss(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation na;
+  isolate->heap()->NotifyICMiss();
   ASSERT(args.length() == 2);
   KeyedCallIC ic(isolate);
   IC::State state = IC::StateFrom(ic.target(), args[0], args[1]);
@@ -1688,6 +1753,7 @@ MUST_USE_RESULT MaybeObject* KeyedCallIC_Miss(RUNTIME_CALLING_CONVENTION) {
 MUST_USE_RESULT MaybeObject* LoadIC_Miss(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation na;
+  isolate->heap()->NotifyICMiss();
   ASSERT(args.length() == 2);
   LoadIC ic(isolate);
   IC::State state = IC::StateFrom(ic.target(), args[0], args[1]);
@@ -1699,6 +1765,7 @@ MUST_USE_RESULT MaybeObject* LoadIC_Miss(RUNTIME_CALLING_CONVENTION) {
 MUST_USE_RESULT MaybeObject* KeyedLoadIC_Miss(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation na;
+  isolate->heap()->NotifyICMiss();
   ASSERT(args.length() == 2);
   KeyedLoadIC ic(isolate);
   IC::State state = IC::StateFrom(ic.target(), args[0], args[1]);
@@ -1710,6 +1777,7 @@ MUST_USE_RESULT MaybeObject* KeyedLoadIC_Miss(RUNTIME_CALLING_CONVENTION) {
 MUST_USE_RESULT MaybeObject* StoreIC_Miss(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation na;
+  isolate->heap()->NotifyICMiss();
   ASSERT(args.length() == 3);
   StoreIC ic(isolate);
   IC::State state = IC::StateFrom(ic.target(), args[0], args[1]);
@@ -1779,6 +1847,7 @@ MUST_USE_RESULT MaybeObject* SharedStoreIC_ExtendStorage(
 MUST_USE_RESULT MaybeObject* KeyedStoreIC_Miss(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation na;
+  isolate->heap()->NotifyICMiss();
   ASSERT(args.length() == 3);
   KeyedStoreIC ic(isolate);
   IC::State state = IC::StateFrom(ic.target(), args[0], args[1]);
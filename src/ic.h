@@ -97,6 +97,10 @@ class IC {
   // Clear the inline cache to initial state.
   static void Clear(Address address);
 
+  // Clear the inline cache to initial state if the call site has an
+  // inlined fast case in the calling code, and return whether it had one.
+  static bool ClearIfInlined(Address address);
+
   // Computes the reloc info for this IC. This is a fairly expensive
   // operation as it has to search through the heap to find the code
   // object that contains this IC site.
@@ -282,8 +286,9 @@ class LoadIC: public IC {
   static void GenerateStringLength(MacroAssembler* masm);
   static void GenerateFunctionPrototype(MacroAssembler* masm);
 
-  // Clear the use of the inlined version.
-  static void ClearInlinedVersion(Address address);
+  // Clear the use of the inlined version.  Returns whether the call
+  // site has one.
+  static bool ClearInlinedVersion(Address address);
 
   // The offset from the inlined patch site to the start of the
   // inlined load instruction.  It is architecture-dependent, and not
@@ -353,8 +358,9 @@ class KeyedLoadIC: public IC {
                                     ExternalArrayType array_type);
   static void GenerateIndexedInterceptor(MacroAssembler* masm);
 
-  // Clear the use of the inlined version.
-  static void ClearInlinedVersion(Address address);
+  // Clear the use of the inlined version.  Returns whether the call
+  // site has one.
+  static bool ClearInlinedVersion(Address address);
 
   // Bit mask to be tested against bit field for the cases when
   // generic stub should go into slow case.
@@ -426,8 +432,9 @@ class StoreIC: public IC {
   static void GenerateArrayLength(MacroAssembler* masm);
   static void GenerateNormal(MacroAssembler* masm);
 
-  // Clear the use of an inlined version.
-  static void ClearInlinedVersion(Address address);
+  // Clear the use of an inlined version.  Returns whether the call
+  // site has one.
+  static bool ClearInlinedVersion(Address address);
 
   // The offset from the inlined patch site to the start of the
   // inlined store instruction.
@@ -483,8 +490,9 @@ class KeyedStoreIC: public IC {
   static void GenerateExternalArray(MacroAssembler* masm,
                                     ExternalArrayType array_type);
 
-  // Clear the inlined version so the IC is always hit.
-  static void ClearInlinedVersion(Address address);
+  // Clear the inlined version so the IC is always hit.  Returns whether
+  // the call site has one.
+  static bool ClearInlinedVersion(Address address);
 
   // Restore the inlined version so the fast case can get hit.
   static void RestoreInlinedVersion(Address address);
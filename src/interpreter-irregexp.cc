@@ -116,20 +116,51 @@ static void TraceInterpreter(const byte* code_base,
     printf("\n");
   }
 }
+#endif  // DEBUG
+
+
+// With GCC the interpreter jumps from each instruction directly to the code
+// for the next one through a table of label addresses, rather than going
+// back to a single switch statement.  This lets the branch predictor see
+// which instructions tend to follow each other.  Labels as values are a GNU
+// extension, so they are not reported as pedantic errors.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#define V8_IRREGEXP_THREADED_DISPATCH 1
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
 
 
+#ifdef DEBUG
+#define TRACE_BYTECODE(name)                                                \
+  TraceInterpreter(code_base,                                               \
+                   pc,                                                      \
+                   static_cast<int>(backtrack_sp - backtrack_stack_base),   \
+                   current,                                                 \
+                   current_char,                                            \
+                   BC_##name##_LENGTH,                                      \
+                   #name);
+#else
+#define TRACE_BYTECODE(name)
+#endif
+
+
+#ifdef V8_IRREGEXP_THREADED_DISPATCH
 #define BYTECODE(name)                                                      \
-  case BC_##name:                                                           \
-    TraceInterpreter(code_base,                                             \
-                     pc,                                                    \
-                     static_cast<int>(backtrack_sp - backtrack_stack_base), \
-                     current,                                               \
-                     current_char,                                          \
-                     BC_##name##_LENGTH,                                    \
-                     #name);
+  BC_##name##_HANDLER:                                                      \
+    TRACE_BYTECODE(name)
+#define DISPATCH()                                                          \
+  do {                                                                      \
+    insn = Load32Aligned(pc);                                               \
+    ASSERT((insn & BYTECODE_MASK) <                                         \
+           static_cast<int>(ARRAY_SIZE(dispatch_table)));                   \
+    goto *dispatch_table[insn & BYTECODE_MASK];                             \
+  } while (false)
 #else
 #define BYTECODE(name)                                                      \
-  case BC_##name:
+  case BC_##name:                                                           \
+    TRACE_BYTECODE(name)
+#define DISPATCH() break
 #endif
 
 
@@ -146,19 +177,21 @@ static int32_t Load16Aligned(const byte* pc) {
 
 
 // A simple abstraction over the backtracking stack used by the interpreter.
-// This backtracking stack does not grow automatically, but it ensures that the
-// the memory held by the stack is released or remembered in a cache if the
-// matching terminates.
+// The stack is grown when a push finds it full, up to the size the native
+// regexp code may use.  When the matching terminates the memory held by the
+// stack is remembered in a cache, so that most matches do not allocate.
 class BacktrackStack {
  public:
   explicit BacktrackStack(Isolate* isolate) : isolate_(isolate) {
     if (isolate->irregexp_interpreter_backtrack_stack_cache() != NULL) {
       // If the cache is not empty reuse the previously allocated stack.
       data_ = isolate->irregexp_interpreter_backtrack_stack_cache();
+      size_ = isolate->irregexp_interpreter_backtrack_stack_cache_size();
       isolate->set_irregexp_interpreter_backtrack_stack_cache(NULL);
     } else {
       // Cache was empty. Allocate a new backtrack stack.
-      data_ = NewArray<int>(kBacktrackStackSize);
+      size_ = kInitialSize;
+      data_ = NewArray<int>(size_);
     }
   }
 
@@ -166,6 +199,7 @@ class BacktrackStack {
     if (isolate_->irregexp_interpreter_backtrack_stack_cache() == NULL) {
       // The cache is empty. Keep this backtrack stack around.
       isolate_->set_irregexp_interpreter_backtrack_stack_cache(data_);
+      isolate_->set_irregexp_interpreter_backtrack_stack_cache_size(size_);
     } else {
       // A backtrack stack was already cached, just release this one.
       DeleteArray(data_);
@@ -174,12 +208,32 @@ class BacktrackStack {
 
   int* data() const { return data_; }
 
-  int max_size() const { return kBacktrackStackSize; }
+  int size() const { return size_; }
+
+  // Makes room for the push that found the stack full.  Updates the base,
+  // the stack pointer and the remaining space of the caller, or returns
+  // false if the stack has reached its maximum size.
+  bool Grow(int** base, int** sp, int* space) {
+    if (size_ >= kMaximumSize) return false;
+    int depth = static_cast<int>(*sp - data_);
+    int new_size = Min(size_ * 2, kMaximumSize);
+    int* new_data = NewArray<int>(new_size);
+    memcpy(new_data, data_, depth * kIntSize);
+    DeleteArray(data_);
+    data_ = new_data;
+    size_ = new_size;
+    *base = data_;
+    *sp = data_ + depth;
+    *space = size_ - depth - 1;
+    return true;
+  }
 
  private:
-  static const int kBacktrackStackSize = 10000;
+  static const int kInitialSize = 10000;
+  static const int kMaximumSize = 64 * MB / kIntSize;
 
   int* data_;
+  int size_;
   Isolate* isolate_;
 
   DISALLOW_COPY_AND_ASSIGN(BacktrackStack);
@@ -200,83 +254,102 @@ static bool RawMatch(Isolate* isolate,
   BacktrackStack backtrack_stack(isolate);
   int* backtrack_stack_base = backtrack_stack.data();
   int* backtrack_sp = backtrack_stack_base;
-  int backtrack_stack_space = backtrack_stack.max_size();
+  int backtrack_stack_space = backtrack_stack.size();
 #ifdef DEBUG
   if (FLAG_trace_regexp_bytecodes) {
     PrintF("\n\nStart bytecode interpreter\n\n");
   }
 #endif
+#ifdef V8_IRREGEXP_THREADED_DISPATCH
+#define DECLARE_DISPATCH_TABLE_ENTRY(name, code, length) &&BC_##name##_HANDLER,
+  static const void* const dispatch_table[] = {
+    BYTECODE_ITERATOR(DECLARE_DISPATCH_TABLE_ENTRY)
+  };
+#undef DECLARE_DISPATCH_TABLE_ENTRY
+  int32_t insn;
+  DISPATCH();
+#else
   while (true) {
     int32_t insn = Load32Aligned(pc);
     switch (insn & BYTECODE_MASK) {
+#endif
       BYTECODE(BREAK)
         UNREACHABLE();
         return false;
       BYTECODE(PUSH_CP)
-        if (--backtrack_stack_space < 0) {
+        if (--backtrack_stack_space < 0 &&
+            !backtrack_stack.Grow(&backtrack_stack_base,
+                                  &backtrack_sp,
+                                  &backtrack_stack_space)) {
           return false;  // No match on backtrack stack overflow.
         }
         *backtrack_sp++ = current;
         pc += BC_PUSH_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(PUSH_BT)
-        if (--backtrack_stack_space < 0) {
+        if (--backtrack_stack_space < 0 &&
+            !backtrack_stack.Grow(&backtrack_stack_base,
+                                  &backtrack_sp,
+                                  &backtrack_stack_space)) {
           return false;  // No match on backtrack stack overflow.
         }
         *backtrack_sp++ = Load32Aligned(pc + 4);
         pc += BC_PUSH_BT_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(PUSH_REGISTER)
-        if (--backtrack_stack_space < 0) {
+        if (--backtrack_stack_space < 0 &&
+            !backtrack_stack.Grow(&backtrack_stack_base,
+                                  &backtrack_sp,
+                                  &backtrack_stack_space)) {
           return false;  // No match on backtrack stack overflow.
         }
         *backtrack_sp++ = registers[insn >> BYTECODE_SHIFT];
         pc += BC_PUSH_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER)
         registers[insn >> BYTECODE_SHIFT] = Load32Aligned(pc + 4);
         pc += BC_SET_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(ADVANCE_REGISTER)
         registers[insn >> BYTECODE_SHIFT] += Load32Aligned(pc + 4);
         pc += BC_ADVANCE_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER_TO_CP)
         registers[insn >> BYTECODE_SHIFT] = current + Load32Aligned(pc + 4);
         pc += BC_SET_REGISTER_TO_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_CP_TO_REGISTER)
         current = registers[insn >> BYTECODE_SHIFT];
         pc += BC_SET_CP_TO_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER_TO_SP)
         registers[insn >> BYTECODE_SHIFT] =
             static_cast<int>(backtrack_sp - backtrack_stack_base);
         pc += BC_SET_REGISTER_TO_SP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_SP_TO_REGISTER)
         backtrack_sp = backtrack_stack_base + registers[insn >> BYTECODE_SHIFT];
-        backtrack_stack_space = backtrack_stack.max_size() -
+        backtrack_stack_space = backtrack_stack.size() -
             static_cast<int>(backtrack_sp - backtrack_stack_base);
         pc += BC_SET_SP_TO_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(POP_CP)
         backtrack_stack_space++;
         --backtrack_sp;
         current = *backtrack_sp;
         pc += BC_POP_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(POP_BT)
         backtrack_stack_space++;
         --backtrack_sp;
         pc = code_base + *backtrack_sp;
-        break;
+        DISPATCH();
       BYTECODE(POP_REGISTER)
         backtrack_stack_space++;
         --backtrack_sp;
         registers[insn >> BYTECODE_SHIFT] = *backtrack_sp;
         pc += BC_POP_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(FAIL)
         return false;
       BYTECODE(SUCCEED)
@@ -284,14 +357,14 @@ static bool RawMatch(Isolate* isolate,
       BYTECODE(ADVANCE_CP)
         current += insn >> BYTECODE_SHIFT;
         pc += BC_ADVANCE_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(GOTO)
         pc = code_base + Load32Aligned(pc + 4);
-        break;
+        DISPATCH();
       BYTECODE(ADVANCE_CP_AND_GOTO)
         current += insn >> BYTECODE_SHIFT;
         pc = code_base + Load32Aligned(pc + 4);
-        break;
+        DISPATCH();
       BYTECODE(CHECK_GREEDY)
         if (current == backtrack_sp[-1]) {
           backtrack_sp--;
@@ -300,7 +373,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_GREEDY_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(LOAD_CURRENT_CHAR) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         if (pos >= subject.length()) {
@@ -309,13 +382,13 @@ static bool RawMatch(Isolate* isolate,
           current_char = subject[pos];
           pc += BC_LOAD_CURRENT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_CURRENT_CHAR_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         current_char = subject[pos];
         pc += BC_LOAD_CURRENT_CHAR_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_2_CURRENT_CHARS) {
         int pos = current + (insn >> BYTECODE_SHIFT);
@@ -327,14 +400,14 @@ static bool RawMatch(Isolate* isolate,
               (subject[pos] | (next << (kBitsPerByte * sizeof(Char))));
           pc += BC_LOAD_2_CURRENT_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_2_CURRENT_CHARS_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         Char next = subject[pos + 1];
         current_char = (subject[pos] | (next << (kBitsPerByte * sizeof(Char))));
         pc += BC_LOAD_2_CURRENT_CHARS_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_4_CURRENT_CHARS) {
         ASSERT(sizeof(Char) == 1);
@@ -351,7 +424,7 @@ static bool RawMatch(Isolate* isolate,
                           (next3 << 24));
           pc += BC_LOAD_4_CURRENT_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_4_CURRENT_CHARS_UNCHECKED) {
         ASSERT(sizeof(Char) == 1);
@@ -364,7 +437,59 @@ static bool RawMatch(Isolate* isolate,
                         (next2 << 16) |
                         (next3 << 24));
         pc += BC_LOAD_4_CURRENT_CHARS_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CURRENT_CHAR_CHECK_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        if (pos >= subject.length()) {
+          pc = code_base + Load32Aligned(pc + 4);
+        } else {
+          current_char = subject[pos];
+          uint32_t c = Load32Aligned(pc + 8);
+          if (c == current_char) {
+            pc = code_base + Load32Aligned(pc + 12);
+          } else {
+            pc += BC_LOAD_CURRENT_CHAR_CHECK_CHAR_LENGTH;
+          }
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CURRENT_CHAR_CHECK_NOT_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        if (pos >= subject.length()) {
+          pc = code_base + Load32Aligned(pc + 4);
+        } else {
+          current_char = subject[pos];
+          uint32_t c = Load32Aligned(pc + 8);
+          if (c != current_char) {
+            pc = code_base + Load32Aligned(pc + 12);
+          } else {
+            pc += BC_LOAD_CURRENT_CHAR_CHECK_NOT_CHAR_LENGTH;
+          }
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CURRENT_CHAR_UNCHECKED_CHECK_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        current_char = subject[pos];
+        uint32_t c = Load32Aligned(pc + 4);
+        if (c == current_char) {
+          pc = code_base + Load32Aligned(pc + 8);
+        } else {
+          pc += BC_LOAD_CURRENT_CHAR_UNCHECKED_CHECK_CHAR_LENGTH;
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CURRENT_CHAR_UNCHECKED_CHECK_NOT_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        current_char = subject[pos];
+        uint32_t c = Load32Aligned(pc + 4);
+        if (c != current_char) {
+          pc = code_base + Load32Aligned(pc + 8);
+        } else {
+          pc += BC_LOAD_CURRENT_CHAR_UNCHECKED_CHECK_NOT_CHAR_LENGTH;
+        }
+        DISPATCH();
       }
       BYTECODE(CHECK_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -373,7 +498,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -382,7 +507,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -391,7 +516,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_NOT_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -400,7 +525,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -409,7 +534,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -418,7 +543,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_NOT_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -427,7 +552,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_NOT_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -436,7 +561,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(MINUS_AND_CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -447,7 +572,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_MINUS_AND_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_LT) {
         uint32_t limit = (insn >> BYTECODE_SHIFT);
@@ -456,7 +581,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_LT_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_GT) {
         uint32_t limit = (insn >> BYTECODE_SHIFT);
@@ -465,7 +590,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_GT_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_REGISTER_LT)
         if (registers[insn >> BYTECODE_SHIFT] < Load32Aligned(pc + 4)) {
@@ -473,21 +598,21 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_REGISTER_LT_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_REGISTER_GE)
         if (registers[insn >> BYTECODE_SHIFT] >= Load32Aligned(pc + 4)) {
           pc = code_base + Load32Aligned(pc + 8);
         } else {
           pc += BC_CHECK_REGISTER_GE_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_REGISTER_EQ_POS)
         if (registers[insn >> BYTECODE_SHIFT] == current) {
           pc = code_base + Load32Aligned(pc + 4);
         } else {
           pc += BC_CHECK_REGISTER_EQ_POS_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(LOOKUP_MAP1) {
         // Look up character in a bitmap.  If we find a 0, then jump to the
         // location at pc + 8.  Otherwise fall through!
@@ -499,7 +624,7 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_LOOKUP_MAP1_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOOKUP_MAP2) {
         // Look up character in a half-nibble map.  If we find 00, then jump to
@@ -521,7 +646,7 @@ static bool RawMatch(Isolate* isolate,
             pc = code_base + Load32Aligned(pc + 20);
           }
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOOKUP_MAP8) {
         // Look up character in a byte map.  Use the byte as an index into a
@@ -530,7 +655,7 @@ static bool RawMatch(Isolate* isolate,
         byte map = code_base[Load32Aligned(pc + 4) + index];
         const byte* new_pc = code_base + Load32Aligned(pc + 8) + (map << 2);
         pc = code_base + Load32Aligned(new_pc);
-        break;
+        DISPATCH();
       }
       BYTECODE(LOOKUP_HI_MAP8) {
         // Look up high byte of this character in a byte map.  Use the byte as
@@ -539,7 +664,7 @@ static bool RawMatch(Isolate* isolate,
         byte map = code_base[Load32Aligned(pc + 4) + index];
         const byte* new_pc = code_base + Load32Aligned(pc + 8) + (map << 2);
         pc = code_base + Load32Aligned(new_pc);
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_REGS_EQUAL)
         if (registers[insn >> BYTECODE_SHIFT] ==
@@ -548,41 +673,33 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc = code_base + Load32Aligned(pc + 8);
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_NOT_BACK_REF) {
         int from = registers[insn >> BYTECODE_SHIFT];
         int len = registers[(insn >> BYTECODE_SHIFT) + 1] - from;
         if (from < 0 || len <= 0) {
           pc += BC_CHECK_NOT_BACK_REF_LENGTH;
-          break;
-        }
-        if (current + len > subject.length()) {
+        } else if (current + len > subject.length()) {
           pc = code_base + Load32Aligned(pc + 4);
-          break;
         } else {
-          int i;
-          for (i = 0; i < len; i++) {
-            if (subject[from + i] != subject[current + i]) {
-              pc = code_base + Load32Aligned(pc + 4);
-              break;
-            }
+          int i = 0;
+          while (i < len && subject[from + i] == subject[current + i]) i++;
+          if (i < len) {
+            pc = code_base + Load32Aligned(pc + 4);
+          } else {
+            current += len;
+            pc += BC_CHECK_NOT_BACK_REF_LENGTH;
           }
-          if (i < len) break;
-          current += len;
         }
-        pc += BC_CHECK_NOT_BACK_REF_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_BACK_REF_NO_CASE) {
         int from = registers[insn >> BYTECODE_SHIFT];
         int len = registers[(insn >> BYTECODE_SHIFT) + 1] - from;
         if (from < 0 || len <= 0) {
           pc += BC_CHECK_NOT_BACK_REF_NO_CASE_LENGTH;
-          break;
-        }
-        if (current + len > subject.length()) {
+        } else if (current + len > subject.length()) {
           pc = code_base + Load32Aligned(pc + 4);
-          break;
         } else {
           if (BackRefMatchesNoCase(isolate->interp_canonicalize_mapping(),
                                    from, current, len, subject)) {
@@ -592,7 +709,7 @@ static bool RawMatch(Isolate* isolate,
             pc = code_base + Load32Aligned(pc + 4);
           }
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_AT_START)
         if (current == 0) {
@@ -600,14 +717,14 @@ static bool RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_AT_START_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_NOT_AT_START)
         if (current == 0) {
           pc += BC_CHECK_NOT_AT_START_LENGTH;
         } else {
           pc = code_base + Load32Aligned(pc + 4);
         }
-        break;
+        DISPATCH();
       BYTECODE(SET_CURRENT_POSITION_FROM_END) {
         int by = static_cast<uint32_t>(insn) >> BYTECODE_SHIFT;
         if (subject.length() - current > by) {
@@ -615,15 +732,21 @@ static bool RawMatch(Isolate* isolate,
           current_char = subject[current - 1];
         }
         pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
-        break;
+        DISPATCH();
       }
+#ifndef V8_IRREGEXP_THREADED_DISPATCH
       default:
         UNREACHABLE();
         break;
     }
   }
+#endif
 }
 
+#undef DISPATCH
+#undef BYTECODE
+#undef TRACE_BYTECODE
+
 
 bool IrregexpInterpreter::Match(Isolate* isolate,
                                 Handle<ByteArray> code_array,
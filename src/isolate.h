@@ -300,6 +300,11 @@ typedef List<HeapObject*, PreallocatedStorage> DebugObjectCache;
   V(Object*, string_stream_current_security_token, NULL)                       \
   /* TODO(isolates): Release this on destruction? */                           \
   V(int*, irregexp_interpreter_backtrack_stack_cache, NULL)                    \
+  V(int, irregexp_interpreter_backtrack_stack_cache_size, 0)                   \
+  /* The cons string last read in place by the runtime and the work spent */  \
+  /* on it.  The address is only compared, never dereferenced. */              \
+  V(Address, rope_access_address, NULL)                                        \
+  V(int, rope_access_work, 0)                                                  \
   /* Serializer state. */                                                      \
   V(ExternalReferenceTable*, external_reference_table, NULL)                   \
   ISOLATE_PLATFORM_INIT_LIST(V)                                                \
@@ -201,21 +201,18 @@ function BasicSerializeArray(value, stack, builder) {
     throw MakeTypeError('circular_structure', []);
   }
   stack.push(value);
-  builder.push("[");
+  builder.add("[");
   var len = value.length;
   for (var i = 0; i < len; i++) {
     var before = builder.length;
     BasicJSONSerialize(i, value, stack, builder);
-    if (before == builder.length) builder.push("null");
-    builder.push(",");
+    if (before == builder.length) builder.add("null");
+    builder.add(",");
   }
   stack.pop();
-  if (builder.pop() != ",") {
-    builder.push("[]");  // Zero length array. Push "[" back on.
-  } else {
-    builder.push("]");
-  }
-
+  // Replace the trailing comma, if any, with the closing bracket.
+  if (len > 0) builder.length--;
+  builder.add("]");
 }
 
 
@@ -224,27 +221,26 @@ function BasicSerializeObject(value, stack, builder) {
     throw MakeTypeError('circular_structure', []);
   }
   stack.push(value);
-  builder.push("{");
+  builder.add("{");
+  var start = builder.length;
   for (var p in value) {
     if (%HasLocalProperty(value, p)) {
-      builder.push(%QuoteJSONString(p));
-      builder.push(":");
       var before = builder.length;
+      builder.add(%QuoteJSONString(p));
+      builder.add(":");
+      var before_value = builder.length;
       BasicJSONSerialize(p, value, stack, builder);
-      if (before == builder.length) {
-        builder.pop();
-        builder.pop();
+      if (before_value == builder.length) {
+        builder.length = before;  // Drop the key.
       } else {
-        builder.push(",");
+        builder.add(",");
       }
     }
   }
   stack.pop();
-  if (builder.pop() != ",") {
-    builder.push("{}");  // Object has no own properties. Push "{" back on.
-  } else {
-    builder.push("}");
-  }
+  // Replace the trailing comma, if any, with the closing brace.
+  if (builder.length != start) builder.length--;
+  builder.add("}");
 }
 
 
@@ -255,24 +251,24 @@ function BasicJSONSerialize(key, holder, stack, builder) {
     if (IS_FUNCTION(toJSON)) value = toJSON.call(value, $String(key));
   }
   if (IS_STRING(value)) {
-    builder.push(%QuoteJSONString(value));
+    builder.add(%QuoteJSONString(value));
   } else if (IS_NUMBER(value)) {
-    builder.push(($isFinite(value) ? %_NumberToString(value) : "null"));
+    builder.add(($isFinite(value) ? %_NumberToString(value) : "null"));
   } else if (IS_BOOLEAN(value)) {
-    builder.push((value ? "true" : "false"));
+    builder.add((value ? "true" : "false"));
   } else if (IS_OBJECT(value)) {
     // Unwrap value if necessary
     if (IS_NUMBER_WRAPPER(value)) {
       value = %_ValueOf(value);
-      builder.push(($isFinite(value) ? %_NumberToString(value) : "null"));      
+      builder.add(($isFinite(value) ? %_NumberToString(value) : "null"));      
     } else if (IS_STRING_WRAPPER(value)) {
-      builder.push(%QuoteJSONString(%_ValueOf(value)));
+      builder.add(%QuoteJSONString(%_ValueOf(value)));
     } else if (IS_BOOLEAN_WRAPPER(value)) {
-      builder.push((%_ValueOf(value) ? "true" : "false")); 
+      builder.add((%_ValueOf(value) ? "true" : "false")); 
     } else {
       // Regular non-wrapped object
       if (!value) {
-        builder.push("null");
+        builder.add("null");
       } else if (IS_ARRAY(value)) {
         BasicSerializeArray(value, stack, builder);
       } else {
@@ -284,12 +280,10 @@ function BasicJSONSerialize(key, holder, stack, builder) {
 
 function JSONStringify(value, replacer, space) {
   if (IS_UNDEFINED(replacer) && IS_UNDEFINED(space)) {
-    var builder = [];
+    var builder = new StringBuilder(0);
     BasicJSONSerialize('', {'': value}, [], builder);
     if (builder.length == 0) return;
-    var result = %_FastAsciiArrayJoin(builder, "");
-    if (!IS_UNDEFINED(result)) return result;
-    return %StringBuilderConcat(builder, builder.length, "");
+    return builder.generate();
   }
   if (IS_OBJECT(space)) {
     // Unwrap 'space' if it is wrapped
@@ -41,6 +41,7 @@
 #include "regexp-macro-assembler.h"
 #include "regexp-macro-assembler-tracer.h"
 #include "regexp-macro-assembler-irregexp.h"
+#include "regexp-nfa.h"
 #include "regexp-stack.h"
 
 #ifndef V8_INTERPRETED_REGEXP
@@ -105,6 +106,72 @@ static inline void ThrowRegExpException(Handle<JSRegExp> re,
 }
 
 
+// Finds the longest literal that every match of a regexp contains, so it
+// can be searched for before the regexp code is run.  If the literal is
+// at the same offset from the start of every match, the search also tells
+// where the first match can start.
+class RequiredLiteralFinder {
+ public:
+  RequiredLiteralFinder() : offset_(-1) { }
+
+  // Visits a tree that starts at the given offset from the start of the
+  // match, or at a varying offset if offset is negative.
+  void Visit(RegExpTree* tree, int offset);
+
+  Vector<const uc16> literal() { return literal_; }
+  int offset() { return offset_; }
+
+ private:
+  static const int kMaxOffset = 0xffff;
+
+  void Found(Vector<const uc16> literal, int offset) {
+    if (literal.length() > literal_.length() ||
+        (literal.length() == literal_.length() && offset_ < 0)) {
+      literal_ = literal;
+      offset_ = offset;
+    }
+  }
+
+  // Returns the offset after a tree of the given length.
+  static int Advance(int offset, int min_length, int max_length) {
+    if (offset < 0 || min_length != max_length) return -1;
+    if (max_length > kMaxOffset - offset) return -1;
+    return offset + max_length;
+  }
+
+  Vector<const uc16> literal_;
+  int offset_;
+};
+
+
+void RequiredLiteralFinder::Visit(RegExpTree* tree, int offset) {
+  if (tree->IsAtom()) {
+    Found(tree->AsAtom()->data(), offset);
+  } else if (tree->IsText()) {
+    ZoneList<TextElement>* elements = tree->AsText()->elements();
+    for (int i = 0; i < elements->length(); i++) {
+      TextElement element = elements->at(i);
+      if (element.type == TextElement::ATOM) {
+        Found(element.data.u_atom->data(), offset);
+      }
+      offset = Advance(offset, element.length(), element.length());
+    }
+  } else if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      RegExpTree* node = nodes->at(i);
+      Visit(node, offset);
+      offset = Advance(offset, node->min_match(), node->max_match());
+    }
+  } else if (tree->IsCapture()) {
+    Visit(tree->AsCapture()->body(), offset);
+  } else if (tree->IsQuantifier() && tree->AsQuantifier()->min() > 0) {
+    // The first iteration is part of every match.
+    Visit(tree->AsQuantifier()->body(), offset);
+  }
+}
+
+
 // Generic RegExp methods. Dispatches to implementation specific methods.
 
 
@@ -151,6 +218,18 @@ Handle<Object> RegExpImpl::Compile(Handle<JSRegExp> re,
     AtomCompile(re, pattern, flags, atom_string);
   } else {
     IrregexpInitialize(re, pattern, flags, parse_result.capture_count);
+    if (!flags.is_ignore_case()) {
+      RequiredLiteralFinder finder;
+      finder.Visit(parse_result.tree, 0);
+      if (finder.literal().length() > 0) {
+        Handle<FixedArray> data(FixedArray::cast(re->data()));
+        Handle<String> literal =
+            isolate->factory()->NewStringFromTwoByte(finder.literal());
+        data->set(JSRegExp::kIrregexpLiteralIndex, *literal);
+        data->set(JSRegExp::kIrregexpLiteralOffsetIndex,
+                  Smi::FromInt(finder.offset()));
+      }
+    }
   }
   ASSERT(re->data()->IsFixedArray());
   // Compilation succeeded so the data is set on the regexp
@@ -231,39 +310,15 @@ Handle<Object> RegExpImpl::AtomExec(Handle<JSRegExp> re,
   ASSERT(0 <= index);
   ASSERT(index <= subject->length());
 
-  if (!subject->IsFlat()) FlattenString(subject);
-  AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
-  // Extract flattened substrings of cons strings before determining asciiness.
-  String* seq_sub = *subject;
-  if (seq_sub->IsConsString()) seq_sub = ConsString::cast(seq_sub)->first();
-
-  String* needle = String::cast(re->DataAt(JSRegExp::kAtomPatternIndex));
+  Handle<String> needle(String::cast(re->DataAt(JSRegExp::kAtomPatternIndex)));
   int needle_len = needle->length();
 
   if (needle_len != 0) {
     if (index + needle_len > subject->length())
         return isolate->factory()->null_value();
 
-    // dispatch on type of strings
-    index = (needle->IsAsciiRepresentation()
-             ? (seq_sub->IsAsciiRepresentation()
-                ? SearchString(isolate,
-                               seq_sub->ToAsciiVector(),
-                               needle->ToAsciiVector(),
-                               index)
-                : SearchString(isolate,
-                               seq_sub->ToUC16Vector(),
-                               needle->ToAsciiVector(),
-                               index))
-             : (seq_sub->IsAsciiRepresentation()
-                ? SearchString(isolate,
-                               seq_sub->ToAsciiVector(),
-                               needle->ToUC16Vector(),
-                               index)
-                : SearchString(isolate,
-                               seq_sub->ToUC16Vector(),
-                               needle->ToUC16Vector(),
-                               index)));
+    // Long cons string subjects are searched without flattening them.
+    index = Runtime::StringMatch(isolate, subject, needle, index);
     if (index == -1) return FACTORY->null_value();
   }
   ASSERT(last_match_info->HasFastElements());
@@ -287,9 +342,8 @@ Handle<Object> RegExpImpl::AtomExec(Handle<JSRegExp> re,
 // returns false.
 bool RegExpImpl::EnsureCompiledIrregexp(Handle<JSRegExp> re, bool is_ascii) {
   Object* compiled_code = re->DataAt(JSRegExp::code_index(is_ascii));
-#ifdef V8_INTERPRETED_REGEXP
   if (compiled_code->IsByteArray()) return true;
-#else  // V8_INTERPRETED_REGEXP (RegExp native code)
+#ifndef V8_INTERPRETED_REGEXP
   if (compiled_code->IsCode()) return true;
 #endif
   return CompileIrregexp(re, is_ascii);
@@ -423,14 +477,15 @@ int RegExpImpl::IrregexpPrepare(Handle<JSRegExp> regexp,
   if (!EnsureCompiledIrregexp(regexp, is_ascii)) {
     return -1;
   }
-#ifdef V8_INTERPRETED_REGEXP
+#ifndef V8_INTERPRETED_REGEXP
+  if (!FLAG_regexp_interpret_all) {
+    // Native regexp only needs room to output captures. Registers are
+    // handled internally.
+    return (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) * 2;
+  }
+#endif  // V8_INTERPRETED_REGEXP
   // Byte-code regexp needs space allocated for all its registers.
   return IrregexpNumberOfRegisters(FixedArray::cast(regexp->data()));
-#else  // V8_INTERPRETED_REGEXP
-  // Native regexp only needs room to output captures. Registers are handled
-  // internally.
-  return (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) * 2;
-#endif  // V8_INTERPRETED_REGEXP
 }
 
 
@@ -450,41 +505,62 @@ RegExpImpl::IrregexpResult RegExpImpl::IrregexpExecOnce(
     subject = Handle<String>(ConsString::cast(*subject)->first());
   }
 
+  // Start at the first place where the literal that every match contains
+  // allows a match, or fail right away if the literal does not occur.
+  Object* literal = irregexp->get(JSRegExp::kIrregexpLiteralIndex);
+  if (literal->IsString()) {
+    Object* offset_smi = irregexp->get(JSRegExp::kIrregexpLiteralOffsetIndex);
+    int offset = Smi::cast(offset_smi)->value();
+    int search_start = index + Max(offset, 0);
+    if (search_start > subject->length()) return RE_FAILURE;
+    int found = Runtime::StringMatch(regexp->GetIsolate(),
+                                     subject,
+                                     Handle<String>(String::cast(literal)),
+                                     search_start);
+    if (found < 0) return RE_FAILURE;
+    if (offset >= 0) index = found - offset;
+  }
+
 #ifndef V8_INTERPRETED_REGEXP
-  ASSERT(output.length() >=
-      (IrregexpNumberOfCaptures(*irregexp) + 1) * 2);
-  do {
-    bool is_ascii = subject->IsAsciiRepresentation();
-    Handle<Code> code(IrregexpNativeCode(*irregexp, is_ascii));
-    NativeRegExpMacroAssembler::Result res =
-        NativeRegExpMacroAssembler::Match(code,
-                                          subject,
-                                          output.start(),
-                                          output.length(),
-                                          index,
-                                          regexp->GetIsolate());
-    if (res != NativeRegExpMacroAssembler::RETRY) {
-      ASSERT(res != NativeRegExpMacroAssembler::EXCEPTION ||
-             Isolate::Current()->has_pending_exception());
-      STATIC_ASSERT(
-          static_cast<int>(NativeRegExpMacroAssembler::SUCCESS) == RE_SUCCESS);
-      STATIC_ASSERT(
-          static_cast<int>(NativeRegExpMacroAssembler::FAILURE) == RE_FAILURE);
-      STATIC_ASSERT(static_cast<int>(NativeRegExpMacroAssembler::EXCEPTION)
-                    == RE_EXCEPTION);
-      return static_cast<IrregexpResult>(res);
-    }
-    // If result is RETRY, the string has changed representation, and we
-    // must restart from scratch.
-    // In this case, it means we must make sure we are prepared to handle
-    // the, potentially, different subject (the string can switch between
-    // being internal and external, and even between being ASCII and UC16,
-    // but the characters are always the same).
-    IrregexpPrepare(regexp, subject);
-  } while (true);
-  UNREACHABLE();
-  return RE_EXCEPTION;
-#else  // V8_INTERPRETED_REGEXP
+  if (!FLAG_regexp_interpret_all) {
+    ASSERT(output.length() >=
+        (IrregexpNumberOfCaptures(*irregexp) + 1) * 2);
+    do {
+      bool is_ascii = subject->IsAsciiRepresentation();
+      Handle<Code> code(IrregexpNativeCode(*irregexp, is_ascii));
+      NativeRegExpMacroAssembler::Result res =
+          NativeRegExpMacroAssembler::Match(code,
+                                            subject,
+                                            output.start(),
+                                            output.length(),
+                                            index,
+                                            regexp->GetIsolate());
+      if (res == NativeRegExpMacroAssembler::BACKTRACK_LIMIT) {
+        return IrregexpExecNfa(regexp, subject, index, output);
+      }
+      if (res != NativeRegExpMacroAssembler::RETRY) {
+        ASSERT(res != NativeRegExpMacroAssembler::EXCEPTION ||
+               Isolate::Current()->has_pending_exception());
+        STATIC_ASSERT(static_cast<int>(NativeRegExpMacroAssembler::SUCCESS)
+                      == RE_SUCCESS);
+        STATIC_ASSERT(static_cast<int>(NativeRegExpMacroAssembler::FAILURE)
+                      == RE_FAILURE);
+        STATIC_ASSERT(static_cast<int>(NativeRegExpMacroAssembler::EXCEPTION)
+                      == RE_EXCEPTION);
+        return static_cast<IrregexpResult>(res);
+      }
+      // If result is RETRY, the string has changed representation, and we
+      // must restart from scratch.
+      // In this case, it means we must make sure we are prepared to handle
+      // the, potentially, different subject (the string can switch between
+      // being internal and external, and even between being ASCII and UC16,
+      // but the characters are always the same).
+      IrregexpPrepare(regexp, subject);
+    } while (true);
+    UNREACHABLE();
+    return RE_EXCEPTION;
+  }
+#endif  // V8_INTERPRETED_REGEXP
 
   ASSERT(output.length() >= IrregexpNumberOfRegisters(*irregexp));
   bool is_ascii = subject->IsAsciiRepresentation();
@@ -498,17 +574,52 @@ RegExpImpl::IrregexpResult RegExpImpl::IrregexpExecOnce(
   }
   Handle<ByteArray> byte_codes(IrregexpByteCode(*irregexp, is_ascii));
 
-  if (IrregexpInterpreter::Match(byte_codes,
+  if (IrregexpInterpreter::Match(regexp->GetIsolate(),
+                                 byte_codes,
                                  subject,
                                  register_vector,
                                  index)) {
     return RE_SUCCESS;
   }
   return RE_FAILURE;
-#endif  // V8_INTERPRETED_REGEXP
 }
 
 
+#ifndef V8_INTERPRETED_REGEXP
+RegExpImpl::IrregexpResult RegExpImpl::IrregexpExecNfa(
+    Handle<JSRegExp> regexp,
+    Handle<String> subject,
+    int index,
+    Vector<int32_t> output) {
+  Isolate* isolate = regexp->GetIsolate();
+  isolate->counters()->regexp_nfa_fallbacks()->Increment();
+  CompilationZoneScope zone_scope(DELETE_ON_EXIT);
+  JSRegExp::Flags flags = regexp->GetFlags();
+  Handle<String> pattern(regexp->Pattern());
+  if (!pattern->IsFlat()) {
+    FlattenString(pattern);
+  }
+
+  // The pattern was parsed successfully when it was compiled, so only
+  // running out of stack can make the parser fail now.
+  RegExpCompileData compile_data;
+  FlatStringReader reader(isolate, pattern);
+  if (!RegExpParser::ParseRegExp(&reader,
+                                 flags.is_multiline(),
+                                 &compile_data)) {
+    isolate->StackOverflow();
+    return RE_EXCEPTION;
+  }
+  // The native code only gives up on patterns that RegExpNfa accepts.
+  RegExpNfa* nfa = RegExpNfa::Compile(compile_data.tree,
+                                      compile_data.capture_count,
+                                      flags.is_ignore_case());
+  ASSERT(nfa != NULL);
+  return nfa->Match(subject, index, output) ? RE_SUCCESS : RE_FAILURE;
+}
+#endif  // V8_INTERPRETED_REGEXP
+
+
 Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
                                         Handle<String> subject,
                                         int previous_index,
@@ -516,14 +627,12 @@ Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
   ASSERT_EQ(jsregexp->TypeTag(), JSRegExp::IRREGEXP);
 
   // Prepare space for the return values.
-#ifdef V8_INTERPRETED_REGEXP
 #ifdef DEBUG
   if (FLAG_trace_regexp_bytecodes) {
     String* pattern = jsregexp->Pattern();
     PrintF("\n\nRegexp match:   /%s/\n\n", *(pattern->ToCString()));
     PrintF("\n\nSubject string: '%s'\n\n", *(subject->ToCString()));
   }
-#endif
 #endif
   int required_registers = RegExpImpl::IrregexpPrepare(jsregexp, subject);
   if (required_registers < 0) {
@@ -5268,6 +5377,30 @@ void DispatchTableConstructor::VisitAction(ActionNode* that) {
 }
 
 
+// Generates the code for a node network with the given assembler.
+static RegExpEngine::CompilationResult Assemble(
+    RegExpCompiler* compiler,
+    RegExpMacroAssembler* macro_assembler,
+    RegExpNode* node,
+    RegExpCompileData* data,
+    Handle<String> pattern) {
+  // Inserted here, instead of in Assembler, because it depends on information
+  // in the AST that isn't replicated in the Node structure.
+  static const int kMaxBacksearchLimit = 1024;
+  int max_length = data->tree->max_match();
+  if (data->tree->IsAnchoredAtEnd() &&
+      !data->tree->IsAnchoredAtStart() &&
+      max_length < kMaxBacksearchLimit) {
+    macro_assembler->SetCurrentPositionFromEnd(max_length);
+  }
+
+  return compiler->Assemble(macro_assembler,
+                            node,
+                            data->capture_count,
+                            pattern);
+}
+
+
 RegExpEngine::CompilationResult RegExpEngine::Compile(RegExpCompileData* data,
                                                       bool ignore_case,
                                                       bool is_multiline,
@@ -5283,9 +5416,7 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(RegExpCompileData* data,
                                                     &compiler,
                                                     compiler.accept());
   RegExpNode* node = captured_body;
-  bool is_end_anchored = data->tree->IsAnchoredAtEnd();
   bool is_start_anchored = data->tree->IsAnchoredAtStart();
-  int max_length = data->tree->max_match();
   if (!is_start_anchored) {
     // Add a .*? at the beginning, outside the body capture, unless
     // this expression is anchored at the beginning.
@@ -5322,39 +5453,41 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(RegExpCompileData* data,
 
   // Create the correct assembler for the architecture.
 #ifndef V8_INTERPRETED_REGEXP
-  // Native regexp implementation.
+  if (!FLAG_regexp_interpret_all) {
+    // Native regexp implementation.
 
-  NativeRegExpMacroAssembler::Mode mode =
-      is_ascii ? NativeRegExpMacroAssembler::ASCII
-               : NativeRegExpMacroAssembler::UC16;
+    NativeRegExpMacroAssembler::Mode mode =
+        is_ascii ? NativeRegExpMacroAssembler::ASCII
+                 : NativeRegExpMacroAssembler::UC16;
 
 #if V8_TARGET_ARCH_IA32
-  RegExpMacroAssemblerIA32 macro_assembler(mode, (data->capture_count + 1) * 2);
+    RegExpMacroAssemblerIA32 macro_assembler(mode,
+                                             (data->capture_count + 1) * 2);
 #elif V8_TARGET_ARCH_X64
-  RegExpMacroAssemblerX64 macro_assembler(mode, (data->capture_count + 1) * 2);
+    RegExpMacroAssemblerX64 macro_assembler(mode,
+                                            (data->capture_count + 1) * 2);
 #elif V8_TARGET_ARCH_ARM
-  RegExpMacroAssemblerARM macro_assembler(mode, (data->capture_count + 1) * 2);
+    RegExpMacroAssemblerARM macro_assembler(mode,
+                                            (data->capture_count + 1) * 2);
 #endif
 
-#else  // V8_INTERPRETED_REGEXP
-  // Interpreted regexp implementation.
-  EmbeddedVector<byte, 1024> codes;
-  RegExpMacroAssemblerIrregexp macro_assembler(codes);
-#endif  // V8_INTERPRETED_REGEXP
+    // Patterns that an automaton can match give up after a number of
+    // backtracks, and the match is redone by RegExpNfa in linear time.
+    if (FLAG_regexp_backtrack_limit > 0 &&
+        RegExpNfa::Compile(data->tree,
+                           data->capture_count,
+                           ignore_case) != NULL) {
+      macro_assembler.set_backtrack_limit(FLAG_regexp_backtrack_limit);
+    }
 
-  // Inserted here, instead of in Assembler, because it depends on information
-  // in the AST that isn't replicated in the Node structure.
-  static const int kMaxBacksearchLimit = 1024;
-  if (is_end_anchored &&
-      !is_start_anchored &&
-      max_length < kMaxBacksearchLimit) {
-    macro_assembler.SetCurrentPositionFromEnd(max_length);
+    return Assemble(&compiler, &macro_assembler, node, data, pattern);
   }
+#endif  // V8_INTERPRETED_REGEXP
 
-  return compiler.Assemble(&macro_assembler,
-                           node,
-                           data->capture_count,
-                           pattern);
+  // Interpreted regexp implementation.
+  EmbeddedVector<byte, 1024> codes;
+  RegExpMacroAssemblerIrregexp macro_assembler(codes);
+  return Assemble(&compiler, &macro_assembler, node, data, pattern);
 }
 
 
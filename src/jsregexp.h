@@ -45,7 +45,7 @@ class RegExpImpl {
 #ifdef V8_INTERPRETED_REGEXP
     return false;
 #else
-    return true;
+    return !FLAG_regexp_interpret_all;
 #endif
   }
 
@@ -125,6 +125,11 @@ class RegExpImpl {
                                      int index,
                                      Handle<JSArray> lastMatchInfo);
 
+  // Subjects at least this long are matched in the runtime system rather
+  // than directly from generated code if the regexp has a literal to
+  // search for.
+  static const int kLiteralSearchMinSubjectLength = 256;
+
   // Array index in the lastMatchInfo array.
   static const int kLastCaptureCount = 0;
   static const int kLastSubject = 1;
@@ -182,6 +187,13 @@ class RegExpImpl {
   static bool CompileIrregexp(Handle<JSRegExp> re, bool is_ascii);
   static inline bool EnsureCompiledIrregexp(Handle<JSRegExp> re, bool is_ascii);
 
+  // Redoes a match whose native code ran out of its backtrack budget with
+  // the linear-time RegExpNfa matcher.
+  static IrregexpResult IrregexpExecNfa(Handle<JSRegExp> regexp,
+                                        Handle<String> subject,
+                                        int index,
+                                        Vector<int32_t> output);
+
 
   // Set the subject cache.  The previous string buffer is not deleted, so the
   // caller should ensure that it doesn't leak.
@@ -34,11 +34,20 @@
 #include "ic-inl.h"
 #include "mark-compact.h"
 #include "objects-visiting.h"
+#include "serialize.h"
 #include "stub-cache.h"
 
 namespace v8 {
 namespace internal {
 
+// All inline caches and the stub cache are flushed on request, and when
+// building a snapshot which must not capture stubs specialized for the
+// objects of one context.
+static bool FlushAllICs() {
+  return FLAG_cleanup_ics_at_gc || Serializer::enabled();
+}
+
+
 // -------------------------------------------------------------------------
 // MarkCompactCollector
 
@@ -150,11 +159,14 @@ void MarkCompactCollector::Finish() {
   ASSERT(state_ == SWEEP_SPACES || state_ == RELOCATE_OBJECTS);
   state_ = IDLE;
 #endif
-  // The stub cache is not traversed during GC; clear the cache to
-  // force lazy re-initialization of it. This must be done after the
-  // GC, because it relies on the new address of certain old space
+  // The stub cache is not traversed during GC.  Its dead entries were
+  // dropped after marking, but if objects have moved the whole cache is
+  // cleared to force lazy re-initialization of it.  This must be done after
+  // the GC, because it relies on the new address of certain old space
   // objects (empty string, illegal builtin).
-  Isolate::Current()->stub_cache()->Clear();
+  if (FlushAllICs() || HasCompacted()) {
+    Isolate::Current()->stub_cache()->Clear();
+  }
 
   heap_->external_string_table_.CleanUp();
 
@@ -275,6 +287,11 @@ class StaticMarkingVisitor : public StaticVisitorBase {
                                       ConsString::BodyDescriptor,
                                       void>::Visit);
 
+    table_.Register(kVisitSlicedString,
+                    &FixedBodyVisitor<StaticMarkingVisitor,
+                                      SlicedString::BodyDescriptor,
+                                      void>::Visit);
+
 
     table_.Register(kVisitFixedArray,
                     &FlexibleBodyVisitor<StaticMarkingVisitor,
@@ -289,6 +306,7 @@ class StaticMarkingVisitor : public StaticVisitorBase {
     table_.Register(kVisitSharedFunctionInfo, &VisitSharedFunctionInfo);
 
     table_.Register(kVisitByteArray, &DataObjectVisitor::Visit);
+    table_.Register(kVisitFixedDoubleArray, &DataObjectVisitor::Visit);
     table_.Register(kVisitSeqAsciiString, &DataObjectVisitor::Visit);
     table_.Register(kVisitSeqTwoByteString, &DataObjectVisitor::Visit);
 
@@ -340,10 +358,14 @@ class StaticMarkingVisitor : public StaticVisitorBase {
   static inline void VisitCodeTarget(RelocInfo* rinfo) {
     ASSERT(RelocInfo::IsCodeTarget(rinfo->rmode()));
     Code* code = Code::GetCodeFromTargetAddress(rinfo->target_address());
-    if (FLAG_cleanup_ics_at_gc && code->is_inline_cache_stub()) {
+    if (FlushAllICs() && code->is_inline_cache_stub()) {
       IC::Clear(rinfo->pc());
       // Please note targets for cleared inline cached do not have to be
       // marked since they are contained in HEAP->non_monomorphic_cache().
+    } else if (code->is_inline_cache_stub()) {
+      // Whether the target survives depends on the maps it was compiled
+      // for, which are not all known to be live yet.
+      HEAP->mark_compact_collector()->RecordICSite(rinfo->pc());
     } else {
       HEAP->mark_compact_collector()->MarkObject(code);
     }
@@ -785,7 +807,7 @@ void MarkCompactCollector::MarkUnmarkedObject(HeapObject* object) {
   ASSERT(HEAP->Contains(object));
   if (object->IsMap()) {
     Map* map = Map::cast(object);
-    if (FLAG_cleanup_caches_in_maps_at_gc) {
+    if (FLAG_cleanup_caches_in_maps_at_gc || Serializer::enabled()) {
       map->ClearCodeCache(heap_);
     }
     SetMark(map);
@@ -1053,6 +1075,66 @@ void MarkCompactCollector::ProcessMarkingStack() {
 }
 
 
+bool MarkCompactCollector::HasLiveEmbeddedObjects(Code* stub) {
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT);
+  for (RelocIterator it(stub, mode_mask); !it.done(); it.next()) {
+    Object* object = it.rinfo()->target_object();
+    if (object->IsHeapObject() && !HeapObject::cast(object)->IsMarked()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void MarkCompactCollector::ProcessICSites() {
+  ASSERT(marking_stack_.is_empty());
+  int retained = 0;
+  int cleared = 0;
+
+  // An inlined fast case embeds its map in the calling code, where it has
+  // already been marked.  Reset such sites completely so that the map is
+  // not kept alive beyond the next collection.
+  for (int i = 0; i < ic_sites_.length(); i++) {
+    if (IC::ClearIfInlined(ic_sites_[i])) {
+      ic_sites_[i] = NULL;
+      cleared++;
+    }
+  }
+
+  // A target is only kept if everything it embeds is live without it, so
+  // an inline cache can never keep a dead map or global object alive.
+  // Marking a target may still mark the stubs it calls into, so repeat
+  // until nothing changes.
+  bool work_to_do = true;
+  while (work_to_do) {
+    work_to_do = false;
+    for (int i = 0; i < ic_sites_.length(); i++) {
+      Address pc = ic_sites_[i];
+      if (pc == NULL) continue;
+      Code* target =
+          Code::GetCodeFromTargetAddress(Assembler::target_address_at(pc));
+      if (!target->IsMarked()) {
+        if (!HasLiveEmbeddedObjects(target)) continue;
+        MarkObject(target);
+        ProcessMarkingStack();
+        work_to_do = true;
+      }
+      ic_sites_[i] = NULL;
+      retained++;
+    }
+  }
+
+  for (int i = 0; i < ic_sites_.length(); i++) {
+    if (ic_sites_[i] == NULL) continue;
+    IC::Clear(ic_sites_[i]);
+    cleared++;
+  }
+  ic_sites_.Clear();
+  tracer_->set_ic_sites(retained, cleared);
+}
+
+
 void MarkCompactCollector::ProcessObjectGroups() {
   bool work_to_do = true;
   ASSERT(marking_stack_.is_empty());
@@ -1106,6 +1188,15 @@ void MarkCompactCollector::MarkLiveObjects() {
   // weak roots.
   ProcessObjectGroups();
 
+  // Keep the inline caches whose maps are still alive and clear the rest.
+  ProcessICSites();
+
+  // Drop the stub cache entries referring to dead names or stubs.  The
+  // remaining entries stay valid unless objects are moved.
+  if (!FlushAllICs()) {
+    heap_->isolate_->stub_cache()->ClearDeadEntries(&IsUnmarkedHeapObject);
+  }
+
   // Prune the symbol table removing all symbols only pointed to by the
   // symbol table.  Cannot use symbol_table() here because the symbol
   // table is marked.
@@ -225,6 +225,10 @@ class MarkCompactCollector {
   // collection (NULL before and after).
   GCTracer* tracer_;
 
+  // Inline cache call sites found during marking.  They are resolved by
+  // ProcessICSites() once the rest of the heap has been marked.
+  List<Address> ic_sites_;
+
   // Finishes GC, performs heap verification if enabled.
   void Finish();
 
@@ -284,6 +288,19 @@ class MarkCompactCollector {
   // groups, and repeat.
   void ProcessObjectGroups();
 
+  // Record an inline cache call site.  Its target is only kept alive if the
+  // maps and other objects the target stub depends on survive the
+  // collection without it.
+  void RecordICSite(Address pc) { ic_sites_.Add(pc); }
+
+  // Mark the targets of the recorded inline cache sites whose embedded
+  // objects are all marked, until no further targets become live, and reset
+  // the remaining sites to their initial state.
+  void ProcessICSites();
+
+  // Test whether all objects embedded in an inline cache stub are marked.
+  static bool HasLiveEmbeddedObjects(Code* stub);
+
   // Mark objects reachable (transitively) from objects in the marking stack
   // or overflowed in the heap.
   void ProcessMarkingStack();
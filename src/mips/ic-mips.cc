@@ -137,17 +137,17 @@ void LoadIC::GenerateMiss(MacroAssembler* masm) {
 }
 
 
-void LoadIC::ClearInlinedVersion(Address address) {}
+bool LoadIC::ClearInlinedVersion(Address address) { return false; }
 bool LoadIC::PatchInlinedLoad(Address address, Object* map, int offset) {
   return false;
 }
 
-void KeyedLoadIC::ClearInlinedVersion(Address address) {}
+bool KeyedLoadIC::ClearInlinedVersion(Address address) { return false; }
 bool KeyedLoadIC::PatchInlinedLoad(Address address, Object* map) {
   return false;
 }
 
-void KeyedStoreIC::ClearInlinedVersion(Address address) {}
+bool KeyedStoreIC::ClearInlinedVersion(Address address) { return false; }
 void KeyedStoreIC::RestoreInlinedVersion(Address address) {}
 bool KeyedStoreIC::PatchInlinedStore(Address address, Object* map) {
   return false;
@@ -121,6 +121,9 @@ void HeapObject::HeapObjectPrint() {
     case BYTE_ARRAY_TYPE:
       ByteArray::cast(this)->ByteArrayPrint();
       break;
+    case FIXED_DOUBLE_ARRAY_TYPE:
+      FixedDoubleArray::cast(this)->FixedDoubleArrayPrint();
+      break;
     case PIXEL_ARRAY_TYPE:
       PixelArray::cast(this)->PixelArrayPrint();
       break;
@@ -221,6 +224,9 @@ void HeapObject::HeapObjectVerify() {
     case BYTE_ARRAY_TYPE:
       ByteArray::cast(this)->ByteArrayVerify();
       break;
+    case FIXED_DOUBLE_ARRAY_TYPE:
+      FixedDoubleArray::cast(this)->FixedDoubleArrayVerify();
+      break;
     case PIXEL_ARRAY_TYPE:
       PixelArray::cast(this)->PixelArrayVerify();
       break;
@@ -458,6 +464,17 @@ void JSObject::PrintElements() {
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* p = FixedDoubleArray::cast(elements());
+      for (int i = 0; i < p->length(); i++) {
+        if (p->is_the_hole(i)) {
+          PrintF("   %d: <the hole>\n", i);
+        } else {
+          PrintF("   %d: %g\n", i, p->get_scalar(i));
+        }
+      }
+      break;
+    }
     case PIXEL_ELEMENTS: {
       PixelArray* p = PixelArray::cast(elements());
       for (int i = 0; i < p->length(); i++) {
@@ -550,6 +567,7 @@ void JSObject::JSObjectVerify() {
          (elements()->map() == GetHeap()->fixed_array_map() ||
           elements()->map() == GetHeap()->fixed_cow_array_map()));
   ASSERT(map()->has_fast_elements() == HasFastElements());
+  if (HasFastDoubleElements()) CHECK(IsJSArray());
 }
 
 
@@ -572,8 +590,11 @@ static const char* TypeToString(InstanceType type) {
     case EXTERNAL_ASCII_STRING_TYPE:
     case EXTERNAL_STRING_WITH_ASCII_DATA_TYPE:
     case EXTERNAL_STRING_TYPE: return "EXTERNAL_STRING";
+    case SLICED_STRING_TYPE:
+    case SLICED_ASCII_STRING_TYPE: return "SLICED_STRING";
     case FIXED_ARRAY_TYPE: return "FIXED_ARRAY";
     case BYTE_ARRAY_TYPE: return "BYTE_ARRAY";
+    case FIXED_DOUBLE_ARRAY_TYPE: return "FIXED_DOUBLE_ARRAY";
     case PIXEL_ARRAY_TYPE: return "PIXEL_ARRAY";
     case EXTERNAL_BYTE_ARRAY_TYPE: return "EXTERNAL_BYTE_ARRAY";
     case EXTERNAL_UNSIGNED_BYTE_ARRAY_TYPE:
@@ -696,6 +717,32 @@ void FixedArray::FixedArrayPrint() {
 }
 
 
+void FixedDoubleArray::FixedDoubleArrayPrint() {
+  HeapObject::PrintHeader("FixedDoubleArray");
+  PrintF(" - length: %d", length());
+  for (int i = 0; i < length(); i++) {
+    if (is_the_hole(i)) {
+      PrintF("\n  [%d]: <the hole>", i);
+    } else {
+      PrintF("\n  [%d]: %g", i, get_scalar(i));
+    }
+  }
+  PrintF("\n");
+}
+
+
+void FixedDoubleArray::FixedDoubleArrayVerify() {
+  ASSERT(IsFixedDoubleArray());
+  for (int i = 0; i < length(); i++) {
+    if (!is_the_hole(i) && isnan(get_scalar(i))) {
+      // Only the canonical NaN is stored besides the hole.
+      CHECK(BitCast<uint64_t>(get_scalar(i)) ==
+            BitCast<uint64_t>(canonical_not_the_hole_nan_as_double()));
+    }
+  }
+}
+
+
 void FixedArray::FixedArrayVerify() {
   for (int i = 0; i < length(); i++) {
     Object* e = get(i);
@@ -727,6 +774,8 @@ void String::StringPrint() {
     PrintF("#");
   } else if (StringShape(this).IsCons()) {
     PrintF("c\"");
+  } else if (StringShape(this).IsSliced()) {
+    PrintF("s\"");
   } else {
     PrintF("\"");
   }
@@ -745,6 +794,14 @@ void String::StringVerify() {
   if (IsSymbol()) {
     CHECK(!HEAP->InNewSpace(this));
   }
+  if (StringShape(this).IsSliced()) {
+    SlicedString* slice = SlicedString::cast(this);
+    String* parent = slice->parent();
+    CHECK(parent->IsSeqString() || parent->IsExternalString());
+    CHECK(slice->offset() >= 0 &&
+          slice->offset() + length() <= parent->length());
+    CHECK(length() >= SlicedString::kMinLength);
+  }
 }
 
 
@@ -927,7 +984,13 @@ void Code::CodeVerify() {
 void JSArray::JSArrayVerify() {
   JSObjectVerify();
   ASSERT(length()->IsNumber() || length()->IsUndefined());
-  ASSERT(elements()->IsUndefined() || elements()->IsFixedArray());
+  ASSERT(elements()->IsUndefined() ||
+         elements()->IsFixedArray() ||
+         elements()->IsFixedDoubleArray());
+  if (elements()->IsFixedDoubleArray() && length()->IsSmi()) {
+    CHECK(Smi::cast(length())->value() <=
+          FixedDoubleArray::cast(elements())->length());
+  }
 }
 
 
@@ -955,6 +1018,9 @@ void JSRegExp::JSRegExpVerify() {
           (is_native ? uc16_data->IsCode() : uc16_data->IsByteArray()));
       ASSERT(arr->get(JSRegExp::kIrregexpCaptureCountIndex)->IsSmi());
       ASSERT(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)->IsSmi());
+      ASSERT(arr->get(JSRegExp::kIrregexpLiteralIndex)->IsUndefined() ||
+             arr->get(JSRegExp::kIrregexpLiteralIndex)->IsString());
+      ASSERT(arr->get(JSRegExp::kIrregexpLiteralOffsetIndex)->IsSmi());
       break;
     }
     default:
@@ -1267,6 +1333,18 @@ void JSObject::IncrementSpillStatistics(SpillInformation* info) {
       info->number_of_fast_unused_elements_ += holes;
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      info->number_of_objects_with_fast_elements_++;
+      int holes = 0;
+      FixedDoubleArray* e = FixedDoubleArray::cast(elements());
+      int len = e->length();
+      for (int i = 0; i < len; i++) {
+        if (e->is_the_hole(i)) holes++;
+      }
+      info->number_of_fast_used_elements_   += len - holes;
+      info->number_of_fast_unused_elements_ += holes;
+      break;
+    }
     case PIXEL_ELEMENTS: {
       info->number_of_objects_with_fast_elements_++;
       PixelArray* e = PixelArray::cast(elements());
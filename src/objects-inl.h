@@ -179,6 +179,14 @@ bool Object::IsConsString() {
 }
 
 
+bool Object::IsSlicedString() {
+  if (!this->IsHeapObject()) return false;
+  uint32_t type = HeapObject::cast(this)->map()->instance_type();
+  return (type & (kIsNotStringMask | kStringRepresentationMask)) ==
+         (kStringTag | kSlicedStringTag);
+}
+
+
 bool Object::IsSeqString() {
   if (!IsString()) return false;
   return StringShape(String::cast(this)).IsSequential();
@@ -247,14 +255,22 @@ bool StringShape::IsSymbol() {
 }
 
 
+// The characters of a sliced string are those of its parent, which can
+// change its encoding when it is externalized after the slice was made.
 bool String::IsAsciiRepresentation() {
   uint32_t type = map()->instance_type();
+  if ((type & kStringRepresentationMask) == kSlicedStringTag) {
+    return SlicedString::cast(this)->parent()->IsAsciiRepresentation();
+  }
   return (type & kStringEncodingMask) == kAsciiStringTag;
 }
 
 
 bool String::IsTwoByteRepresentation() {
   uint32_t type = map()->instance_type();
+  if ((type & kStringRepresentationMask) == kSlicedStringTag) {
+    return SlicedString::cast(this)->parent()->IsTwoByteRepresentation();
+  }
   return (type & kStringEncodingMask) == kTwoByteStringTag;
 }
 
@@ -271,6 +287,11 @@ bool StringShape::IsCons() {
 }
 
 
+bool StringShape::IsSliced() {
+  return (type_ & kStringRepresentationMask) == kSlicedStringTag;
+}
+
+
 bool StringShape::IsExternal() {
   return (type_ & kStringRepresentationMask) == kExternalStringTag;
 }
@@ -347,6 +368,13 @@ bool Object::IsPixelArray() {
 }
 
 
+bool Object::IsFixedDoubleArray() {
+  return Object::IsHeapObject() &&
+      HeapObject::cast(this)->map()->instance_type() ==
+          FIXED_DOUBLE_ARRAY_TYPE;
+}
+
+
 bool Object::IsExternalArray() {
   if (!Object::IsHeapObject())
     return false;
@@ -1214,8 +1242,8 @@ ACCESSORS(JSObject, properties, FixedArray, kPropertiesOffset)
 HeapObject* JSObject::elements() {
   Object* array = READ_FIELD(this, kElementsOffset);
   // In the assert below Dictionary is covered under FixedArray.
-  ASSERT(array->IsFixedArray() || array->IsPixelArray() ||
-         array->IsExternalArray());
+  ASSERT(array->IsFixedArray() || array->IsFixedDoubleArray() ||
+         array->IsPixelArray() || array->IsExternalArray());
   return reinterpret_cast<HeapObject*>(array);
 }
 
@@ -1225,8 +1253,8 @@ void JSObject::set_elements(HeapObject* value, WriteBarrierMode mode) {
          (value->map() == GetHeap()->fixed_array_map() ||
           value->map() == GetHeap()->fixed_cow_array_map()));
   // In the assert below Dictionary is covered under FixedArray.
-  ASSERT(value->IsFixedArray() || value->IsPixelArray() ||
-         value->IsExternalArray());
+  ASSERT(value->IsFixedArray() || value->IsFixedDoubleArray() ||
+         value->IsPixelArray() || value->IsExternalArray());
   WRITE_FIELD(this, kElementsOffset, value);
   CONDITIONAL_WRITE_BARRIER(GetHeap(), this, kElementsOffset, mode);
 }
@@ -1542,6 +1570,65 @@ void FixedArray::set_the_hole(int index) {
 }
 
 
+double FixedDoubleArray::hole_nan_as_double() {
+  return BitCast<double, uint64_t>(
+      static_cast<uint64_t>(kHoleNanUpper32) << 32 | kHoleNanLower32);
+}
+
+
+double FixedDoubleArray::canonical_not_the_hole_nan_as_double() {
+  ASSERT(BitCast<uint64_t>(OS::nan_value()) !=
+         BitCast<uint64_t>(hole_nan_as_double()));
+  return OS::nan_value();
+}
+
+
+double FixedDoubleArray::get_scalar(int index) {
+  ASSERT(index >= 0 && index < this->length());
+  return READ_DOUBLE_FIELD(this, kHeaderSize + index * kDoubleSize);
+}
+
+
+MaybeObject* FixedDoubleArray::get(int index) {
+  if (is_the_hole(index)) return GetHeap()->the_hole_value();
+  return GetHeap()->NumberFromDouble(get_scalar(index));
+}
+
+
+void FixedDoubleArray::set(int index, double value) {
+  ASSERT(index >= 0 && index < this->length());
+  if (isnan(value)) value = canonical_not_the_hole_nan_as_double();
+  WRITE_DOUBLE_FIELD(this, kHeaderSize + index * kDoubleSize, value);
+}
+
+
+void FixedDoubleArray::set_the_hole(int index) {
+  ASSERT(index >= 0 && index < this->length());
+  WRITE_DOUBLE_FIELD(this, kHeaderSize + index * kDoubleSize,
+                     hole_nan_as_double());
+}
+
+
+bool FixedDoubleArray::is_the_hole(int index) {
+  return BitCast<uint64_t>(get_scalar(index)) ==
+      BitCast<uint64_t>(hole_nan_as_double());
+}
+
+
+void FixedDoubleArray::Initialize(FixedArray* from) {
+  int length = Min(from->length(), this->length());
+  for (int i = 0; i < length; i++) {
+    Object* element = from->get(i);
+    if (element->IsTheHole()) {
+      set_the_hole(i);
+    } else {
+      set(i, element->Number());
+    }
+  }
+  for (int i = length; i < this->length(); i++) set_the_hole(i);
+}
+
+
 void FixedArray::set_unchecked(int index, Smi* value) {
   ASSERT(reinterpret_cast<Object*>(value)->IsSmi());
   int offset = kHeaderSize + index * kPointerSize;
@@ -1780,6 +1867,7 @@ CAST_ACCESSOR(SeqString)
 CAST_ACCESSOR(SeqAsciiString)
 CAST_ACCESSOR(SeqTwoByteString)
 CAST_ACCESSOR(ConsString)
+CAST_ACCESSOR(SlicedString)
 CAST_ACCESSOR(ExternalString)
 CAST_ACCESSOR(ExternalAsciiString)
 CAST_ACCESSOR(ExternalTwoByteString)
@@ -1802,6 +1890,7 @@ CAST_ACCESSOR(JSRegExp)
 CAST_ACCESSOR(Proxy)
 CAST_ACCESSOR(ByteArray)
 CAST_ACCESSOR(PixelArray)
+CAST_ACCESSOR(FixedDoubleArray)
 CAST_ACCESSOR(ExternalArray)
 CAST_ACCESSOR(ExternalByteArray)
 CAST_ACCESSOR(ExternalUnsignedByteArray)
@@ -1827,6 +1916,7 @@ HashTable<Shape, Key>* HashTable<Shape, Key>::cast(Object* obj) {
 
 SMI_ACCESSORS(FixedArray, length, kLengthOffset)
 SMI_ACCESSORS(ByteArray, length, kLengthOffset)
+SMI_ACCESSORS(FixedDoubleArray, length, kLengthOffset)
 
 INT_ACCESSORS(PixelArray, length, kLengthOffset)
 INT_ACCESSORS(ExternalArray, length, kLengthOffset)
@@ -1885,6 +1975,9 @@ uint16_t String::Get(int index) {
     case kConsStringTag | kAsciiStringTag:
     case kConsStringTag | kTwoByteStringTag:
       return ConsString::cast(this)->ConsStringGet(index);
+    case kSlicedStringTag | kAsciiStringTag:
+    case kSlicedStringTag | kTwoByteStringTag:
+      return SlicedString::cast(this)->SlicedStringGet(index);
     case kExternalStringTag | kAsciiStringTag:
       return ExternalAsciiString::cast(this)->ExternalAsciiStringGet(index);
     case kExternalStringTag | kTwoByteStringTag:
@@ -2008,6 +2101,55 @@ void ConsString::set_second(String* value, WriteBarrierMode mode) {
 }
 
 
+String* SlicedString::parent() {
+  return String::cast(READ_FIELD(this, kParentOffset));
+}
+
+
+Object* SlicedString::unchecked_parent() {
+  return READ_FIELD(this, kParentOffset);
+}
+
+
+void SlicedString::set_parent(String* value, WriteBarrierMode mode) {
+  ASSERT(value->IsSeqString() || value->IsExternalString());
+  WRITE_FIELD(this, kParentOffset, value);
+  CONDITIONAL_WRITE_BARRIER(GetHeap(), this, kParentOffset, mode);
+}
+
+
+SMI_ACCESSORS(SlicedString, offset, kOffsetOffset)
+
+
+StringCharacterCursor::StringCharacterCursor(String* string, int max_steps)
+    : string_(string),
+      leaf_(NULL),
+      leaf_is_ascii_(false),
+      leaf_start_(0),
+      leaf_end_(0),
+      steps_(0),
+      max_steps_(max_steps) {
+}
+
+
+uint16_t StringCharacterCursor::Get(int index) {
+  if (index < leaf_start_ || index >= leaf_end_) {
+    FindLeaf(index);
+    if (leaf_ == NULL) return 0;
+  }
+  int offset = index - leaf_start_;
+  if (leaf_is_ascii_) return static_cast<uint8_t>(ascii_chars_[offset]);
+  return two_byte_chars_[offset];
+}
+
+
+String* StringCharacterCursor::LeafAt(int index, int* leaf_start) {
+  if (index < leaf_start_ || index >= leaf_end_) FindLeaf(index);
+  *leaf_start = leaf_start_;
+  return leaf_;
+}
+
+
 ExternalAsciiString::Resource* ExternalAsciiString::resource() {
   return *reinterpret_cast<Resource**>(FIELD_ADDR(this, kResourceOffset));
 }
@@ -2254,6 +2396,9 @@ int HeapObject::SizeFromMap(Map* map) {
   if (instance_type == BYTE_ARRAY_TYPE) {
     return reinterpret_cast<ByteArray*>(this)->ByteArraySize();
   }
+  if (instance_type == FIXED_DOUBLE_ARRAY_TYPE) {
+    return reinterpret_cast<FixedDoubleArray*>(this)->FixedDoubleArraySize();
+  }
   if (instance_type == STRING_TYPE) {
     return SeqTwoByteString::SizeFor(
         reinterpret_cast<SeqTwoByteString*>(this)->length());
@@ -3217,6 +3362,7 @@ JSObject::ElementsKind JSObject::GetElementsKind() {
     return FAST_ELEMENTS;
   }
   HeapObject* array = elements();
+  if (array->IsFixedDoubleArray()) return FAST_DOUBLE_ELEMENTS;
   if (array->IsFixedArray()) {
     // FAST_ELEMENTS or DICTIONARY_ELEMENTS are both stored in a
     // FixedArray, but FAST_ELEMENTS is already handled above.
@@ -3253,6 +3399,11 @@ bool JSObject::HasFastElements() {
 }
 
 
+bool JSObject::HasFastDoubleElements() {
+  return GetElementsKind() == FAST_DOUBLE_ELEMENTS;
+}
+
+
 bool JSObject::HasDictionaryElements() {
   return GetElementsKind() == DICTIONARY_ELEMENTS;
 }
@@ -3320,7 +3471,8 @@ bool JSObject::HasIndexedInterceptor() {
 
 
 bool JSObject::AllowsSetElementsLength() {
-  bool result = elements()->IsFixedArray();
+  bool result = elements()->IsFixedArray() ||
+      elements()->IsFixedDoubleArray();
   ASSERT(result == (!HasPixelElements() && !HasExternalArrayElements()));
   return result;
 }
@@ -3426,6 +3578,51 @@ void StringHasher::AddCharacterNoIndex(uc32 c) {
 }
 
 
+template <typename schar>
+void StringHasher::AddCharactersNoIndex(const schar* chars, int length) {
+  ASSERT(!is_array_index());
+  uint32_t running_hash = raw_running_hash_;
+  int i = 0;
+  // Jenkins one-at-a-time hash, four characters per iteration.
+  for (; i + 4 <= length; i += 4) {
+    running_hash += chars[i];
+    running_hash += (running_hash << 10);
+    running_hash ^= (running_hash >> 6);
+    running_hash += chars[i + 1];
+    running_hash += (running_hash << 10);
+    running_hash ^= (running_hash >> 6);
+    running_hash += chars[i + 2];
+    running_hash += (running_hash << 10);
+    running_hash ^= (running_hash >> 6);
+    running_hash += chars[i + 3];
+    running_hash += (running_hash << 10);
+    running_hash ^= (running_hash >> 6);
+  }
+  for (; i < length; i++) {
+    running_hash += chars[i];
+    running_hash += (running_hash << 10);
+    running_hash ^= (running_hash >> 6);
+  }
+  raw_running_hash_ = running_hash;
+}
+
+
+template <typename schar>
+uint32_t StringHasher::HashSequentialString(const schar* chars, int length) {
+  StringHasher hasher(length);
+  if (!hasher.has_trivial_hash()) {
+    int i = 0;
+    // Only a string of digits can be an array index, so the array index
+    // calculation ends at the first character of most strings.
+    for (; hasher.is_array_index() && i < length; i++) {
+      hasher.AddCharacter(chars[i]);
+    }
+    if (i < length) hasher.AddCharactersNoIndex(chars + i, length - i);
+  }
+  return hasher.GetHashField();
+}
+
+
 uint32_t StringHasher::GetHash() {
   // Get the calculated raw hash value and do some more bit ops to distribute
   // the hash further. Ensure that we never return zero as the hash value.
@@ -3547,6 +3744,34 @@ void AccessorInfo::set_property_attributes(PropertyAttributes attributes) {
   set_flag(Smi::FromInt(rest_value | AttributesField::encode(attributes)));
 }
 
+
+bool AccessorInfo::is_internal_field_accessor() {
+  return BooleanBit::get(flag(), kIsInternalFieldAccessorBit);
+}
+
+
+void AccessorInfo::set_is_internal_field_accessor(bool value) {
+  set_flag(BooleanBit::set(flag(), kIsInternalFieldAccessorBit, value));
+}
+
+
+v8::InternalFieldAccessorType AccessorInfo::internal_field_type() {
+  ASSERT(is_internal_field_accessor());
+  return InternalFieldTypeField::decode(Smi::cast(data())->value());
+}
+
+
+int AccessorInfo::internal_field_index() {
+  ASSERT(is_internal_field_accessor());
+  return InternalFieldIndexField::decode(Smi::cast(data())->value());
+}
+
+
+int AccessorInfo::internal_field_offset() {
+  ASSERT(is_internal_field_accessor());
+  return InternalFieldOffsetField::decode(Smi::cast(data())->value());
+}
+
 template<typename Shape, typename Key>
 void Dictionary<Shape, Key>::SetEntry(int entry,
                                       Object* key,
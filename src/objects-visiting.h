@@ -49,6 +49,7 @@ class StaticVisitorBase : public AllStatic {
     kVisitSeqTwoByteString,
     kVisitShortcutCandidate,
     kVisitByteArray,
+    kVisitFixedDoubleArray,
     kVisitFixedArray,
     kVisitGlobalContext,
 
@@ -96,6 +97,7 @@ class StaticVisitorBase : public AllStatic {
     kVisitStructGeneric,
 
     kVisitConsString,
+    kVisitSlicedString,
     kVisitOddball,
     kVisitCode,
     kVisitMap,
@@ -269,6 +271,11 @@ class StaticNewSpaceVisitor : public StaticVisitorBase {
                                       ConsString::BodyDescriptor,
                                       int>::Visit);
 
+    table_.Register(kVisitSlicedString,
+                    &FixedBodyVisitor<StaticVisitor,
+                                      SlicedString::BodyDescriptor,
+                                      int>::Visit);
+
     table_.Register(kVisitFixedArray,
                     &FlexibleBodyVisitor<StaticVisitor,
                                          FixedArray::BodyDescriptor,
@@ -281,6 +288,8 @@ class StaticNewSpaceVisitor : public StaticVisitorBase {
 
     table_.Register(kVisitByteArray, &VisitByteArray);
 
+    table_.Register(kVisitFixedDoubleArray, &VisitFixedDoubleArray);
+
     table_.Register(kVisitSharedFunctionInfo,
                     &FixedBodyVisitor<StaticVisitor,
                                       SharedFunctionInfo::BodyDescriptor,
@@ -318,6 +327,11 @@ class StaticNewSpaceVisitor : public StaticVisitorBase {
     return reinterpret_cast<ByteArray*>(object)->ByteArraySize();
   }
 
+  static inline int VisitFixedDoubleArray(Map* map, HeapObject* object) {
+    return reinterpret_cast<FixedDoubleArray*>(object)->
+        FixedDoubleArraySize();
+  }
+
   static inline int VisitSeqAsciiString(Map* map, HeapObject* object) {
     return SeqAsciiString::cast(object)->
         SeqAsciiStringSize(map->instance_type());
@@ -961,6 +961,10 @@ void HeapObject::HeapObjectShortPrint(StringStream* accumulator) {
     case BYTE_ARRAY_TYPE:
       accumulator->Add("<ByteArray[%u]>", ByteArray::cast(this)->length());
       break;
+    case FIXED_DOUBLE_ARRAY_TYPE:
+      accumulator->Add("<FixedDoubleArray[%u]>",
+                       FixedDoubleArray::cast(this)->length());
+      break;
     case PIXEL_ARRAY_TYPE:
       accumulator->Add("<PixelArray[%u]>", PixelArray::cast(this)->length());
       break;
@@ -1060,6 +1064,9 @@ void HeapObject::IterateBody(InstanceType type, int object_size,
       case kConsStringTag:
         ConsString::BodyDescriptor::IterateBody(this, v);
         break;
+      case kSlicedStringTag:
+        SlicedString::BodyDescriptor::IterateBody(this, v);
+        break;
       case kExternalStringTag:
         if ((type & kStringEncodingMask) == kAsciiStringTag) {
           reinterpret_cast<ExternalAsciiString*>(this)->
@@ -1117,6 +1124,7 @@ void HeapObject::IterateBody(InstanceType type, int object_size,
     case EXTERNAL_INT_ARRAY_TYPE:
     case EXTERNAL_UNSIGNED_INT_ARRAY_TYPE:
     case EXTERNAL_FLOAT_ARRAY_TYPE:
+    case FIXED_DOUBLE_ARRAY_TYPE:
       break;
     case SHARED_FUNCTION_INFO_TYPE:
       SharedFunctionInfo::BodyDescriptor::IterateBody(this, v);
@@ -2418,7 +2426,7 @@ MaybeObject* JSObject::TransformToFastProperties(int unused_property_fields) {
 MaybeObject* JSObject::NormalizeElements() {
   ASSERT(!HasPixelElements() && !HasExternalArrayElements());
   if (HasDictionaryElements()) return this;
-  ASSERT(map()->has_fast_elements());
+  ASSERT(map()->has_fast_elements() || HasFastDoubleElements());
 
   Object* obj;
   { MaybeObject* maybe_obj = map()->GetSlowElementsMap();
@@ -2427,24 +2435,40 @@ MaybeObject* JSObject::NormalizeElements() {
   Map* new_map = Map::cast(obj);
 
   // Get number of entries.
-  FixedArray* array = FixedArray::cast(elements());
+  FixedDoubleArray* double_array = NULL;
+  FixedArray* array = NULL;
+  int capacity;
+  if (HasFastDoubleElements()) {
+    double_array = FixedDoubleArray::cast(elements());
+    capacity = double_array->length();
+  } else {
+    array = FixedArray::cast(elements());
+    capacity = array->length();
+  }
 
   // Compute the effective length.
   int length = IsJSArray() ?
                Smi::cast(JSArray::cast(this)->length())->value() :
-               array->length();
+               capacity;
   { MaybeObject* maybe_obj = NumberDictionary::Allocate(length);
     if (!maybe_obj->ToObject(&obj)) return maybe_obj;
   }
   NumberDictionary* dictionary = NumberDictionary::cast(obj);
   // Copy entries.
   for (int i = 0; i < length; i++) {
-    Object* value = array->get(i);
+    Object* value;
+    if (double_array != NULL) {
+      { MaybeObject* maybe_value = double_array->get(i);
+        if (!maybe_value->ToObject(&value)) return maybe_value;
+      }
+    } else {
+      value = array->get(i);
+    }
     if (!value->IsTheHole()) {
       PropertyDetails details = PropertyDetails(NONE, NORMAL);
       Object* result;
       { MaybeObject* maybe_result =
-            dictionary->AddNumberEntry(i, array->get(i), details);
+            dictionary->AddNumberEntry(i, value, details);
         if (!maybe_result->ToObject(&result)) return maybe_result;
       }
       dictionary = NumberDictionary::cast(result);
@@ -2537,6 +2561,14 @@ MaybeObject* JSObject::DeleteElementPostInterceptor(uint32_t index,
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      uint32_t length =
+          static_cast<uint32_t>(FixedDoubleArray::cast(elements())->length());
+      if (index < length) {
+        FixedDoubleArray::cast(elements())->set_the_hole(index);
+      }
+      break;
+    }
     case DICTIONARY_ELEMENTS: {
       NumberDictionary* dictionary = element_dictionary();
       int entry = dictionary->FindEntry(index);
@@ -2624,6 +2656,14 @@ MaybeObject* JSObject::DeleteElement(uint32_t index, DeleteMode mode) {
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      uint32_t length =
+          static_cast<uint32_t>(FixedDoubleArray::cast(elements())->length());
+      if (index < length) {
+        FixedDoubleArray::cast(elements())->set_the_hole(index);
+      }
+      break;
+    }
     case PIXEL_ELEMENTS:
     case EXTERNAL_BYTE_ELEMENTS:
     case EXTERNAL_UNSIGNED_BYTE_ELEMENTS:
@@ -2724,6 +2764,7 @@ bool JSObject::ReferencesObject(Object* obj) {
 
   // Check if the object is among the indexed properties.
   switch (GetElementsKind()) {
+    case FAST_DOUBLE_ELEMENTS:
     case PIXEL_ELEMENTS:
     case EXTERNAL_BYTE_ELEMENTS:
     case EXTERNAL_UNSIGNED_BYTE_ELEMENTS:
@@ -2732,8 +2773,8 @@ bool JSObject::ReferencesObject(Object* obj) {
     case EXTERNAL_INT_ELEMENTS:
     case EXTERNAL_UNSIGNED_INT_ELEMENTS:
     case EXTERNAL_FLOAT_ELEMENTS:
-      // Raw pixels and external arrays do not reference other
-      // objects.
+      // Unboxed doubles, raw pixels and external arrays do not reference
+      // other objects.
       break;
     case FAST_ELEMENTS: {
       int length = IsJSArray() ?
@@ -2804,7 +2845,7 @@ bool JSObject::ReferencesObject(Object* obj) {
 
 MaybeObject* JSObject::PreventExtensions() {
   // If there are fast elements we normalize.
-  if (HasFastElements()) {
+  if (HasFastElements() || HasFastDoubleElements()) {
     Object* ok;
     { MaybeObject* maybe_ok = NormalizeElements();
       if (!maybe_ok->ToObject(&ok)) return maybe_ok;
@@ -2979,6 +3020,7 @@ MaybeObject* JSObject::DefineGetterSetter(String* name,
   if (is_element) {
     switch (GetElementsKind()) {
       case FAST_ELEMENTS:
+      case FAST_DOUBLE_ELEMENTS:
         break;
       case PIXEL_ELEMENTS:
       case EXTERNAL_BYTE_ELEMENTS:
@@ -3200,6 +3242,7 @@ MaybeObject* JSObject::DefineAccessor(AccessorInfo* info) {
     // Accessors overwrite previous callbacks (cf. with getters/setters).
     switch (GetElementsKind()) {
       case FAST_ELEMENTS:
+      case FAST_DOUBLE_ELEMENTS:
         break;
       case PIXEL_ELEMENTS:
       case EXTERNAL_BYTE_ELEMENTS:
@@ -3817,6 +3860,35 @@ MaybeObject* FixedArray::AddKeysFromJSArray(JSArray* array) {
       // Compute the union of this and the temporary fixed array.
       return UnionOfKeys(key_array);
     }
+    case JSObject::FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(array->elements());
+      int length = Smi::cast(array->length())->value();
+      int size = 0;
+      for (int i = 0; i < length; i++) {
+        if (!elms->is_the_hole(i)) size++;
+      }
+
+      // Allocate a temporary fixed array.
+      Object* object;
+      { MaybeObject* maybe_object = heap->AllocateFixedArray(size);
+        if (!maybe_object->ToObject(&object)) return maybe_object;
+      }
+      FixedArray* key_array = FixedArray::cast(object);
+
+      // Box the elements of the JSArray into the temporary fixed array.
+      int pos = 0;
+      for (int i = 0; i < length; i++) {
+        if (elms->is_the_hole(i)) continue;
+        Object* number;
+        { MaybeObject* maybe_number =
+              heap->NumberFromDouble(elms->get_scalar(i));
+          if (!maybe_number->ToObject(&number)) return maybe_number;
+        }
+        key_array->set(pos++, number);
+      }
+      // Compute the union of this and the temporary fixed array.
+      return UnionOfKeys(key_array);
+    }
     default:
       UNREACHABLE();
   }
@@ -4080,6 +4152,9 @@ MaybeObject* DescriptorArray::RemoveTransitions() {
   for (int i = 0; i < number_of_descriptors(); i++) {
     if (!IsProperty(i)) num_removed++;
   }
+  // Share the array if there is nothing to remove.  This leaves map
+  // transitions a forest, as no transitions are shared.
+  if (num_removed == 0) return this;
 
   // Allocate the new descriptor array.
   Object* result;
@@ -4230,6 +4305,15 @@ int String::Utf8Length() {
   // so it's still a good idea.
   Heap* heap = GetHeap();
   TryFlatten();
+  if (IsFlat()) {
+    // Read the characters directly instead of through a buffer.
+    Vector<const uc16> chars = ToUC16Vector();
+    int result = 0;
+    for (int i = 0; i < chars.length(); i++) {
+      result += unibrow::Utf8::Length(chars[i]);
+    }
+    return result;
+  }
   Access<StringInputBuffer> buffer(
       heap->isolate()->objects_string_input_buffer());
   buffer->Reset(0, this);
@@ -4254,6 +4338,12 @@ Vector<const char> String::ToAsciiVector() {
     string = cons->first();
     string_tag = StringShape(string).representation_tag();
   }
+  if (string_tag == kSlicedStringTag) {
+    SlicedString* slice = SlicedString::cast(string);
+    offset = slice->offset();
+    string = slice->parent();
+    string_tag = StringShape(string).representation_tag();
+  }
   if (string_tag == kSeqStringTag) {
     SeqAsciiString* seq = SeqAsciiString::cast(string);
     char* start = seq->GetChars();
@@ -4280,6 +4370,12 @@ Vector<const uc16> String::ToUC16Vector() {
     string = cons->first();
     string_tag = StringShape(string).representation_tag();
   }
+  if (string_tag == kSlicedStringTag) {
+    SlicedString* slice = SlicedString::cast(string);
+    offset = slice->offset();
+    string = slice->parent();
+    string_tag = StringShape(string).representation_tag();
+  }
   if (string_tag == kSeqStringTag) {
     SeqTwoByteString* seq = SeqTwoByteString::cast(string);
     return Vector<const uc16>(seq->GetChars() + offset, length);
@@ -4367,6 +4463,10 @@ const uc16* String::GetTwoByteData(unsigned start) {
     case kExternalStringTag:
       return ExternalTwoByteString::cast(this)->
         ExternalTwoByteStringGetData(start);
+    case kSlicedStringTag: {
+      SlicedString* slice = SlicedString::cast(this);
+      return slice->parent()->GetTwoByteData(start + slice->offset());
+    }
     case kConsStringTag:
       UNREACHABLE();
       return NULL;
@@ -4646,6 +4746,10 @@ const unibrow::byte* String::ReadBlock(String* input,
       return ConsString::cast(input)->ConsStringReadBlock(rbb,
                                                           offset_ptr,
                                                           max_chars);
+    case kSlicedStringTag:
+      return SlicedString::cast(input)->SlicedStringReadBlock(rbb,
+                                                              offset_ptr,
+                                                              max_chars);
     case kExternalStringTag:
       if (input->IsAsciiRepresentation()) {
         return ExternalAsciiString::cast(input)->ExternalAsciiStringReadBlock(
@@ -4791,6 +4895,11 @@ void String::ReadBlockIntoBuffer(String* input,
                                                              offset_ptr,
                                                              max_chars);
       return;
+    case kSlicedStringTag:
+      SlicedString::cast(input)->SlicedStringReadBlockIntoBuffer(rbb,
+                                                                 offset_ptr,
+                                                                 max_chars);
+      return;
     case kExternalStringTag:
       if (input->IsAsciiRepresentation()) {
         ExternalAsciiString::cast(input)->
@@ -4936,6 +5045,83 @@ uint16_t ConsString::ConsStringGet(int index) {
 }
 
 
+uint16_t SlicedString::SlicedStringGet(int index) {
+  ASSERT(index >= 0 && index < this->length());
+  return parent()->Get(offset() + index);
+}
+
+
+// A slice reads its characters straight out of its parent, so reading a
+// block of it is reading the corresponding block of the parent.
+const unibrow::byte* SlicedString::SlicedStringReadBlock(ReadBlockBuffer* rbb,
+                                                         unsigned* offset_ptr,
+                                                         unsigned max_chars) {
+  ASSERT(*offset_ptr + max_chars <= static_cast<unsigned>(length()));
+  unsigned offset = this->offset();
+  *offset_ptr += offset;
+  const unibrow::byte* answer =
+      String::ReadBlock(parent(), rbb, offset_ptr, max_chars);
+  *offset_ptr -= offset;
+  return answer;
+}
+
+
+void SlicedString::SlicedStringReadBlockIntoBuffer(ReadBlockBuffer* rbb,
+                                                   unsigned* offset_ptr,
+                                                   unsigned max_chars) {
+  ASSERT(*offset_ptr + max_chars <= static_cast<unsigned>(length()));
+  unsigned offset = this->offset();
+  *offset_ptr += offset;
+  String::ReadBlockIntoBuffer(parent(), rbb, offset_ptr, max_chars);
+  *offset_ptr -= offset;
+}
+
+
+void StringCharacterCursor::FindLeaf(int index) {
+  ASSERT(index >= 0 && index < string_->length());
+  // Walk up to the nearest cons string on the path that covers index.
+  String* string = string_;
+  int start = 0;
+  while (!path_.is_empty()) {
+    PathEntry entry = path_.RemoveLast();
+    if (index >= entry.start &&
+        index - entry.start < entry.cons_string->length()) {
+      string = entry.cons_string;
+      start = entry.start;
+      break;
+    }
+  }
+  // Walk down to the leaf holding index.
+  while (StringShape(string).IsCons()) {
+    if (has_given_up()) {
+      leaf_ = NULL;
+      leaf_start_ = leaf_end_ = 0;
+      return;
+    }
+    ConsString* cons_string = ConsString::cast(string);
+    PathEntry entry = { cons_string, start };
+    path_.Add(entry);
+    steps_++;
+    String* first = cons_string->first();
+    if (index - start < first->length()) {
+      string = first;
+    } else {
+      start += first->length();
+      string = cons_string->second();
+    }
+  }
+  leaf_ = string;
+  leaf_start_ = start;
+  leaf_end_ = start + string->length();
+  leaf_is_ascii_ = string->IsAsciiRepresentation();
+  if (leaf_is_ascii_) {
+    ascii_chars_ = string->ToAsciiVector();
+  } else {
+    two_byte_chars_ = string->ToUC16Vector();
+  }
+}
+
+
 template <typename sinkchar>
 void String::WriteToFlat(String* src,
                          sinkchar* sink,
@@ -5003,6 +5189,13 @@ void String::WriteToFlat(String* src,
         }
         break;
       }
+      case kAsciiStringTag | kSlicedStringTag:
+      case kTwoByteStringTag | kSlicedStringTag: {
+        SlicedString* slice = SlicedString::cast(source);
+        unsigned offset = slice->offset();
+        WriteToFlat(slice->parent(), sink, from + offset, to + offset);
+        return;
+      }
     }
   }
 }
@@ -5189,22 +5382,6 @@ bool String::IsEqualTo(Vector<const char> str) {
 }
 
 
-template <typename schar>
-static inline uint32_t HashSequentialString(const schar* chars, int length) {
-  StringHasher hasher(length);
-  if (!hasher.has_trivial_hash()) {
-    int i;
-    for (i = 0; hasher.is_array_index() && (i < length); i++) {
-      hasher.AddCharacter(chars[i]);
-    }
-    for (; i < length; i++) {
-      hasher.AddCharacterNoIndex(chars[i]);
-    }
-  }
-  return hasher.GetHashField();
-}
-
-
 uint32_t String::ComputeAndSetHash() {
   // Should only be called if hash code has not yet been computed.
   ASSERT(!HasHashCode());
@@ -5214,9 +5391,18 @@ uint32_t String::ComputeAndSetHash() {
   // Compute the hash code.
   uint32_t field = 0;
   if (StringShape(this).IsSequentialAscii()) {
-    field = HashSequentialString(SeqAsciiString::cast(this)->GetChars(), len);
+    field = StringHasher::HashSequentialString(
+        SeqAsciiString::cast(this)->GetChars(), len);
   } else if (StringShape(this).IsSequentialTwoByte()) {
-    field = HashSequentialString(SeqTwoByteString::cast(this)->GetChars(), len);
+    field = StringHasher::HashSequentialString(
+        SeqTwoByteString::cast(this)->GetChars(), len);
+  } else if (StringShape(this).IsSliced()) {
+    // Hash the characters of a slice in place in its parent.
+    if (IsAsciiRepresentation()) {
+      field = StringHasher::HashSequentialString(ToAsciiVector().start(), len);
+    } else {
+      field = StringHasher::HashSequentialString(ToUC16Vector().start(), len);
+    }
   } else {
     StringInputBuffer buffer(this);
     field = ComputeHashField(&buffer, len);
@@ -6013,9 +6199,24 @@ MaybeObject* JSObject::SetFastElementsCapacityAndLength(int capacity,
   }
   Map* new_map = Map::cast(obj);
 
+  if (HasFastDoubleElements()) {
+    // Boxing the doubles allocates, so do it before anything is changed.
+    FixedDoubleArray* old_elements = FixedDoubleArray::cast(elements());
+    int old_length = Min(old_elements->length(), capacity);
+    for (int i = 0; i < old_length; i++) {
+      Object* value;
+      { MaybeObject* maybe_value = old_elements->get(i);
+        if (!maybe_value->ToObject(&value)) return maybe_value;
+      }
+      elems->set(i, value);
+    }
+  }
+
   AssertNoAllocation no_gc;
   WriteBarrierMode mode = elems->GetWriteBarrierMode(no_gc);
   switch (GetElementsKind()) {
+    case FAST_DOUBLE_ELEMENTS:
+      break;
     case FAST_ELEMENTS: {
       FixedArray* old_elements = FixedArray::cast(elements());
       uint32_t old_length = static_cast<uint32_t>(old_elements->length());
@@ -6052,6 +6253,62 @@ MaybeObject* JSObject::SetFastElementsCapacityAndLength(int capacity,
 }
 
 
+MaybeObject* JSObject::SetFastDoubleElementsCapacityAndLength(int capacity,
+                                                              int length) {
+  Heap* heap = GetHeap();
+  ASSERT(IsJSArray());
+  ASSERT(HasFastElements() || HasFastDoubleElements());
+
+  Object* obj;
+  { MaybeObject* maybe_obj =
+        heap->AllocateUninitializedFixedDoubleArray(capacity);
+    if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+  }
+  FixedDoubleArray* elems = FixedDoubleArray::cast(obj);
+
+  { MaybeObject* maybe_obj = map()->GetSlowElementsMap();
+    if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+  }
+  Map* new_map = Map::cast(obj);
+
+  AssertNoAllocation no_gc;
+  if (HasFastElements()) {
+    elems->Initialize(FixedArray::cast(elements()));
+  } else {
+    FixedDoubleArray* old_elements = FixedDoubleArray::cast(elements());
+    int old_length = Min(old_elements->length(), capacity);
+    memcpy(reinterpret_cast<void*>(
+               elems->address() + FixedDoubleArray::kHeaderSize),
+           reinterpret_cast<void*>(
+               old_elements->address() + FixedDoubleArray::kHeaderSize),
+           old_length * kDoubleSize);
+    for (int i = old_length; i < capacity; i++) elems->set_the_hole(i);
+  }
+
+  set_map(new_map);
+  set_elements(elems);
+  JSArray::cast(this)->set_length(Smi::FromInt(length));
+
+  return this;
+}
+
+
+// Arrays whose elements are all numbers, at least one of them not a smi,
+// keep their elements unboxed.
+bool JSObject::ShouldConvertToFastDoubleElements() {
+  if (!FLAG_unbox_double_arrays) return false;
+  if (!IsJSArray() || !HasFastElements()) return false;
+  FixedArray* elms = FixedArray::cast(elements());
+  if (elms->map() != GetHeap()->fixed_array_map()) return false;
+  int length = elms->length();
+  for (int i = 0; i < length; i++) {
+    Object* element = elms->get(i);
+    if (!element->IsNumber() && !element->IsTheHole()) return false;
+  }
+  return true;
+}
+
+
 MaybeObject* JSObject::SetSlowElements(Object* len) {
   // We should never end in here with a pixel or external array.
   ASSERT(!HasPixelElements() && !HasExternalArrayElements());
@@ -6059,6 +6316,16 @@ MaybeObject* JSObject::SetSlowElements(Object* len) {
   uint32_t new_length = static_cast<uint32_t>(len->Number());
 
   switch (GetElementsKind()) {
+    case FAST_DOUBLE_ELEMENTS: {
+      ASSERT(static_cast<uint32_t>(
+          FixedDoubleArray::cast(elements())->length()) <= new_length);
+      Object* obj;
+      { MaybeObject* maybe_obj = NormalizeElements();
+        if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+      }
+      JSArray::cast(this)->set_length(len);
+      break;
+    }
     case FAST_ELEMENTS: {
       // Make sure we never try to shrink dense arrays into sparse arrays.
       ASSERT(static_cast<uint32_t>(FixedArray::cast(elements())->length()) <=
@@ -6178,6 +6445,28 @@ MaybeObject* JSObject::SetElementsLength(Object* len) {
         }
         break;
       }
+      case FAST_DOUBLE_ELEMENTS: {
+        FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+        int old_capacity = elms->length();
+        if (value <= old_capacity) {
+          int old_length = FastD2I(JSArray::cast(this)->length()->Number());
+          for (int i = value; i < old_length; i++) elms->set_the_hole(i);
+          JSArray::cast(this)->set_length(Smi::cast(smi_length));
+          return this;
+        }
+        int min = NewElementsCapacity(old_capacity);
+        int new_capacity = value > min ? value : min;
+        if (new_capacity <= kMaxFastElementsLength ||
+            !ShouldConvertToSlowElements(new_capacity)) {
+          Object* obj;
+          { MaybeObject* maybe_obj =
+                SetFastDoubleElementsCapacityAndLength(new_capacity, value);
+            if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+          }
+          return this;
+        }
+        break;
+      }
       case DICTIONARY_ELEMENTS: {
         if (IsJSArray()) {
           if (value == 0) {
@@ -6221,7 +6510,12 @@ MaybeObject* JSObject::SetElementsLength(Object* len) {
     if (!maybe_obj->ToObject(&obj)) return maybe_obj;
   }
   FixedArray::cast(obj)->set(0, len);
+  Object* new_map;
+  { MaybeObject* maybe_new_map = map()->GetFastElementsMap();
+    if (!maybe_new_map->ToObject(&new_map)) return maybe_new_map;
+  }
   if (IsJSArray()) JSArray::cast(this)->set_length(Smi::FromInt(1));
+  set_map(Map::cast(new_map));
   set_elements(FixedArray::cast(obj));
   return this;
 }
@@ -6287,6 +6581,14 @@ bool JSObject::HasElementPostInterceptor(JSObject* receiver, uint32_t index) {
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      if ((index < static_cast<uint32_t>(elms->length())) &&
+          !elms->is_the_hole(index)) {
+        return true;
+      }
+      break;
+    }
     case PIXEL_ELEMENTS: {
       // TODO(iposva): Add testcase.
       PixelArray* pixels = PixelArray::cast(elements());
@@ -6404,6 +6706,14 @@ JSObject::LocalElementType JSObject::HasLocalElement(uint32_t index) {
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      if ((index < static_cast<uint32_t>(elms->length())) &&
+          !elms->is_the_hole(index)) {
+        return FAST_ELEMENT;
+      }
+      break;
+    }
     case PIXEL_ELEMENTS: {
       PixelArray* pixels = PixelArray::cast(elements());
       if (index < static_cast<uint32_t>(pixels->length())) return FAST_ELEMENT;
@@ -6461,6 +6771,12 @@ bool JSObject::HasElementWithReceiver(JSObject* receiver, uint32_t index) {
           !FixedArray::cast(elements())->get(index)->IsTheHole()) return true;
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      if ((index < static_cast<uint32_t>(elms->length())) &&
+          !elms->is_the_hole(index)) return true;
+      break;
+    }
     case PIXEL_ELEMENTS: {
       PixelArray* pixels = PixelArray::cast(elements());
       if (index < static_cast<uint32_t>(pixels->length())) {
@@ -6680,6 +6996,16 @@ MaybeObject* JSObject::SetFastElement(uint32_t index, Object* value) {
         !ShouldConvertToSlowElements(new_capacity)) {
       ASSERT(static_cast<uint32_t>(new_capacity) > index);
       Object* obj;
+      // Growing an array of numbers with a double is the point where its
+      // elements are unboxed.  The check is amortized by the growth.
+      if (value->IsHeapNumber() && ShouldConvertToFastDoubleElements()) {
+        { MaybeObject* maybe_obj =
+              SetFastDoubleElementsCapacityAndLength(new_capacity, index + 1);
+          if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+        }
+        FixedDoubleArray::cast(elements())->set(index, value->Number());
+        return value;
+      }
       { MaybeObject* maybe_obj =
             SetFastElementsCapacityAndLength(new_capacity, index + 1);
         if (!maybe_obj->ToObject(&obj)) return maybe_obj;
@@ -6699,6 +7025,62 @@ MaybeObject* JSObject::SetFastElement(uint32_t index, Object* value) {
 }
 
 
+MaybeObject* JSObject::SetFastDoubleElement(uint32_t index, Object* value) {
+  ASSERT(HasFastDoubleElements());
+  ASSERT(IsJSArray());
+
+  FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+  uint32_t elms_length = static_cast<uint32_t>(elms->length());
+  uint32_t array_length = 0;
+  CHECK(JSArray::cast(this)->length()->ToArrayIndex(&array_length));
+
+  // Storing anything but a number boxes the elements again.
+  if (!value->IsNumber()) {
+    Object* obj;
+    { MaybeObject* maybe_obj =
+          SetFastElementsCapacityAndLength(elms_length, array_length);
+      if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+    }
+    ASSERT(HasFastElements());
+    return SetFastElement(index, value);
+  }
+
+  // Check whether there is extra space in the double array.
+  if (index < elms_length) {
+    elms->set(index, value->Number());
+    if (index >= array_length) {
+      JSArray::cast(this)->set_length(Smi::FromInt(index + 1));
+    }
+    return value;
+  }
+
+  // Allow gap in fast case.
+  if ((index - elms_length) < kMaxGap) {
+    // Try allocating extra space.
+    int new_capacity = NewElementsCapacity(index + 1);
+    if (new_capacity <= kMaxFastElementsLength ||
+        !ShouldConvertToSlowElements(new_capacity)) {
+      ASSERT(static_cast<uint32_t>(new_capacity) > index);
+      Object* obj;
+      { MaybeObject* maybe_obj =
+            SetFastDoubleElementsCapacityAndLength(new_capacity, index + 1);
+        if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+      }
+      FixedDoubleArray::cast(elements())->set(index, value->Number());
+      return value;
+    }
+  }
+
+  // Otherwise default to slow case.
+  Object* obj;
+  { MaybeObject* maybe_obj = NormalizeElements();
+    if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+  }
+  ASSERT(HasDictionaryElements());
+  return SetElement(index, value);
+}
+
+
 MaybeObject* JSObject::SetElement(uint32_t index, Object* value) {
   Heap* heap = GetHeap();
   // Check access rights if needed.
@@ -6733,6 +7115,8 @@ MaybeObject* JSObject::SetElementWithoutInterceptor(uint32_t index,
     case FAST_ELEMENTS:
       // Fast case.
       return SetFastElement(index, value);
+    case FAST_DOUBLE_ELEMENTS:
+      return SetFastDoubleElement(index, value);
     case PIXEL_ELEMENTS: {
       PixelArray* pixels = PixelArray::cast(elements());
       return pixels->SetValue(index, value);
@@ -6887,6 +7271,14 @@ MaybeObject* JSObject::GetElementPostInterceptor(JSObject* receiver,
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      if (index < static_cast<uint32_t>(elms->length()) &&
+          !elms->is_the_hole(index)) {
+        return heap->NumberFromDouble(elms->get_scalar(index));
+      }
+      break;
+    }
     case PIXEL_ELEMENTS: {
       // TODO(iposva): Add testcase and implement.
       UNIMPLEMENTED();
@@ -6990,6 +7382,14 @@ MaybeObject* JSObject::GetElementWithReceiver(JSObject* receiver,
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      if (index < static_cast<uint32_t>(elms->length()) &&
+          !elms->is_the_hole(index)) {
+        return heap->NumberFromDouble(elms->get_scalar(index));
+      }
+      break;
+    }
     case PIXEL_ELEMENTS: {
       PixelArray* pixels = PixelArray::cast(elements());
       if (index < static_cast<uint32_t>(pixels->length())) {
@@ -7094,6 +7494,14 @@ bool JSObject::HasDenseElements() {
       }
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      capacity = elms->length();
+      for (int i = 0; i < capacity; i++) {
+        if (!elms->is_the_hole(i)) number_of_elements++;
+      }
+      break;
+    }
     case PIXEL_ELEMENTS:
     case EXTERNAL_BYTE_ELEMENTS:
     case EXTERNAL_UNSIGNED_BYTE_ELEMENTS:
@@ -7121,11 +7529,13 @@ bool JSObject::HasDenseElements() {
 
 
 bool JSObject::ShouldConvertToSlowElements(int new_capacity) {
-  ASSERT(HasFastElements());
+  ASSERT(HasFastElements() || HasFastDoubleElements());
   // Keep the array in fast case if the current backing storage is
   // almost filled and if the new capacity is no more than twice the
   // old capacity.
-  int elements_length = FixedArray::cast(elements())->length();
+  int elements_length = HasFastElements() ?
+      FixedArray::cast(elements())->length() :
+      FixedDoubleArray::cast(elements())->length();
   return !HasDenseElements() || ((new_capacity / 2) > elements_length);
 }
 
@@ -7327,6 +7737,11 @@ bool JSObject::HasRealElementProperty(uint32_t index) {
       return (index < length) &&
           !FixedArray::cast(elements())->get(index)->IsTheHole();
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      return (index < static_cast<uint32_t>(elms->length())) &&
+          !elms->is_the_hole(index);
+    }
     case PIXEL_ELEMENTS: {
       PixelArray* pixels = PixelArray::cast(elements());
       return index < static_cast<uint32_t>(pixels->length());
@@ -7560,6 +7975,20 @@ int JSObject::GetLocalElementKeys(FixedArray* storage,
       ASSERT(!storage || storage->length() >= counter);
       break;
     }
+    case FAST_DOUBLE_ELEMENTS: {
+      FixedDoubleArray* elms = FixedDoubleArray::cast(elements());
+      int length = Smi::cast(JSArray::cast(this)->length())->value();
+      for (int i = 0; i < length; i++) {
+        if (!elms->is_the_hole(i)) {
+          if (storage != NULL) {
+            storage->set(counter, Smi::FromInt(i));
+          }
+          counter++;
+        }
+      }
+      ASSERT(!storage || storage->length() >= counter);
+      break;
+    }
     case PIXEL_ELEMENTS: {
       int length = PixelArray::cast(elements())->length();
       while (counter < length) {
@@ -7761,10 +8190,17 @@ class Utf8SymbolKey : public HashTableKey {
 
   uint32_t Hash() {
     if (hash_field_ != 0) return hash_field_ >> String::kHashShift;
-    unibrow::Utf8InputBuffer<> buffer(string_.start(),
-                                      static_cast<unsigned>(string_.length()));
-    chars_ = buffer.Length();
-    hash_field_ = String::ComputeHashField(&buffer, chars_);
+    int length = string_.length();
+    if (NonAsciiStart(string_.start(), length) == length) {
+      // ASCII characters are their own UTF-8 encoding.
+      chars_ = length;
+      hash_field_ = StringHasher::HashSequentialString(string_.start(), length);
+    } else {
+      unibrow::Utf8InputBuffer<> buffer(string_.start(),
+                                        static_cast<unsigned>(length));
+      chars_ = buffer.Length();
+      hash_field_ = String::ComputeHashField(&buffer, chars_);
+    }
     uint32_t result = hash_field_ >> String::kHashShift;
     ASSERT(result != 0);  // Ensure that the hash value of 0 is never computed.
     return result;
@@ -8141,6 +8577,22 @@ MaybeObject* JSObject::PrepareElementsForSort(uint32_t limit) {
   Heap* heap = GetHeap();
   ASSERT(!HasPixelElements() && !HasExternalArrayElements());
 
+  if (HasFastDoubleElements()) {
+    // Numbers are never undefined, so only the holes have to be moved to
+    // the end.
+    FixedDoubleArray* elements = FixedDoubleArray::cast(this->elements());
+    uint32_t elements_length = static_cast<uint32_t>(elements->length());
+    if (limit > elements_length) limit = elements_length;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < limit; i++) {
+      if (elements->is_the_hole(i)) continue;
+      if (count != i) elements->set(count, elements->get_scalar(i));
+      count++;
+    }
+    for (uint32_t i = count; i < limit; i++) elements->set_the_hole(i);
+    return Smi::FromInt(count);
+  }
+
   if (HasDictionaryElements()) {
     // Convert to fast elements containing only the existing properties.
     // Ordering is irrelevant, since we are going to sort anyway.
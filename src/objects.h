@@ -29,6 +29,7 @@
 #define V8_OBJECTS_H_
 
 #include "builtins.h"
+#include "list.h"
 #include "smart-pointer.h"
 #include "unicode-inl.h"
 #if V8_TARGET_ARCH_ARM
@@ -252,6 +253,8 @@ static const int kVariableSizeSentinel = 0;
   V(EXTERNAL_STRING_WITH_ASCII_DATA_TYPE)                                      \
   V(EXTERNAL_ASCII_STRING_TYPE)                                                \
   V(PRIVATE_EXTERNAL_ASCII_STRING_TYPE)                                        \
+  V(SLICED_STRING_TYPE)                                                        \
+  V(SLICED_ASCII_STRING_TYPE)                                                  \
                                                                                \
   V(MAP_TYPE)                                                                  \
   V(CODE_TYPE)                                                                 \
@@ -272,6 +275,7 @@ static const int kVariableSizeSentinel = 0;
   V(EXTERNAL_INT_ARRAY_TYPE)                                                   \
   V(EXTERNAL_UNSIGNED_INT_ARRAY_TYPE)                                          \
   V(EXTERNAL_FLOAT_ARRAY_TYPE)                                                 \
+  V(FIXED_DOUBLE_ARRAY_TYPE)                                                   \
   V(FILLER_TYPE)                                                               \
                                                                                \
   V(ACCESSOR_INFO_TYPE)                                                        \
@@ -370,7 +374,15 @@ static const int kVariableSizeSentinel = 0;
   V(EXTERNAL_ASCII_STRING_TYPE,                                                \
     ExternalAsciiString::kSize,                                                \
     external_ascii_string,                                                     \
-    ExternalAsciiString)
+    ExternalAsciiString)                                                       \
+  V(SLICED_STRING_TYPE,                                                        \
+    SlicedString::kSize,                                                       \
+    sliced_string,                                                             \
+    SlicedString)                                                              \
+  V(SLICED_ASCII_STRING_TYPE,                                                  \
+    SlicedString::kSize,                                                       \
+    sliced_ascii_string,                                                       \
+    SlicedAsciiString)
 
 // A struct is a simple object a set of object-valued fields.  Including an
 // object type in this causes the compiler to generate most of the boilerplate
@@ -431,9 +443,9 @@ const uint32_t kStringRepresentationMask = 0x03;
 enum StringRepresentationTag {
   kSeqStringTag = 0x0,
   kConsStringTag = 0x1,
-  kExternalStringTag = 0x2
+  kExternalStringTag = 0x2,
+  kSlicedStringTag = 0x3
 };
-const uint32_t kIsConsStringMask = 0x1;
 
 // If bit 7 is clear, then bit 3 indicates whether this two-byte
 // string actually contains ascii data.
@@ -473,6 +485,8 @@ enum InstanceType {
       kTwoByteStringTag | kExternalStringTag | kAsciiDataHintTag,
   EXTERNAL_ASCII_STRING_TYPE = kAsciiStringTag | kExternalStringTag,
   PRIVATE_EXTERNAL_ASCII_STRING_TYPE = EXTERNAL_ASCII_STRING_TYPE,
+  SLICED_STRING_TYPE = kTwoByteStringTag | kSlicedStringTag,
+  SLICED_ASCII_STRING_TYPE = kAsciiStringTag | kSlicedStringTag,
 
   // Objects allocated in their own spaces (never in new space).
   MAP_TYPE = kNotStringTag,  // FIRST_NONSTRING_TYPE
@@ -493,6 +507,7 @@ enum InstanceType {
   EXTERNAL_INT_ARRAY_TYPE,
   EXTERNAL_UNSIGNED_INT_ARRAY_TYPE,
   EXTERNAL_FLOAT_ARRAY_TYPE,  // LAST_EXTERNAL_ARRAY_TYPE
+  FIXED_DOUBLE_ARRAY_TYPE,
   FILLER_TYPE,  // LAST_DATA_TYPE
 
   // Structs.
@@ -637,10 +652,12 @@ class Object : public MaybeObject {
   inline bool IsSeqTwoByteString();
   inline bool IsSeqAsciiString();
   inline bool IsConsString();
+  inline bool IsSlicedString();
 
   inline bool IsNumber();
   inline bool IsByteArray();
   inline bool IsPixelArray();
+  inline bool IsFixedDoubleArray();
   inline bool IsExternalArray();
   inline bool IsExternalByteArray();
   inline bool IsExternalUnsignedByteArray();
@@ -1245,6 +1262,7 @@ class JSObject: public HeapObject {
     // The only "fast" kind.
     FAST_ELEMENTS,
     // All the kinds below are "slow".
+    FAST_DOUBLE_ELEMENTS,
     DICTIONARY_ELEMENTS,
     PIXEL_ELEMENTS,
     EXTERNAL_BYTE_ELEMENTS,
@@ -1278,13 +1296,16 @@ class JSObject: public HeapObject {
   // few objects and so before writing to any element the array must
   // be copied. Use EnsureWritableFastElements in this case.
   //
-  // In the slow mode elements is either a NumberDictionary or a
-  // PixelArray or an ExternalArray.
+  // In the slow mode elements is either a NumberDictionary, a
+  // FixedDoubleArray, a PixelArray or an ExternalArray.  Arrays of numbers
+  // keep their elements unboxed in a FixedDoubleArray; storing anything
+  // else than a number turns them back into fast mode.
   DECL_ACCESSORS(elements, HeapObject)
   inline void initialize_elements();
   MUST_USE_RESULT inline MaybeObject* ResetElements();
   inline ElementsKind GetElementsKind();
   inline bool HasFastElements();
+  inline bool HasFastDoubleElements();
   inline bool HasDictionaryElements();
   inline bool HasPixelElements();
   inline bool HasExternalArrayElements();
@@ -1447,6 +1468,9 @@ class JSObject: public HeapObject {
   // storage would.  In that case the JSObject should have fast
   // elements.
   bool ShouldConvertToFastElements();
+  // Returns true if the fast-case elements of this array are all numbers
+  // and can be stored unboxed.
+  bool ShouldConvertToFastDoubleElements();
 
   // Return the object's prototype (might be Heap::null_value()).
   inline Object* GetPrototype();
@@ -1483,6 +1507,8 @@ class JSObject: public HeapObject {
   bool HasElementPostInterceptor(JSObject* receiver, uint32_t index);
 
   MUST_USE_RESULT MaybeObject* SetFastElement(uint32_t index, Object* value);
+  MUST_USE_RESULT MaybeObject* SetFastDoubleElement(uint32_t index,
+                                                    Object* value);
 
   // Set the index'th array element.
   // A Failure object is returned if GC is needed.
@@ -1495,6 +1521,9 @@ class JSObject: public HeapObject {
 
   MUST_USE_RESULT MaybeObject* SetFastElementsCapacityAndLength(int capacity,
                                                                 int length);
+  MUST_USE_RESULT MaybeObject* SetFastDoubleElementsCapacityAndLength(
+      int capacity,
+      int length);
   MUST_USE_RESULT MaybeObject* SetSlowElements(Object* length);
 
   // Lookup interceptors are used for handling properties controlled by host
@@ -1880,6 +1909,69 @@ class FixedArray: public HeapObject {
 };
 
 
+// FixedDoubleArray describes fixed-sized arrays of unboxed doubles.  It is
+// the backing store of arrays holding only numbers.  Holes are stored as a
+// NaN with a bit pattern that no arithmetic produces; NaNs stored into the
+// array are canonicalized so they cannot be mistaken for a hole.
+class FixedDoubleArray: public HeapObject {
+ public:
+  // [length]: length of the array.
+  inline int length();
+  inline void set_length(int value);
+
+  // Setter and getter for elements.
+  inline double get_scalar(int index);
+  // Returns the element boxed in a heap number, or the hole.
+  MUST_USE_RESULT inline MaybeObject* get(int index);
+  inline void set(int index, double value);
+  inline void set_the_hole(int index);
+  inline bool is_the_hole(int index);
+
+  // Fills the elements from a fast elements backing store holding only
+  // smis, heap numbers and holes.
+  inline void Initialize(FixedArray* from);
+
+  // Garbage collection support.
+  static int SizeFor(int length) {
+    return kHeaderSize + length * kDoubleSize;
+  }
+
+  // Code Generation support.
+  static int OffsetOfElementAt(int index) { return SizeFor(index); }
+
+  // Casting.
+  static inline FixedDoubleArray* cast(Object* obj);
+
+  // Layout description.
+  // Length is smi tagged when it is stored.
+  static const int kLengthOffset = HeapObject::kHeaderSize;
+  static const int kHeaderSize = kLengthOffset + kPointerSize;
+
+  // Maximal allowed size, in bytes, of a single FixedDoubleArray.
+  static const int kMaxSize = 512 * MB;
+  // Maximally allowed length of a FixedDoubleArray.
+  static const int kMaxLength = (kMaxSize - kHeaderSize) / kDoubleSize;
+
+  // The bit pattern of the hole.  Both halves are compared separately by
+  // generated code.
+  static const uint32_t kHoleNanUpper32 = 0x7FFFFFFF;
+  static const uint32_t kHoleNanLower32 = 0xFFFFFFFF;
+
+  static inline double hole_nan_as_double();
+  static inline double canonical_not_the_hole_nan_as_double();
+
+  // Dispatched behavior.
+  inline int FixedDoubleArraySize() { return SizeFor(length()); }
+#ifdef DEBUG
+  void FixedDoubleArrayPrint();
+  void FixedDoubleArrayVerify();
+#endif
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(FixedDoubleArray);
+};
+
+
 // DescriptorArrays are fixed arrays used to hold instance descriptors.
 // The format of the these objects is:
 //   [0]: point to a fixed array with (value, detail) pairs.
@@ -1963,8 +2055,10 @@ class DescriptorArray: public FixedArray {
   MUST_USE_RESULT MaybeObject* CopyInsert(Descriptor* descriptor,
                                           TransitionFlag transition_flag);
 
-  // Remove all transitions.  Return  a copy of the array with all transitions
+  // Remove all transitions.  Return a copy of the array with all transitions
   // removed, or a Failure object if the new array could not be allocated.
+  // An array without transitions or null descriptors is returned as is and
+  // is shared by the maps using it; it is never modified in place.
   MUST_USE_RESULT MaybeObject* RemoveTransitions();
 
   // Sort the instance descriptors by the hash codes of their keys.
@@ -4262,8 +4356,14 @@ class JSRegExp: public JSObject {
   static const int kIrregexpMaxRegisterCountIndex = kDataIndex + 2;
   // Number of captures in the compiled regexp.
   static const int kIrregexpCaptureCountIndex = kDataIndex + 3;
+  // A string that every match contains, or undefined.  Exec skips ahead to
+  // where it occurs.
+  static const int kIrregexpLiteralIndex = kDataIndex + 4;
+  // The offset of the literal from the start of every match, or -1 if it
+  // varies.
+  static const int kIrregexpLiteralOffsetIndex = kDataIndex + 5;
 
-  static const int kIrregexpDataSize = kIrregexpCaptureCountIndex + 1;
+  static const int kIrregexpDataSize = kIrregexpLiteralOffsetIndex + 1;
 
   // Offsets directly into the data fixed array.
   static const int kDataTagOffset =
@@ -4274,6 +4374,9 @@ class JSRegExp: public JSObject {
       FixedArray::kHeaderSize + kIrregexpUC16CodeIndex * kPointerSize;
   static const int kIrregexpCaptureCountOffset =
       FixedArray::kHeaderSize + kIrregexpCaptureCountIndex * kPointerSize;
+  // The literal itself, not to be confused with kIrregexpLiteralOffsetIndex.
+  static const int kDataIrregexpLiteralOffset =
+      FixedArray::kHeaderSize + kIrregexpLiteralIndex * kPointerSize;
 
   // In-object fields.
   static const int kSourceFieldIndex = 0;
@@ -4437,6 +4540,16 @@ class StringHasher {
   // that the input is not an array index.
   inline void AddCharacterNoIndex(uc32 c);
 
+  // Adds a run of characters to the hash without updating the array index
+  // calculation.  Gives the same result as calling AddCharacterNoIndex for
+  // each of them, but keeps the running hash in a register.
+  template <typename schar>
+  inline void AddCharactersNoIndex(const schar* chars, int length);
+
+  // Returns the hash field of a string with the given characters.
+  template <typename schar>
+  static inline uint32_t HashSequentialString(const schar* chars, int length);
+
   // Returns the value to store in the hash field of a string with
   // the given length and contents.
   uint32_t GetHashField();
@@ -4492,6 +4605,7 @@ class StringShape BASE_EMBEDDED {
   inline bool IsSequential();
   inline bool IsExternal();
   inline bool IsCons();
+  inline bool IsSliced();
   inline bool IsExternalAscii();
   inline bool IsExternalTwoByte();
   inline bool IsSequentialAscii();
@@ -4976,6 +5090,107 @@ class ConsString: public String {
 };
 
 
+// The SlicedString class describes substrings that share the characters
+// of another string instead of copying them.  A SlicedString consists of
+// the length and hash fields common to all strings, a pointer to the
+// parent string and the offset of the first character within the parent.
+// The parent is always a sequential or an external string, so a sliced
+// string is always flat.  Only substrings of at least kMinLength
+// characters are sliced; the garbage collector copies out slices that
+// keep much larger parents alive.
+class SlicedString: public String {
+ public:
+  // The string holding the characters of this slice.
+  inline String* parent();
+  // Doesn't check that the result is a string, even in debug mode.  This is
+  // useful during GC where the parent may already have been moved.
+  inline Object* unchecked_parent();
+  inline void set_parent(String* parent,
+                         WriteBarrierMode mode = UPDATE_WRITE_BARRIER);
+
+  // The position of the first character of this slice in the parent.
+  inline int offset();
+  inline void set_offset(int offset);
+
+  // Dispatched behavior.
+  uint16_t SlicedStringGet(int index);
+
+  // Casting.
+  static inline SlicedString* cast(Object* obj);
+
+  // Layout description.
+  static const int kParentOffset = POINTER_SIZE_ALIGN(String::kSize);
+  static const int kOffsetOffset = kParentOffset + kPointerSize;
+  static const int kSize = kOffsetOffset + kPointerSize;
+
+  // Support for StringInputBuffer.
+  inline const unibrow::byte* SlicedStringReadBlock(ReadBlockBuffer* buffer,
+                                                    unsigned* offset_ptr,
+                                                    unsigned chars);
+  inline void SlicedStringReadBlockIntoBuffer(ReadBlockBuffer* buffer,
+                                              unsigned* offset_ptr,
+                                              unsigned chars);
+
+  // Minimum length for a sliced string.  Shorter substrings are copied.
+  static const int kMinLength = 13;
+
+  // The offset is a smi, so only the parent needs visiting.
+  typedef FixedBodyDescriptor<kParentOffset, kOffsetOffset, kSize>
+          BodyDescriptor;
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(SlicedString);
+};
+
+
+// Reads the characters of a string without flattening it.  For a cons
+// string the flat leaf holding the most recently read character is
+// cached together with the path of cons strings leading to it, so runs of
+// reads within one leaf do not walk the tree and moving on to the next
+// leaf only walks up and down the part of the path that changes.  The
+// cursor holds raw pointers into the heap and must only be used while no
+// allocation can happen.
+class StringCharacterCursor BASE_EMBEDDED {
+ public:
+  // The cursor gives up once it has visited max_steps cons strings.
+  inline StringCharacterCursor(String* string, int max_steps);
+
+  // Returns 0 if the cursor has given up.
+  inline uint16_t Get(int index);
+
+  // Returns the flat leaf holding the character at index and stores the
+  // position of its first character in *leaf_start.  Returns NULL if the
+  // cursor has given up.
+  inline String* LeafAt(int index, int* leaf_start);
+
+  // The number of cons strings visited so far while locating leaves.
+  int steps() const { return steps_; }
+
+  bool has_given_up() const { return steps_ > max_steps_; }
+
+ private:
+  struct PathEntry {
+    ConsString* cons_string;
+    int start;
+  };
+
+  void FindLeaf(int index);
+
+  String* string_;
+  // The cons strings from string_ down to the parent of leaf_.
+  List<PathEntry> path_;
+  String* leaf_;
+  // The characters of leaf_, which covers [leaf_start_, leaf_end_).
+  Vector<const char> ascii_chars_;
+  Vector<const uc16> two_byte_chars_;
+  bool leaf_is_ascii_;
+  int leaf_start_;
+  int leaf_end_;
+  int steps_;
+  int max_steps_;
+};
+
+
 // The ExternalString class describes string values that are backed by
 // a string resource that lies outside the V8 heap.  ExternalStrings
 // consist of the length field common to all strings, a pointer to the
@@ -5372,6 +5587,21 @@ class AccessorInfo: public Struct {
   inline PropertyAttributes property_attributes();
   inline void set_property_attributes(PropertyAttributes attributes);
 
+  // Accessors set with ObjectTemplate::SetInternalFieldAccessor.  Their
+  // data is a smi describing what they read; the getter performs that
+  // read in C++ and the load ICs compile it into inline loads.
+  inline bool is_internal_field_accessor();
+  inline void set_is_internal_field_accessor(bool value);
+  inline v8::InternalFieldAccessorType internal_field_type();
+  inline int internal_field_index();
+  inline int internal_field_offset();
+
+  // Encoding of the data of internal field accessors.
+  class InternalFieldTypeField:
+      public BitField<v8::InternalFieldAccessorType, 0, 2> {};
+  class InternalFieldIndexField: public BitField<int, 2, 10> {};
+  class InternalFieldOffsetField: public BitField<int, 12, 18> {};
+
   static inline AccessorInfo* cast(Object* obj);
 
 #ifdef DEBUG
@@ -5392,6 +5622,7 @@ class AccessorInfo: public Struct {
   static const int kAllCanWriteBit = 1;
   static const int kProhibitsOverwritingBit = 2;
   class AttributesField: public BitField<PropertyAttributes, 3, 3> {};
+  static const int kIsInternalFieldAccessorBit = 6;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(AccessorInfo);
 };
@@ -2105,6 +2105,9 @@ void HeapSnapshotGenerator::ExtractReferences(HeapObject* obj) {
       ConsString* cs = ConsString::cast(obj);
       SetInternalReference(obj, entry, 1, cs->first());
       SetInternalReference(obj, entry, 2, cs->second());
+    } else if (obj->IsSlicedString()) {
+      SlicedString* ss = SlicedString::cast(obj);
+      SetInternalReference(obj, entry, "parent", ss->parent());
     }
   } else {
     IndexedReferencesExtractor refs_extractor(this, obj, entry);
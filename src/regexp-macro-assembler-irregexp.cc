@@ -36,13 +36,12 @@
 namespace v8 {
 namespace internal {
 
-#ifdef V8_INTERPRETED_REGEXP
-
 RegExpMacroAssemblerIrregexp::RegExpMacroAssemblerIrregexp(Vector<byte> buffer)
     : buffer_(buffer),
       pc_(0),
       own_buffer_(false),
-      advance_current_end_(kInvalidPC) {
+      advance_current_end_(kInvalidPC),
+      load_current_end_(kInvalidPC) {
 }
 
 
@@ -60,6 +59,7 @@ RegExpMacroAssemblerIrregexp::Implementation() {
 
 void RegExpMacroAssemblerIrregexp::Bind(Label* l) {
   advance_current_end_ = kInvalidPC;
+  load_current_end_ = kInvalidPC;
   ASSERT(!l->is_bound());
   if (l->is_linked()) {
     int pos = l->pos();
@@ -256,8 +256,28 @@ void RegExpMacroAssemblerIrregexp::LoadCurrentCharacter(int cp_offset,
       bytecode = BC_LOAD_CURRENT_CHAR_UNCHECKED;
     }
   }
+  if (characters == 1) load_current_start_ = pc_;
   Emit(bytecode, cp_offset);
   if (check_bounds) EmitOrLink(on_failure);
+  if (characters == 1) load_current_end_ = pc_;
+}
+
+
+bool RegExpMacroAssemblerIrregexp::CombineWithLoad(uint32_t c,
+                                                   int checked_bytecode,
+                                                   int unchecked_bytecode) {
+  if (load_current_end_ != pc_) return false;
+  // Nothing was bound or emitted since the load, so the check can be
+  // appended to it.  The operands of the load stay where they are.
+  uint32_t* load =
+      reinterpret_cast<uint32_t*>(buffer_.start() + load_current_start_);
+  int bytecode = (*load & BYTECODE_MASK) == BC_LOAD_CURRENT_CHAR
+      ? checked_bytecode
+      : unchecked_bytecode;
+  *load = (*load & ~BYTECODE_MASK) | bytecode;
+  Emit32(c);
+  load_current_end_ = kInvalidPC;
+  return true;
 }
 
 
@@ -276,11 +296,15 @@ void RegExpMacroAssemblerIrregexp::CheckCharacterGT(uc16 limit,
 
 
 void RegExpMacroAssemblerIrregexp::CheckCharacter(uint32_t c, Label* on_equal) {
-  if (c > MAX_FIRST_ARG) {
-    Emit(BC_CHECK_4_CHARS, 0);
-    Emit32(c);
-  } else {
-    Emit(BC_CHECK_CHAR, c);
+  if (!CombineWithLoad(c,
+                       BC_LOAD_CURRENT_CHAR_CHECK_CHAR,
+                       BC_LOAD_CURRENT_CHAR_UNCHECKED_CHECK_CHAR)) {
+    if (c > MAX_FIRST_ARG) {
+      Emit(BC_CHECK_4_CHARS, 0);
+      Emit32(c);
+    } else {
+      Emit(BC_CHECK_CHAR, c);
+    }
   }
   EmitOrLink(on_equal);
 }
@@ -300,11 +324,15 @@ void RegExpMacroAssemblerIrregexp::CheckNotAtStart(Label* on_not_at_start) {
 
 void RegExpMacroAssemblerIrregexp::CheckNotCharacter(uint32_t c,
                                                      Label* on_not_equal) {
-  if (c > MAX_FIRST_ARG) {
-    Emit(BC_CHECK_NOT_4_CHARS, 0);
-    Emit32(c);
-  } else {
-    Emit(BC_CHECK_NOT_CHAR, c);
+  if (!CombineWithLoad(c,
+                       BC_LOAD_CURRENT_CHAR_CHECK_NOT_CHAR,
+                       BC_LOAD_CURRENT_CHAR_UNCHECKED_CHECK_NOT_CHAR)) {
+    if (c > MAX_FIRST_ARG) {
+      Emit(BC_CHECK_NOT_4_CHARS, 0);
+      Emit32(c);
+    } else {
+      Emit(BC_CHECK_NOT_CHAR, c);
+    }
   }
   EmitOrLink(on_not_equal);
 }
@@ -392,14 +420,10 @@ void RegExpMacroAssemblerIrregexp::CheckCharacters(
   // It is vital that this loop is backwards due to the unchecked character
   // load below.
   for (int i = str.length() - 1; i >= 0; i--) {
-    if (check_end_of_string && i == str.length() - 1) {
-      Emit(BC_LOAD_CURRENT_CHAR, cp_offset + i);
-      EmitOrLink(on_failure);
-    } else {
-      Emit(BC_LOAD_CURRENT_CHAR_UNCHECKED, cp_offset + i);
-    }
-    Emit(BC_CHECK_NOT_CHAR, str[i]);
-    EmitOrLink(on_failure);
+    LoadCurrentCharacter(cp_offset + i,
+                         on_failure,
+                         check_end_of_string && i == str.length() - 1);
+    CheckNotCharacter(str[i], on_failure);
   }
 }
 
@@ -465,6 +489,4 @@ void RegExpMacroAssemblerIrregexp::Expand() {
   }
 }
 
-#endif  // V8_INTERPRETED_REGEXP
-
 } }  // namespace v8::internal
@@ -31,8 +31,6 @@
 namespace v8 {
 namespace internal {
 
-#ifdef V8_INTERPRETED_REGEXP
-
 class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
  public:
   // Create an assembler. Instructions and relocation information are emitted
@@ -109,6 +107,11 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
   virtual Handle<Object> GetCode(Handle<String> source);
  private:
   void Expand();
+  // Turns a single character load that was just emitted into the given
+  // instruction that also compares the loaded character with c.
+  bool CombineWithLoad(uint32_t c,
+                       int checked_bytecode,
+                       int unchecked_bytecode);
   // Code and bitmap emission.
   inline void EmitOrLink(Label* label);
   inline void Emit32(uint32_t x);
@@ -130,13 +133,14 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
   int advance_current_offset_;
   int advance_current_end_;
 
+  int load_current_start_;
+  int load_current_end_;
+
   static const int kInvalidPC = -1;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(RegExpMacroAssemblerIrregexp);
 };
 
-#endif  // V8_INTERPRETED_REGEXP
-
 } }  // namespace v8::internal
 
 #endif  // V8_REGEXP_MACRO_ASSEMBLER_IRREGEXP_H_
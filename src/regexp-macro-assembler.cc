@@ -35,7 +35,7 @@
 namespace v8 {
 namespace internal {
 
-RegExpMacroAssembler::RegExpMacroAssembler() {
+RegExpMacroAssembler::RegExpMacroAssembler() : backtrack_limit_(0) {
 }
 
 
@@ -73,10 +73,16 @@ bool NativeRegExpMacroAssembler::CanReadUnaligned() {
 const byte* NativeRegExpMacroAssembler::StringCharacterPosition(
     String* subject,
     int start_index) {
-  // Not just flat, but ultra flat.
-  ASSERT(subject->IsExternalString() || subject->IsSeqString());
   ASSERT(start_index >= 0);
   ASSERT(start_index <= subject->length());
+  // A slice reads its characters from its parent.
+  if (StringShape(subject).IsSliced()) {
+    SlicedString* slice = SlicedString::cast(subject);
+    start_index += slice->offset();
+    subject = slice->parent();
+  }
+  // Not just flat, but ultra flat.
+  ASSERT(subject->IsExternalString() || subject->IsSeqString());
   if (subject->IsAsciiRepresentation()) {
     const byte* address;
     if (StringShape(subject).IsExternal()) {
@@ -129,8 +135,10 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Match(
   }
   // Ensure that an underlying string has the same ascii-ness.
   bool is_ascii = subject_ptr->IsAsciiRepresentation();
-  ASSERT(subject_ptr->IsExternalString() || subject_ptr->IsSeqString());
-  // String is now either Sequential or External
+  ASSERT(subject_ptr->IsExternalString() ||
+         subject_ptr->IsSeqString() ||
+         subject_ptr->IsSlicedString());
+  // String is now either Sequential, External or Sliced
   int char_size_shift = is_ascii ? 0 : 1;
   int char_length = end_offset - start_offset;
 
@@ -177,7 +185,7 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Execute(
                                           direct_call,
                                           isolate);
   ASSERT(result <= SUCCESS);
-  ASSERT(result >= RETRY);
+  ASSERT(result >= BACKTRACK_LIMIT);
 
   if (result == EXCEPTION && !isolate->has_pending_exception()) {
     // We detected a stack overflow (on the backtrack stack) in RegExp code,
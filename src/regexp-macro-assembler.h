@@ -161,6 +161,15 @@ class RegExpMacroAssembler {
   virtual void WriteCurrentPositionToRegister(int reg, int cp_offset) = 0;
   virtual void ClearRegisters(int reg_from, int reg_to) = 0;
   virtual void WriteStackPointerToRegister(int reg) = 0;
+
+  // The number of backtracks after which native code gives up and returns
+  // BACKTRACK_LIMIT, or 0 for no limit.  Only the IA32 and X64 native
+  // implementations check the limit.
+  void set_backtrack_limit(int limit) { backtrack_limit_ = limit; }
+  int backtrack_limit() { return backtrack_limit_; }
+
+ private:
+  int backtrack_limit_;
 };
 
 
@@ -177,10 +186,18 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   // EXCEPTION: Something failed during execution. If no exception has been
   //        thrown, it's an internal out-of-memory, and the caller should
   //        throw the exception.
+  // BACKTRACK_LIMIT: The backtrack limit was reached before the matching
+  //        finished, and the caller should match with RegExpNfa instead.
   // FAILURE: Matching failed.
   // SUCCESS: Matching succeeded, and the output array has been filled with
   //        capture positions.
-  enum Result { RETRY = -2, EXCEPTION = -1, FAILURE = 0, SUCCESS = 1 };
+  enum Result {
+    BACKTRACK_LIMIT = -3,
+    RETRY = -2,
+    EXCEPTION = -1,
+    FAILURE = 0,
+    SUCCESS = 1
+  };
 
   NativeRegExpMacroAssembler();
   virtual ~NativeRegExpMacroAssembler();
@@ -0,0 +1,633 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "ast.h"
+#include "char-predicates-inl.h"
+#include "jsregexp.h"
+#include "regexp-nfa.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Translates a regular expression tree into instructions of the automaton.
+// Captures are written to the registers irregexp uses for them.  Counted
+// repetitions are unrolled, and every optional iteration of a quantifier
+// whose body can match the empty string records its start position in a
+// register of its own, so the iteration can be rejected if it makes no
+// progress.
+class RegExpNfaCompiler: public RegExpVisitor {
+ public:
+  RegExpNfaCompiler(int capture_count, bool ignore_case)
+      : program_(new ZoneList<RegExpNfa::Instruction>(16)),
+        capture_register_count_((capture_count + 1) * 2),
+        register_count_(capture_register_count_),
+        ignore_case_(ignore_case),
+        loops_(NULL),
+        failed_(capture_register_count_ > RegExpNfa::kMaxRegisters) { }
+
+#define MAKE_CASE(Name) virtual void* Visit##Name(RegExp##Name*, void* data);
+  FOR_EACH_REG_EXP_TREE_TYPE(MAKE_CASE)
+#undef MAKE_CASE
+
+  void Visit(RegExpTree* tree) {
+    if (!failed_) tree->Accept(this, NULL);
+  }
+
+  ZoneList<RegExpNfa::Instruction>* program() { return program_; }
+  int capture_register_count() { return capture_register_count_; }
+  int register_count() { return register_count_; }
+  bool failed() { return failed_; }
+
+  int Emit(RegExpNfa::Opcode opcode,
+           int operand = 0,
+           int operand2 = 0,
+           ZoneList<CharacterRange>* ranges = NULL) {
+    RegExpNfa::Instruction instruction =
+        { opcode, operand, operand2, ranges, loops_ };
+    program_->Add(instruction);
+    if (program_->length() > RegExpNfa::kMaxInstructions) failed_ = true;
+    return program_->length() - 1;
+  }
+
+ private:
+  int pc() { return program_->length(); }
+
+  int NewRegister() {
+    if (register_count_ == RegExpNfa::kMaxRegisters) failed_ = true;
+    return register_count_++;
+  }
+
+  void PatchSplit(int split, int body, int exit, bool greedy) {
+    RegExpNfa::Instruction& instruction = program_->at(split);
+    ASSERT(instruction.opcode == RegExpNfa::SPLIT);
+    instruction.operand = greedy ? body : exit;
+    instruction.operand2 = greedy ? exit : body;
+  }
+
+  void EmitClearCaptures(Interval captures) {
+    if (!captures.is_empty()) {
+      Emit(RegExpNfa::CLEAR_REGISTERS, captures.from(), captures.to());
+    }
+  }
+
+  void EmitIteration(RegExpTree* body, Interval captures, bool check_progress);
+  void EmitCharacter(uc16 c);
+
+  ZoneList<RegExpNfa::Instruction>* program_;
+  int capture_register_count_;
+  int register_count_;
+  bool ignore_case_;
+  ZoneList<int>* loops_;
+  bool failed_;
+};
+
+
+static void AddCaseEquivalents(ZoneList<CharacterRange>* ranges) {
+  int range_count = ranges->length();
+  for (int i = 0; i < range_count; i++) {
+    // Adding to the list can move its elements, so work on a copy.
+    CharacterRange range = ranges->at(i);
+    range.AddCaseEquivalents(ranges, false);
+  }
+  CharacterRange::Canonicalize(ranges);
+}
+
+
+void* RegExpNfaCompiler::VisitDisjunction(RegExpDisjunction* that,
+                                          void* data) {
+  ZoneList<RegExpTree*>* alternatives = that->alternatives();
+  int last = alternatives->length() - 1;
+  ZoneList<int> jumps(last);
+  for (int i = 0; i < last && !failed_; i++) {
+    int split = Emit(RegExpNfa::SPLIT);
+    Visit(alternatives->at(i));
+    jumps.Add(Emit(RegExpNfa::JUMP));
+    PatchSplit(split, split + 1, pc(), true);
+  }
+  Visit(alternatives->at(last));
+  for (int i = 0; i < jumps.length(); i++) {
+    program_->at(jumps[i]).operand = pc();
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitAlternative(RegExpAlternative* that,
+                                          void* data) {
+  ZoneList<RegExpTree*>* nodes = that->nodes();
+  for (int i = 0; i < nodes->length(); i++) {
+    Visit(nodes->at(i));
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitAssertion(RegExpAssertion* that, void* data) {
+  Emit(RegExpNfa::ASSERTION, that->type());
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitCharacterClass(RegExpCharacterClass* that,
+                                             void* data) {
+  ZoneList<CharacterRange>* ranges = new ZoneList<CharacterRange>(2);
+  ranges->AddAll(*that->ranges());
+  if (ignore_case_ && !that->is_standard()) {
+    AddCaseEquivalents(ranges);
+  } else {
+    CharacterRange::Canonicalize(ranges);
+  }
+  if (that->is_negated()) {
+    ZoneList<CharacterRange>* negated =
+        new ZoneList<CharacterRange>(ranges->length() + 1);
+    CharacterRange::Negate(ranges, negated);
+    ranges = negated;
+  }
+  Emit(RegExpNfa::CONSUME, 0, 0, ranges);
+  return NULL;
+}
+
+
+void RegExpNfaCompiler::EmitCharacter(uc16 c) {
+  ZoneList<CharacterRange>* ranges = new ZoneList<CharacterRange>(1);
+  ranges->Add(CharacterRange::Singleton(c));
+  if (ignore_case_) AddCaseEquivalents(ranges);
+  Emit(RegExpNfa::CONSUME, 0, 0, ranges);
+}
+
+
+void* RegExpNfaCompiler::VisitAtom(RegExpAtom* that, void* data) {
+  Vector<const uc16> chars = that->data();
+  for (int i = 0; i < chars.length() && !failed_; i++) {
+    EmitCharacter(chars[i]);
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitText(RegExpText* that, void* data) {
+  ZoneList<TextElement>* elements = that->elements();
+  for (int i = 0; i < elements->length() && !failed_; i++) {
+    TextElement element = elements->at(i);
+    if (element.type == TextElement::ATOM) {
+      VisitAtom(element.data.u_atom, data);
+    } else {
+      ASSERT(element.type == TextElement::CHAR_CLASS);
+      VisitCharacterClass(element.data.u_char_class, data);
+    }
+  }
+  return NULL;
+}
+
+
+void RegExpNfaCompiler::EmitIteration(RegExpTree* body,
+                                      Interval captures,
+                                      bool check_progress) {
+  // An optional iteration that matches the empty string fails, as in
+  // RepeatMatcher in ECMA-262 section 15.10.2.5.
+  if (check_progress && body->min_match() == 0) {
+    int reg = NewRegister();
+    Emit(RegExpNfa::SAVE_POSITION, reg);
+    ZoneList<int>* outer_loops = loops_;
+    loops_ = new ZoneList<int>(2);
+    if (outer_loops != NULL) loops_->AddAll(*outer_loops);
+    loops_->Add(reg);
+    if (loops_->length() > RegExpNfa::kMaxLoopDepth) failed_ = true;
+    EmitClearCaptures(captures);
+    Visit(body);
+    Emit(RegExpNfa::CHECK_PROGRESS, reg);
+    loops_ = outer_loops;
+  } else {
+    EmitClearCaptures(captures);
+    Visit(body);
+  }
+}
+
+
+void* RegExpNfaCompiler::VisitQuantifier(RegExpQuantifier* that,
+                                         void* data) {
+  if (that->is_possessive()) {
+    failed_ = true;
+    return NULL;
+  }
+  RegExpTree* body = that->body();
+  Interval captures = body->CaptureRegisters();
+  bool greedy = !that->is_non_greedy();
+  for (int i = 0; i < that->min() && !failed_; i++) {
+    EmitIteration(body, captures, false);
+  }
+  if (that->max() == RegExpTree::kInfinity) {
+    int split = Emit(RegExpNfa::SPLIT);
+    EmitIteration(body, captures, true);
+    Emit(RegExpNfa::JUMP, split);
+    PatchSplit(split, split + 1, pc(), greedy);
+  } else {
+    ZoneList<int> splits(2);
+    for (int i = that->min(); i < that->max() && !failed_; i++) {
+      splits.Add(Emit(RegExpNfa::SPLIT));
+      EmitIteration(body, captures, true);
+    }
+    for (int i = 0; i < splits.length(); i++) {
+      PatchSplit(splits[i], splits[i] + 1, pc(), greedy);
+    }
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitCapture(RegExpCapture* that, void* data) {
+  Emit(RegExpNfa::SAVE_POSITION, RegExpCapture::StartRegister(that->index()));
+  Visit(that->body());
+  Emit(RegExpNfa::SAVE_POSITION, RegExpCapture::EndRegister(that->index()));
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitLookahead(RegExpLookahead* that, void* data) {
+  failed_ = true;
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitBackReference(RegExpBackReference* that,
+                                            void* data) {
+  failed_ = true;
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitEmpty(RegExpEmpty* that, void* data) {
+  return NULL;
+}
+
+
+RegExpNfa* RegExpNfa::Compile(RegExpTree* tree,
+                              int capture_count,
+                              bool ignore_case) {
+  RegExpNfaCompiler compiler(capture_count, ignore_case);
+  // The whole match is capture 0.
+  compiler.Emit(SAVE_POSITION, RegExpCapture::StartRegister(0));
+  compiler.Visit(tree);
+  compiler.Emit(SAVE_POSITION, RegExpCapture::EndRegister(0));
+  compiler.Emit(ACCEPT);
+  if (compiler.failed()) return NULL;
+  ZoneList<Instruction>* program = compiler.program();
+  int thread_count = 0;
+  for (int i = 0; i < program->length(); i++) {
+    Opcode opcode = program->at(i).opcode;
+    if (opcode == CONSUME || opcode == ACCEPT) thread_count++;
+  }
+  // Both the current and the next position can have all threads live.
+  if (2 * thread_count * compiler.register_count() > kMaxThreadRegisters) {
+    return NULL;
+  }
+  return new RegExpNfa(program,
+                       compiler.capture_register_count(),
+                       compiler.register_count(),
+                       thread_count,
+                       tree->IsAnchoredAtStart());
+}
+
+
+// The registers of the live threads, in blocks of register_count entries.
+// The blocks of threads that have ended are reused, so the pool only grows
+// to the largest number of threads that were live at the same time.
+class NfaRegisterPool {
+ public:
+  explicit NfaRegisterPool(int register_count)
+      : register_count_(register_count),
+        registers_(16 * register_count),
+        free_blocks_(16) { }
+
+  // Returns the start of a block holding a copy of registers.
+  int Allocate(int* registers) {
+    int block;
+    if (free_blocks_.is_empty()) {
+      block = registers_.length();
+      registers_.AddBlock(0, register_count_);
+    } else {
+      block = free_blocks_.RemoveLast();
+    }
+    memcpy(&registers_[block], registers, register_count_ * kIntSize);
+    return block;
+  }
+
+  void Release(int block) { free_blocks_.Add(block); }
+
+  // The result is invalidated by the next call to Allocate.
+  int* registers(int block) { return &registers_[block]; }
+
+ private:
+  int register_count_;
+  List<int> registers_;
+  List<int> free_blocks_;
+};
+
+
+// The threads of the automaton at one position in the subject, in order of
+// decreasing priority.  The registers of the threads are kept in a pool
+// shared by all lists.
+class NfaThreadList {
+ public:
+  NfaThreadList(int capacity, NfaRegisterPool* pool)
+      : pcs_(capacity),
+        blocks_(capacity),
+        pool_(pool),
+        length_(0) { }
+
+  int length() { return length_; }
+  int pc(int i) { return pcs_[i]; }
+  int* registers(int i) { return pool_->registers(blocks_[i]); }
+
+  void Add(int pc, int* registers) {
+    ASSERT(length_ < pcs_.length());
+    pcs_[length_] = pc;
+    blocks_[length_] = pool_->Allocate(registers);
+    length_++;
+  }
+
+  void Clear() {
+    for (int i = 0; i < length_; i++) pool_->Release(blocks_[i]);
+    length_ = 0;
+  }
+
+ private:
+  ScopedVector<int> pcs_;
+  ScopedVector<int> blocks_;
+  NfaRegisterPool* pool_;
+  int length_;
+};
+
+
+static inline bool IsLineTerminator(uc16 c) {
+  return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+
+// Computes the threads that follow from a thread by taking all the
+// instructions that do not read a character.
+template <typename Char>
+class NfaClosure {
+ public:
+  NfaClosure(ZoneList<RegExpNfa::Instruction>* program,
+             int register_count,
+             Vector<const Char> subject)
+      : program_(program),
+        register_count_(register_count),
+        subject_(subject),
+        visited_(program->length() * kStateCount),
+        registers_(register_count),
+        stack_(16) {
+    for (int i = 0; i < visited_.length(); i++) visited_[i] = -1;
+  }
+
+  // Adds the threads reachable from pc to list, unless a thread with
+  // higher priority at the same position has already reached them.
+  void AddThread(NfaThreadList* list, int pc, int* registers, int position);
+
+ private:
+  // Undoes a register update or visits an instruction.
+  struct Entry {
+    int pc;
+    int reg;
+    int value;
+  };
+  static const int kRestore = -1;
+
+  // Instructions that do not read a character are visited once for every
+  // combination of the loops around them that have not made progress in
+  // their current iteration, as that decides which CHECK_PROGRESS
+  // instructions will fail.  Threads that have just read a character have
+  // made progress in all loops.
+  static const int kStateCount = 1 << RegExpNfa::kMaxLoopDepth;
+
+  int VisitedIndex(int pc, int position) {
+    RegExpNfa::Instruction& instruction = program_->at(pc);
+    int index = pc * kStateCount;
+    if (instruction.opcode == RegExpNfa::CONSUME ||
+        instruction.opcode == RegExpNfa::ACCEPT ||
+        instruction.loops == NULL) {
+      return index;
+    }
+    ZoneList<int>* loops = instruction.loops;
+    for (int i = 0; i < loops->length(); i++) {
+      if (registers_[loops->at(i)] == position) index += 1 << i;
+    }
+    return index;
+  }
+
+  uc16 CharAt(int position) { return subject_[position]; }
+  bool AssertionHolds(RegExpAssertion::Type type, int position);
+
+  void SetRegister(int reg, int value) {
+    Entry entry = { kRestore, reg, registers_[reg] };
+    stack_.Add(entry);
+    registers_[reg] = value;
+  }
+
+  ZoneList<RegExpNfa::Instruction>* program_;
+  int register_count_;
+  Vector<const Char> subject_;
+  // The position for which each instruction and loop state was last
+  // visited.
+  ScopedVector<int> visited_;
+  ScopedVector<int> registers_;
+  List<Entry> stack_;
+};
+
+
+template <typename Char>
+bool NfaClosure<Char>::AssertionHolds(RegExpAssertion::Type type,
+                                      int position) {
+  int length = subject_.length();
+  switch (type) {
+    case RegExpAssertion::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::START_OF_LINE:
+      return position == 0 || IsLineTerminator(CharAt(position - 1));
+    case RegExpAssertion::END_OF_INPUT:
+      return position == length;
+    case RegExpAssertion::END_OF_LINE:
+      return position == length || IsLineTerminator(CharAt(position));
+    case RegExpAssertion::BOUNDARY:
+    case RegExpAssertion::NON_BOUNDARY: {
+      bool word_before = position > 0 && IsRegExpWord(CharAt(position - 1));
+      bool word_after = position < length && IsRegExpWord(CharAt(position));
+      return (word_before != word_after) ==
+          (type == RegExpAssertion::BOUNDARY);
+    }
+  }
+  UNREACHABLE();
+  return false;
+}
+
+
+template <typename Char>
+void NfaClosure<Char>::AddThread(NfaThreadList* list,
+                                 int pc,
+                                 int* registers,
+                                 int position) {
+  memcpy(registers_.start(), registers, register_count_ * kIntSize);
+  Entry start = { pc, 0, 0 };
+  stack_.Add(start);
+  while (!stack_.is_empty()) {
+    Entry entry = stack_.RemoveLast();
+    if (entry.pc == kRestore) {
+      registers_[entry.reg] = entry.value;
+      continue;
+    }
+    pc = entry.pc;
+    for (;;) {
+      int visited_index = VisitedIndex(pc, position);
+      if (visited_[visited_index] == position) break;
+      visited_[visited_index] = position;
+      RegExpNfa::Instruction& instruction = program_->at(pc);
+      switch (instruction.opcode) {
+        case RegExpNfa::CONSUME:
+        case RegExpNfa::ACCEPT:
+          list->Add(pc, registers_.start());
+          break;
+        case RegExpNfa::SPLIT: {
+          // Register updates pushed while following the preferred branch
+          // are undone before the other branch is visited.
+          Entry other = { instruction.operand2, 0, 0 };
+          stack_.Add(other);
+          pc = instruction.operand;
+          continue;
+        }
+        case RegExpNfa::JUMP:
+          pc = instruction.operand;
+          continue;
+        case RegExpNfa::SAVE_POSITION:
+          SetRegister(instruction.operand, position);
+          pc++;
+          continue;
+        case RegExpNfa::CLEAR_REGISTERS:
+          for (int reg = instruction.operand;
+               reg <= instruction.operand2;
+               reg++) {
+            SetRegister(reg, -1);
+          }
+          pc++;
+          continue;
+        case RegExpNfa::CHECK_PROGRESS:
+          if (registers_[instruction.operand] == position) break;
+          pc++;
+          continue;
+        case RegExpNfa::ASSERTION:
+          if (!AssertionHolds(
+                  static_cast<RegExpAssertion::Type>(instruction.operand),
+                  position)) {
+            break;
+          }
+          pc++;
+          continue;
+      }
+      break;
+    }
+  }
+}
+
+
+static bool InRanges(ZoneList<CharacterRange>* ranges, uc16 c) {
+  // The ranges are in canonical form.
+  for (int i = 0; i < ranges->length(); i++) {
+    CharacterRange range = ranges->at(i);
+    if (c < range.from()) return false;
+    if (c <= range.to()) return true;
+  }
+  return false;
+}
+
+
+template <typename Char>
+bool RegExpNfa::MatchCharacters(Vector<const Char> subject,
+                                int index,
+                                int* output) {
+  int length = subject.length();
+  NfaClosure<Char> closure(program_, register_count_, subject);
+  NfaRegisterPool pool(register_count_);
+  NfaThreadList first(thread_count_, &pool);
+  NfaThreadList second(thread_count_, &pool);
+  NfaThreadList* current = &first;
+  NfaThreadList* next = &second;
+  ScopedVector<int> initial_registers(register_count_);
+  for (int i = 0; i < register_count_; i++) initial_registers[i] = -1;
+
+  bool matched = false;
+  for (int position = index; position <= length; position++) {
+    if (!matched && (!anchored_ || position == 0)) {
+      // A match starting here has lower priority than the matches
+      // starting at earlier positions that are still being tried.
+      closure.AddThread(current, 0, initial_registers.start(), position);
+    }
+    if (current->length() == 0) {
+      if (matched || anchored_) break;
+      continue;
+    }
+    next->Clear();
+    for (int i = 0; i < current->length(); i++) {
+      int pc = current->pc(i);
+      Instruction& instruction = program_->at(pc);
+      if (instruction.opcode == ACCEPT) {
+        // Threads after this one have lower priority and are dropped.
+        memcpy(output, current->registers(i),
+               capture_register_count_ * kIntSize);
+        matched = true;
+        break;
+      }
+      ASSERT(instruction.opcode == CONSUME);
+      if (position < length &&
+          InRanges(instruction.ranges, subject[position])) {
+        closure.AddThread(next, pc + 1, current->registers(i), position + 1);
+      }
+    }
+    NfaThreadList* swap = current;
+    current = next;
+    next = swap;
+  }
+  return matched;
+}
+
+
+bool RegExpNfa::Match(Handle<String> subject,
+                      int index,
+                      Vector<int32_t> output) {
+  ASSERT(subject->IsFlat());
+  ASSERT(output.length() >= capture_register_count_);
+  AssertNoAllocation no_gc;
+  if (subject->IsAsciiRepresentation()) {
+    return MatchCharacters(subject->ToAsciiVector(), index, output.start());
+  }
+  return MatchCharacters(subject->ToUC16Vector(), index, output.start());
+}
+
+
+} }  // namespace v8::internal
@@ -0,0 +1,118 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// A matcher for regular expressions that runs the nondeterministic
+// automaton of the expression on all candidate threads in lockstep, so the
+// time it takes is linear in the length of the subject.  Irregexp falls
+// back to it when the generated backtracking code exceeds its backtrack
+// budget.  Expressions with backreferences or lookaheads have no automaton
+// and are not supported.
+
+#ifndef V8_REGEXP_NFA_H_
+#define V8_REGEXP_NFA_H_
+
+namespace v8 {
+namespace internal {
+
+
+class RegExpNfa: public ZoneObject {
+ public:
+  // Upper bounds on the size of the compiled automaton.  Counted
+  // repetitions are unrolled, so large counts can exceed them.
+  static const int kMaxInstructions = 10000;
+  static const int kMaxRegisters = 1000;
+  // Upper bound on the registers of all threads that can be live at one
+  // position, which bounds the memory used by a match.
+  static const int kMaxThreadRegisters = 1 << 18;
+  // Loops whose body can match the empty string must make progress in
+  // every iteration, which makes the future of a thread depend on the
+  // loops it is in.  Their nesting depth is bounded.
+  static const int kMaxLoopDepth = 4;
+
+  enum Opcode {
+    CONSUME,          // Read a character in ranges and continue.
+    SPLIT,            // Continue at operand, with lower priority at operand2.
+    JUMP,             // Continue at operand.
+    SAVE_POSITION,    // Store the current position in register operand.
+    CLEAR_REGISTERS,  // Reset registers operand to operand2 to -1.
+    CHECK_PROGRESS,   // Fail if register operand holds the current position.
+    ASSERTION,        // Fail unless RegExpAssertion::Type operand holds.
+    ACCEPT
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    int operand;
+    int operand2;
+    ZoneList<CharacterRange>* ranges;
+    // The registers checked by the CHECK_PROGRESS instructions of the loops
+    // around this instruction, or NULL.
+    ZoneList<int>* loops;
+  };
+
+  // Compiles a parsed regular expression.  Returns NULL if the expression
+  // cannot be matched by an automaton or the automaton would be too large.
+  static RegExpNfa* Compile(RegExpTree* tree,
+                            int capture_count,
+                            bool ignore_case);
+
+  // Searches the flat subject for a match starting at or after index.  On
+  // success the capture positions are stored in output in the same format
+  // as the native irregexp code stores them, and true is returned.
+  bool Match(Handle<String> subject, int index, Vector<int32_t> output);
+
+ private:
+  RegExpNfa(ZoneList<Instruction>* program,
+            int capture_register_count,
+            int register_count,
+            int thread_count,
+            bool anchored)
+      : program_(program),
+        capture_register_count_(capture_register_count),
+        register_count_(register_count),
+        thread_count_(thread_count),
+        anchored_(anchored) { }
+
+  template <typename Char>
+  bool MatchCharacters(Vector<const Char> subject, int index, int* output);
+
+  ZoneList<Instruction>* program_;
+  // Registers holding capture positions come first, followed by registers
+  // used to detect empty iterations of loops.
+  int capture_register_count_;
+  int register_count_;
+  // Threads only wait at CONSUME and ACCEPT instructions, at most one per
+  // instruction, so this is the number of threads live at one position.
+  int thread_count_;
+  // Whether the expression can only match at the start of the input.
+  bool anchored_;
+};
+
+
+} }  // namespace v8::internal
+
+#endif  // V8_REGEXP_NFA_H_
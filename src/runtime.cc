@@ -49,6 +49,10 @@
 #include "v8threads.h"
 #include "string-search.h"
 
+#ifdef V8_HOST_CAN_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -1593,6 +1597,9 @@ static MaybeObject* Runtime_SpecialArrayFunctions(RUNTIME_CALLING_CONVENTION) {
   InstallBuiltin(isolate, holder, "slice", Builtins::ArraySlice);
   InstallBuiltin(isolate, holder, "splice", Builtins::ArraySplice);
   InstallBuiltin(isolate, holder, "concat", Builtins::ArrayConcat);
+  InstallBuiltin(isolate, holder, "indexOf", Builtins::ArrayIndexOf);
+  InstallBuiltin(isolate, holder, "lastIndexOf", Builtins::ArrayLastIndexOf);
+  InstallBuiltin(isolate, holder, "join", Builtins::ArrayJoin);
 
   return *holder;
 }
@@ -1872,6 +1879,53 @@ MUST_USE_RESULT static MaybeObject* CharFromCode(Isolate* isolate,
 }
 
 
+// Long cons strings (ropes) are read in place instead of being flattened
+// when an operation only looks at part of them.  The work spent walking a
+// rope is accumulated, and once it exceeds the cost of flattening, which
+// is proportional to the rope's length, the rope is flattened so that
+// further accesses take the fast paths.  Only the most recently read rope
+// is tracked.  Work is measured in characters copied by flattening.
+static const int kMinRopeLengthToReadInPlace = 256;
+// Work charged for each cons string or leaf visited.  Visiting a cons
+// string is a dependent load that often misses the cache, so it costs
+// about as much as copying a few hundred characters.
+static const int kRopeStepWork = 256;
+// Work charged for each in-place access on top of the tree walk, to
+// account for staying off the fast paths.
+static const int kRopeAccessWork = 64;
+
+
+// Returns the work that can still be spent reading the rope in place
+// before flattening it would have been cheaper.
+static int RemainingRopeWork(Isolate* isolate, String* rope) {
+  if (isolate->rope_access_address() != rope->address()) return rope->length();
+  return rope->length() - isolate->rope_access_work();
+}
+
+
+static bool ShouldReadRopeInPlace(Isolate* isolate, String* string) {
+  if (string->IsFlat()) return false;
+  if (string->length() < kMinRopeLengthToReadInPlace) return false;
+  return RemainingRopeWork(isolate, string) > 0;
+}
+
+
+// The number of cons strings and leaves a cursor may visit in the rope.
+static int MaxRopeSteps(Isolate* isolate, String* rope) {
+  return RemainingRopeWork(isolate, rope) / kRopeStepWork;
+}
+
+
+static void ChargeRopeAccess(Isolate* isolate, String* rope, int steps) {
+  if (isolate->rope_access_address() != rope->address()) {
+    isolate->set_rope_access_address(rope->address());
+    isolate->set_rope_access_work(0);
+  }
+  isolate->set_rope_access_work(
+      isolate->rope_access_work() + kRopeAccessWork + steps * kRopeStepWork);
+}
+
+
 static MaybeObject* Runtime_StringCharCodeAt(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation ha;
@@ -1892,6 +1946,16 @@ static MaybeObject* Runtime_StringCharCodeAt(RUNTIME_CALLING_CONVENTION) {
     i = static_cast<uint32_t>(DoubleToInteger(value));
   }
 
+  if (ShouldReadRopeInPlace(isolate, subject)) {
+    if (i >= static_cast<uint32_t>(subject->length())) {
+      return isolate->heap()->nan_value();
+    }
+    StringCharacterCursor cursor(subject, MaxRopeSteps(isolate, subject));
+    uint16_t result = cursor.Get(i);
+    ChargeRopeAccess(isolate, subject, cursor.steps());
+    if (!cursor.has_given_up()) return Smi::FromInt(result);
+  }
+
   // Flatten the string.  If someone wants to get a char at an index
   // in a cons string, it is likely that more indices will be
   // accessed.
@@ -2694,30 +2758,15 @@ static MaybeObject* Runtime_StringReplaceRegExpWithString(
 }
 
 
-// Perform string match of pattern on subject, starting at start index.
-// Caller must ensure that 0 <= start_index <= sub->length(),
-// and should check that pat->length() + start_index <= sub->length().
-int Runtime::StringMatch(Isolate* isolate,
-                         Handle<String> sub,
-                         Handle<String> pat,
-                         int start_index) {
-  ASSERT(0 <= start_index);
-  ASSERT(start_index <= sub->length());
-
-  int pattern_length = pat->length();
-  if (pattern_length == 0) return start_index;
-
-  int subject_length = sub->length();
-  if (start_index + pattern_length > subject_length) return -1;
-
-  if (!sub->IsFlat()) FlattenString(sub);
-  if (!pat->IsFlat()) FlattenString(pat);
-
-  AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
+// Searches the flat string sub for the flat string pat.
+static int FlatStringMatch(Isolate* isolate,
+                           String* sub,
+                           String* pat,
+                           int start_index) {
   // Extract flattened substrings of cons strings before determining asciiness.
-  String* seq_sub = *sub;
+  String* seq_sub = sub;
   if (seq_sub->IsConsString()) seq_sub = ConsString::cast(seq_sub)->first();
-  String* seq_pat = *pat;
+  String* seq_pat = pat;
   if (seq_pat->IsConsString()) seq_pat = ConsString::cast(seq_pat)->first();
 
   // dispatch on type of strings
@@ -2748,6 +2797,95 @@ int Runtime::StringMatch(Isolate* isolate,
 }
 
 
+// Searches the cons string sub for the flat string pat without flattening
+// sub.  Each leaf of sub is searched in turn, and matches that straddle
+// the end of a leaf are checked character by character.  Gives up and
+// returns false if walking the rope becomes more expensive than flattening
+// it, in which case no match starts before *index.
+static bool RopeStringMatch(Isolate* isolate,
+                            String* sub,
+                            String* pat,
+                            int* index,
+                            int* result) {
+  int pattern_length = pat->length();
+  int last_index = sub->length() - pattern_length;
+  int max_steps = MaxRopeSteps(isolate, sub);
+  StringCharacterCursor subject_cursor(sub, max_steps);
+  StringCharacterCursor pattern_cursor(pat, kMaxInt);
+  int leaves = 0;
+  bool finished = false;
+  *result = -1;
+  while (true) {
+    if (*index > last_index) {
+      finished = true;
+      break;
+    }
+    int leaf_start;
+    String* leaf = subject_cursor.LeafAt(*index, &leaf_start);
+    if (leaf == NULL) break;
+    leaves++;
+    if (subject_cursor.steps() + leaves > max_steps) break;
+    int leaf_end = leaf_start + leaf->length();
+    if (leaf_end - *index >= pattern_length) {
+      int found = FlatStringMatch(isolate, leaf, pat, *index - leaf_start);
+      if (found >= 0) {
+        *result = leaf_start + found;
+        finished = true;
+        break;
+      }
+      *index = leaf_end - pattern_length + 1;
+    }
+    for (; *index < leaf_end && *index <= last_index; (*index)++) {
+      int j = 0;
+      while (j < pattern_length &&
+             subject_cursor.Get(*index + j) == pattern_cursor.Get(j)) {
+        j++;
+      }
+      if (subject_cursor.has_given_up()) break;
+      if (j == pattern_length) {
+        *result = *index;
+        finished = true;
+        break;
+      }
+    }
+    if (finished || subject_cursor.has_given_up()) break;
+  }
+  ChargeRopeAccess(isolate, sub, subject_cursor.steps() + leaves);
+  return finished;
+}
+
+
+// Perform string match of pattern on subject, starting at start index.
+// Caller must ensure that 0 <= start_index <= sub->length(),
+// and should check that pat->length() + start_index <= sub->length().
+int Runtime::StringMatch(Isolate* isolate,
+                         Handle<String> sub,
+                         Handle<String> pat,
+                         int start_index) {
+  ASSERT(0 <= start_index);
+  ASSERT(start_index <= sub->length());
+
+  int pattern_length = pat->length();
+  if (pattern_length == 0) return start_index;
+
+  int subject_length = sub->length();
+  if (start_index + pattern_length > subject_length) return -1;
+
+  if (!pat->IsFlat()) FlattenString(pat);
+  if (ShouldReadRopeInPlace(isolate, *sub)) {
+    AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
+    int result;
+    if (RopeStringMatch(isolate, *sub, *pat, &start_index, &result)) {
+      return result;
+    }
+  }
+  if (!sub->IsFlat()) FlattenString(sub);
+
+  AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
+  return FlatStringMatch(isolate, *sub, *pat, start_index);
+}
+
+
 static MaybeObject* Runtime_StringIndexOf(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   HandleScope scope(isolate);  // create a new handle scope
@@ -2932,7 +3070,19 @@ static MaybeObject* Runtime_SubString(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_ASSERT(start >= 0);
   RUNTIME_ASSERT(end <= value->length());
   isolate->counters()->sub_string_runtime()->Increment();
-  return value->SubString(start, end);
+  if (start < end && ShouldReadRopeInPlace(isolate, value)) {
+    StringCharacterCursor cursor(value, MaxRopeSteps(isolate, value));
+    int leaf_start;
+    String* leaf = cursor.LeafAt(start, &leaf_start);
+    ChargeRopeAccess(isolate, value, cursor.steps());
+    if (leaf != NULL) {
+      if (end - leaf_start <= leaf->length()) {
+        return leaf->SubString(start - leaf_start, end - leaf_start);
+      }
+      return value->SubString(start, end);
+    }
+  }
+  return value->TryFlattenGetString()->SubString(start, end);
 }
 
 
@@ -5060,10 +5210,10 @@ enum AsciiCaseConversion {
 
 template <AsciiCaseConversion dir>
 struct FastAsciiConverter {
-  static bool Convert(char* dst, char* src, int length) {
+  static bool Convert(char* dst, const char* src, int length) {
 #ifdef DEBUG
     char* saved_dst = dst;
-    char* saved_src = src;
+    const char* saved_src = src;
 #endif
     // We rely on the distance between upper and lower case letters
     // being a known power of 2.
@@ -5072,12 +5222,30 @@ struct FastAsciiConverter {
     const char lo = (dir == ASCII_TO_LOWER) ? 'A' - 1 : 'a' - 1;
     const char hi = (dir == ASCII_TO_LOWER) ? 'Z' + 1 : 'z' + 1;
     bool changed = false;
-    char* const limit = src + length;
-#ifdef V8_HOST_CAN_READ_UNALIGNED
+    const char* const limit = src + length;
+#if defined(V8_HOST_CAN_USE_SSE2)
+    // Convert sixteen characters at a time.  ASCII characters compare
+    // correctly as signed bytes.
+    const __m128i lo_bound = _mm_set1_epi8(lo);
+    const __m128i hi_bound = _mm_set1_epi8(hi);
+    const __m128i case_bit = _mm_set1_epi8(1 << 5);
+    __m128i converted = _mm_setzero_si128();
+    while (src <= limit - sizeof(__m128i)) {
+      __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+      __m128i m = _mm_and_si128(_mm_cmpgt_epi8(w, lo_bound),
+                                _mm_cmpgt_epi8(hi_bound, w));
+      converted = _mm_or_si128(converted, m);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                       _mm_xor_si128(w, _mm_and_si128(m, case_bit)));
+      src += sizeof(__m128i);
+      dst += sizeof(__m128i);
+    }
+    changed = _mm_movemask_epi8(converted) != 0;
+#elif defined(V8_HOST_CAN_READ_UNALIGNED)
     // Process the prefix of the input that requires no conversion one
     // (machine) word at a time.
     while (src <= limit - sizeof(uintptr_t)) {
-      uintptr_t w = *reinterpret_cast<uintptr_t*>(src);
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(src);
       if (AsciiRangeMask(w, lo, hi) != 0) {
         changed = true;
         break;
@@ -5089,7 +5257,7 @@ struct FastAsciiConverter {
     // Process the remainder of the input performing conversion when
     // required one word at a time.
     while (src <= limit - sizeof(uintptr_t)) {
-      uintptr_t w = *reinterpret_cast<uintptr_t*>(src);
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(src);
       uintptr_t m = AsciiRangeMask(w, lo, hi);
       // The mask has high (7th) bit set in every byte that needs
       // conversion and we know that the distance between cases is
@@ -5100,7 +5268,7 @@ struct FastAsciiConverter {
     }
 #endif
     // Process the last few bytes of the input (or the whole input if
-    // unaligned access is not supported).
+    // neither SSE2 nor unaligned access is supported).
     while (src < limit) {
       char c = *src;
       if (lo < c && c < hi) {
@@ -5118,7 +5286,8 @@ struct FastAsciiConverter {
   }
 
 #ifdef DEBUG
-  static void CheckConvert(char* dst, char* src, int length, bool changed) {
+  static void CheckConvert(char* dst, const char* src, int length,
+                           bool changed) {
     bool expected_changed = false;
     for (int i = 0; i < length; i++) {
       if (dst[i] == src[i]) continue;
@@ -5173,14 +5342,14 @@ MUST_USE_RESULT static MaybeObject* ConvertCase(
   // character is also ascii.  This is currently the case, but it
   // might break in the future if we implement more context and locale
   // dependent upper/lower conversions.
-  if (s->IsSeqAsciiString()) {
+  if (s->IsFlat() && s->IsAsciiRepresentation()) {
     Object* o;
     { MaybeObject* maybe_o = isolate->heap()->AllocateRawAsciiString(length);
       if (!maybe_o->ToObject(&o)) return maybe_o;
     }
     SeqAsciiString* result = SeqAsciiString::cast(o);
     bool has_changed_character = ConvertTraits::AsciiConverter::Convert(
-        result->GetChars(), SeqAsciiString::cast(s)->GetChars(), length);
+        result->GetChars(), s->ToAsciiVector().start(), length);
     return has_changed_character ? result : s;
   }
 
@@ -5215,6 +5384,74 @@ static MaybeObject* Runtime_StringToUpperCase(RUNTIME_CALLING_CONVENTION) {
 }
 
 
+// Trim white space in ASCII strings: tab, line feed, vertical tab, form
+// feed, carriage return and space.
+static inline bool IsAsciiTrimWhiteSpace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+#ifdef V8_HOST_CAN_USE_SSE2
+// Returns a movemask with a bit set for every one of the sixteen ASCII
+// characters that is not trim white space.
+static inline int AsciiNonWhiteSpaceMask(const char* chars) {
+  __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+  __m128i space = _mm_or_si128(
+      _mm_cmpeq_epi8(w, _mm_set1_epi8(' ')),
+      _mm_and_si128(_mm_cmpgt_epi8(w, _mm_set1_epi8('\t' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('\r' + 1), w)));
+  return ~_mm_movemask_epi8(space) & 0xFFFF;
+}
+#endif  // V8_HOST_CAN_USE_SSE2
+
+
+// Narrows [*left, *right) of a flat ASCII string to exclude leading and/or
+// trailing trim white space.
+static void TrimAscii(Vector<const char> chars,
+                      bool trim_left,
+                      bool trim_right,
+                      int* left,
+                      int* right) {
+  const char* start = chars.start();
+  int l = *left;
+  int r = *right;
+  if (trim_left) {
+#ifdef V8_HOST_CAN_USE_SSE2
+    // Most strings have no white space to trim, so check the first
+    // character before going sixteen at a time.
+    if (l < r && IsAsciiTrimWhiteSpace(start[l])) {
+      static const int kStep = sizeof(__m128i);
+      for (; l <= r - kStep; l += kStep) {
+        int mask = AsciiNonWhiteSpaceMask(start + l);
+        if (mask != 0) {
+          l += LowestSetBit(mask);
+          break;
+        }
+      }
+    }
+#endif  // V8_HOST_CAN_USE_SSE2
+    while (l < r && IsAsciiTrimWhiteSpace(start[l])) l++;
+  }
+  if (trim_right) {
+#ifdef V8_HOST_CAN_USE_SSE2
+    if (l < r && IsAsciiTrimWhiteSpace(start[r - 1])) {
+      static const int kStep = sizeof(__m128i);
+      for (; r - kStep >= l; r -= kStep) {
+        int mask = AsciiNonWhiteSpaceMask(start + r - kStep);
+        if (mask != 0) {
+          r -= kStep - 1 - HighestSetBit(mask);
+          break;
+        }
+      }
+    }
+#endif  // V8_HOST_CAN_USE_SSE2
+    while (r > l && IsAsciiTrimWhiteSpace(start[r - 1])) r--;
+  }
+  *left = l;
+  *right = r;
+}
+
+
 static inline bool IsTrimWhiteSpace(unibrow::uchar c) {
   return unibrow::WhiteSpace::Is(c) || c == 0x200b;
 }
@@ -5233,13 +5470,22 @@ static MaybeObject* Runtime_StringTrim(RUNTIME_CALLING_CONVENTION) {
   int length = s->length();
 
   int left = 0;
+  int right = length;
+  String* flat = s;
+  if (flat->IsConsString() && flat->IsFlat()) {
+    flat = ConsString::cast(flat)->first();
+  }
+  if (flat->IsFlat() && flat->IsAsciiRepresentation()) {
+    TrimAscii(flat->ToAsciiVector(), trimLeft, trimRight, &left, &right);
+    return s->SubString(left, right);
+  }
+
   if (trimLeft) {
     while (left < length && IsTrimWhiteSpace(s->Get(left))) {
       left++;
     }
   }
 
-  int right = length;
   if (trimRight) {
     while (right > left && IsTrimWhiteSpace(s->Get(right - 1))) {
       right--;
@@ -5817,6 +6063,158 @@ static MaybeObject* Runtime_StringBuilderConcat(RUNTIME_CALLING_CONVENTION) {
 }
 
 
+// The string builder used by the natives (StringBuilder and
+// ReplaceResultBuilder in string.js) keeps its characters in a sequential
+// string whose length is the capacity of the builder; the number of
+// characters in use is tracked by the caller.  Until the first string is
+// added the builder holds a smi with the capacity to start out with.  The
+// buffer starts out as an ASCII string and is widened to a two-byte string
+// the first time a non-ASCII string is added.  It is never visible outside
+// the natives until Runtime_StringBuilderFinish has trimmed it to its final
+// length.
+static const int kStringBuilderMinCapacity = 16;
+
+
+static bool IsValidStringBuilder(Object* buffer, int length) {
+  if (length < 0) return false;
+  if (buffer->IsSmi()) return length == 0 && Smi::cast(buffer)->value() >= 0;
+  return buffer->IsSeqString() && length <= String::cast(buffer)->length();
+}
+
+
+// Writes string[start..end) at position length of the buffer, reallocating
+// the buffer if it is too short or too narrow.  Returns the buffer that
+// holds the result.
+static MaybeObject* StringBuilderAppend(Isolate* isolate,
+                                        Object* buffer_object,
+                                        int length,
+                                        String* string,
+                                        int start,
+                                        int end) {
+  ASSERT(IsValidStringBuilder(buffer_object, length));
+  int add_length = end - start;
+  if (add_length == 0) return buffer_object;
+  String* buffer;
+  int min_capacity;
+  if (buffer_object->IsSmi()) {
+    buffer = isolate->heap()->empty_string();
+    min_capacity = Min(Smi::cast(buffer_object)->value(), String::kMaxLength);
+  } else {
+    buffer = String::cast(buffer_object);
+    min_capacity = 0;
+  }
+  int capacity = buffer->length();
+  bool ascii = buffer->IsAsciiRepresentation();
+  bool widen = ascii && !string->HasOnlyAsciiChars();
+  if (add_length > capacity - length || widen) {
+    if (add_length > String::kMaxLength - length) {
+      isolate->context()->mark_out_of_memory();
+      return Failure::OutOfMemoryException();
+    }
+    int new_capacity = capacity;
+    if (add_length > capacity - length) {
+      new_capacity = Min(Max(capacity * 2, kStringBuilderMinCapacity),
+                         String::kMaxLength);
+      new_capacity = Max(Max(new_capacity, min_capacity),
+                         length + add_length);
+    }
+    ascii = ascii && !widen;
+    Object* object;
+    { MaybeObject* maybe_object = ascii
+          ? isolate->heap()->AllocateRawAsciiString(new_capacity)
+          : isolate->heap()->AllocateRawTwoByteString(new_capacity);
+      if (!maybe_object->ToObject(&object)) return maybe_object;
+    }
+    String* new_buffer = String::cast(object);
+    if (ascii) {
+      String::WriteToFlat(buffer,
+                          SeqAsciiString::cast(new_buffer)->GetChars(),
+                          0,
+                          length);
+    } else {
+      String::WriteToFlat(buffer,
+                          SeqTwoByteString::cast(new_buffer)->GetChars(),
+                          0,
+                          length);
+    }
+    buffer = new_buffer;
+  }
+  if (ascii) {
+    String::WriteToFlat(string,
+                        SeqAsciiString::cast(buffer)->GetChars() + length,
+                        start,
+                        end);
+  } else {
+    String::WriteToFlat(string,
+                        SeqTwoByteString::cast(buffer)->GetChars() + length,
+                        start,
+                        end);
+  }
+  return buffer;
+}
+
+
+static MaybeObject* Runtime_StringBuilderAdd(RUNTIME_CALLING_CONVENTION) {
+  RUNTIME_GET_ISOLATE;
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 3);
+  CONVERT_SMI_CHECKED(length, args[1]);
+  RUNTIME_ASSERT(IsValidStringBuilder(args[0], length));
+  CONVERT_CHECKED(String, string, args[2]);
+  return StringBuilderAppend(isolate,
+                             args[0],
+                             length,
+                             string,
+                             0,
+                             string->length());
+}
+
+
+static MaybeObject* Runtime_StringBuilderAddSlice(RUNTIME_CALLING_CONVENTION) {
+  RUNTIME_GET_ISOLATE;
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 5);
+  CONVERT_SMI_CHECKED(length, args[1]);
+  RUNTIME_ASSERT(IsValidStringBuilder(args[0], length));
+  CONVERT_CHECKED(String, string, args[2]);
+  CONVERT_SMI_CHECKED(start, args[3]);
+  CONVERT_SMI_CHECKED(end, args[4]);
+  RUNTIME_ASSERT(start >= 0 && start <= end && end <= string->length());
+  return StringBuilderAppend(isolate, args[0], length, string, start, end);
+}
+
+
+static MaybeObject* Runtime_StringBuilderFinish(RUNTIME_CALLING_CONVENTION) {
+  RUNTIME_GET_ISOLATE;
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 2);
+  CONVERT_SMI_CHECKED(length, args[1]);
+  RUNTIME_ASSERT(IsValidStringBuilder(args[0], length));
+  if (length == 0) return isolate->heap()->empty_string();
+  SeqString* buffer = SeqString::cast(args[0]);
+  int capacity = buffer->length();
+  if (length == capacity) return buffer;
+
+  // Shorten the buffer in place and fill the unused tail.
+  int string_size;
+  int allocated_size;
+  if (buffer->IsAsciiRepresentation()) {
+    string_size = SeqAsciiString::SizeFor(length);
+    allocated_size = SeqAsciiString::SizeFor(capacity);
+  } else {
+    string_size = SeqTwoByteString::SizeFor(length);
+    allocated_size = SeqTwoByteString::SizeFor(capacity);
+  }
+  buffer->set_length(length);
+  int delta = allocated_size - string_size;
+  if (delta > 0) {
+    isolate->heap()->CreateFillerObjectAt(buffer->address() + string_size,
+                                          delta);
+  }
+  return buffer;
+}
+
+
 static MaybeObject* Runtime_NumberOr(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
   NoHandleAllocation ha;
@@ -7910,6 +8308,26 @@ static uint32_t IterateElements(Isolate* isolate,
       }
       break;
     }
+    case JSObject::FAST_DOUBLE_ELEMENTS: {
+      Handle<FixedDoubleArray> elements(
+          FixedDoubleArray::cast(receiver->elements()));
+      uint32_t len = elements->length();
+      if (range < len) {
+        len = range;
+      }
+
+      for (uint32_t j = 0; j < len; j++) {
+        if (!elements->is_the_hole(j)) {
+          num_of_elements++;
+          if (visitor) {
+            Handle<Object> e =
+                isolate->factory()->NewNumber(elements->get_scalar(j));
+            visitor->visit(j, e);
+          }
+        }
+      }
+      break;
+    }
     case JSObject::PIXEL_ELEMENTS: {
       Handle<PixelArray> pixels(PixelArray::cast(receiver->elements()));
       uint32_t len = pixels->length();
@@ -8222,6 +8640,157 @@ static MaybeObject* Runtime_RemoveArrayHoles(RUNTIME_CALLING_CONVENTION) {
 }
 
 
+// An element of an array sorted by Runtime_SortArrayDefault: its index
+// in the array and the key the default comparison orders it by.
+struct DefaultSortEntry {
+  int index;
+  int64_t smi_key;
+  String* string_key;
+};
+
+
+// Returns a key whose order is the order of the string representations
+// of smis.  The decimal digits are stored as 1 to 10 in base 11, so that
+// a prefix comes first, and negative numbers come before the others
+// because '-' is less than any digit.
+static int64_t SmiLexicographicKey(int value) {
+  static const int kMaxDigits = 10;
+  static const int kElevenToTheFifth = 11 * 11 * 11 * 11 * 11;
+  static const int64_t kNonNegativeOffset =
+      static_cast<int64_t>(kElevenToTheFifth) * kElevenToTheFifth;
+  int64_t magnitude = value;
+  if (value < 0) magnitude = -magnitude;
+  int digits[kMaxDigits];
+  int count = 0;
+  do {
+    digits[count++] = static_cast<int>(magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0);
+  int64_t key = 0;
+  for (int i = 0; i < kMaxDigits; i++) {
+    key = key * 11 + (i < count ? digits[count - 1 - i] + 1 : 0);
+  }
+  return value < 0 ? key : key + kNonNegativeOffset;
+}
+
+
+// Both comparisons fall back to the original order, so the sort is stable.
+static int CompareSmiKeys(const DefaultSortEntry* x,
+                          const DefaultSortEntry* y) {
+  if (x->smi_key != y->smi_key) return x->smi_key < y->smi_key ? -1 : 1;
+  return x->index - y->index;
+}
+
+
+static int CompareStringKeys(const DefaultSortEntry* x,
+                             const DefaultSortEntry* y) {
+  int result =
+      Smi::cast(FlatStringCompare(x->string_key, y->string_key))->value();
+  return result != 0 ? result : x->index - y->index;
+}
+
+
+// Sorts an array whose elements are all numbers or strings the way
+// Array.prototype.sort does without a comparison function, but without
+// calling back into JavaScript.  Returns false and leaves the array
+// alone if it has holes or elements of other types.
+static MaybeObject* Runtime_SortArrayDefault(RUNTIME_CALLING_CONVENTION) {
+  RUNTIME_GET_ISOLATE;
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 1);
+  CONVERT_ARG_CHECKED(JSArray, array, 0);
+  Heap* heap = isolate->heap();
+
+  bool is_double = array->HasFastDoubleElements();
+  if ((!is_double && !array->HasFastElements()) ||
+      !array->length()->IsSmi()) {
+    return heap->false_value();
+  }
+  int length = Smi::cast(array->length())->value();
+  if (length < 2) return heap->true_value();
+  int capacity = is_double
+      ? FixedDoubleArray::cast(array->elements())->length()
+      : FixedArray::cast(array->elements())->length();
+  if (length > capacity) return heap->false_value();
+
+  bool all_smis = !is_double;
+  if (is_double) {
+    FixedDoubleArray* elements = FixedDoubleArray::cast(array->elements());
+    for (int i = 0; i < length; i++) {
+      if (elements->is_the_hole(i)) return heap->false_value();
+    }
+  } else {
+    FixedArray* elements = FixedArray::cast(array->elements());
+    for (int i = 0; i < length; i++) {
+      Object* element = elements->get(i);
+      if (element->IsSmi()) continue;
+      if (!element->IsString() && !element->IsHeapNumber()) {
+        return heap->false_value();
+      }
+      all_smis = false;
+    }
+    Object* obj;
+    { MaybeObject* maybe_obj = array->EnsureWritableFastElements();
+      if (!maybe_obj->ToObject(&obj)) return maybe_obj;
+    }
+  }
+
+  // Unless all elements are smis they are compared by their string
+  // values, which are computed and flattened up front.
+  Handle<FixedArray> keys;
+  if (!all_smis) {
+    keys = isolate->factory()->NewFixedArray(length);
+    for (int i = 0; i < length; i++) {
+      Handle<Object> element;
+      if (is_double) {
+        double value = FixedDoubleArray::cast(array->elements())->get_scalar(i);
+        element = isolate->factory()->NewNumber(value);
+      } else {
+        element = Handle<Object>(FixedArray::cast(array->elements())->get(i));
+      }
+      Handle<String> key;
+      if (element->IsString()) {
+        key = FlattenGetString(Handle<String>::cast(element));
+      } else {
+        key = isolate->factory()->NumberToString(element);
+      }
+      keys->set(i, *key);
+    }
+  }
+
+  AssertNoAllocation no_allocation;
+  ScopedVector<DefaultSortEntry> entries(length);
+  for (int i = 0; i < length; i++) {
+    entries[i].index = i;
+    if (all_smis) {
+      Object* element = FixedArray::cast(array->elements())->get(i);
+      entries[i].smi_key = SmiLexicographicKey(Smi::cast(element)->value());
+    } else {
+      entries[i].string_key = String::cast(keys->get(i));
+    }
+  }
+  entries.Sort(all_smis ? CompareSmiKeys : CompareStringKeys);
+
+  if (is_double) {
+    FixedDoubleArray* elements = FixedDoubleArray::cast(array->elements());
+    ScopedVector<double> values(length);
+    for (int i = 0; i < length; i++) values[i] = elements->get_scalar(i);
+    for (int i = 0; i < length; i++) {
+      elements->set(i, values[entries[i].index]);
+    }
+  } else {
+    FixedArray* elements = FixedArray::cast(array->elements());
+    ScopedVector<Object*> values(length);
+    for (int i = 0; i < length; i++) values[i] = elements->get(i);
+    WriteBarrierMode mode = elements->GetWriteBarrierMode(no_allocation);
+    for (int i = 0; i < length; i++) {
+      elements->set(i, values[entries[i].index], mode);
+    }
+  }
+  return heap->true_value();
+}
+
+
 // Move contents of argument 0 (an array) to argument 1 (an array)
 static MaybeObject* Runtime_MoveArrayContents(RUNTIME_CALLING_CONVENTION) {
   RUNTIME_GET_ISOLATE;
@@ -8320,12 +8889,14 @@ static MaybeObject* Runtime_GetArrayKeys(RUNTIME_CALLING_CONVENTION) {
     }
     return *isolate->factory()->NewJSArrayWithElements(keys);
   } else {
-    ASSERT(array->HasFastElements());
+    ASSERT(array->HasFastElements() || array->HasFastDoubleElements());
     Handle<FixedArray> single_interval = isolate->factory()->NewFixedArray(2);
     // -1 means start of array.
     single_interval->set(0, Smi::FromInt(-1));
-    uint32_t actual_length =
-        static_cast<uint32_t>(FixedArray::cast(array->elements())->length());
+    uint32_t actual_length = array->HasFastDoubleElements()
+        ? static_cast<uint32_t>(
+              FixedDoubleArray::cast(array->elements())->length())
+        : static_cast<uint32_t>(FixedArray::cast(array->elements())->length());
     uint32_t min_length = actual_length < length ? actual_length : length;
     Handle<Object> length_object =
         isolate->factory()->NewNumber(static_cast<double>(min_length));
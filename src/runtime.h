@@ -123,6 +123,9 @@ namespace internal {
   \
   F(StringAdd, 2, 1) \
   F(StringBuilderConcat, 3, 1) \
+  F(StringBuilderAdd, 3, 1) \
+  F(StringBuilderAddSlice, 5, 1) \
+  F(StringBuilderFinish, 2, 1) \
   \
   /* Bit operations */ \
   F(NumberOr, 2, 1) \
@@ -242,6 +245,7 @@ namespace internal {
   \
   /* Arrays */ \
   F(RemoveArrayHoles, 2, 1) \
+  F(SortArrayDefault, 1, 1) \
   F(GetArrayKeys, 2, 1) \
   F(MoveArrayContents, 2, 1) \
   F(EstimateNumberOfElements, 1, 1) \
@@ -132,12 +132,14 @@ Scope::Scope(Type type)
     scope_inside_with_(false),
     scope_contains_with_(false),
     scope_calls_eval_(false),
+    arguments_loads_only_(false),
     outer_scope_calls_eval_(false),
     inner_scope_calls_eval_(false),
     outer_scope_is_eval_scope_(false),
     force_eager_compilation_(false),
     num_stack_slots_(0),
-    num_heap_slots_(0) {
+    num_heap_slots_(0),
+    arguments_read_from_frame_(false) {
 }
 
 
@@ -159,12 +161,14 @@ Scope::Scope(Scope* outer_scope, Type type)
     scope_inside_with_(false),
     scope_contains_with_(false),
     scope_calls_eval_(false),
+    arguments_loads_only_(false),
     outer_scope_calls_eval_(false),
     inner_scope_calls_eval_(false),
     outer_scope_is_eval_scope_(false),
     force_eager_compilation_(false),
     num_stack_slots_(0),
-    num_heap_slots_(0) {
+    num_heap_slots_(0),
+    arguments_read_from_frame_(false) {
   // At some point we might want to provide outer scopes to
   // eval scopes (by walking the stack and reading the scope info).
   // In that case, the ASSERT below needs to be adjusted.
@@ -173,8 +177,354 @@ Scope::Scope(Scope* outer_scope, Type type)
 }
 
 
+// Finds the functions that use 'arguments' only in 'arguments.length' and
+// 'arguments[key]' loads and never assign to their parameters.  Variables
+// are not resolved yet, so 'arguments' and the parameters are recognized
+// by name; functions where that is not enough, because they contain 'with'
+// or call eval, are excluded when the variables are allocated.
+class ArgumentsUsageAnalyzer: public AstVisitor {
+ public:
+  ArgumentsUsageAnalyzer() : scope_(NULL), loads_only_(true) { }
+
+  void Analyze(FunctionLiteral* function);
+
+ private:
+  bool IsArguments(Expression* expr);
+  bool IsParameter(Expression* expr);
+
+  // Visits the target of an assignment, count operation or delete.
+  void VisitReference(Expression* expr);
+
+  // AST node visit functions.
+#define DECLARE_VISIT(type) virtual void Visit##type(type* node);
+  AST_NODE_LIST(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+  Scope* scope_;
+  bool loads_only_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArgumentsUsageAnalyzer);
+};
+
+
+void ArgumentsUsageAnalyzer::Analyze(FunctionLiteral* function) {
+  // Inner functions have their own 'arguments' and are analyzed on their
+  // own.
+  Scope* outer_scope = scope_;
+  bool outer_loads_only = loads_only_;
+  scope_ = function->scope();
+  loads_only_ = true;
+  VisitDeclarations(scope_->declarations());
+  VisitStatements(function->body());
+  if (scope_->is_function_scope() && loads_only_ && !HasStackOverflow()) {
+    scope_->RecordArgumentsLoadsOnly();
+  }
+  scope_ = outer_scope;
+  loads_only_ = outer_loads_only;
+}
+
+
+bool ArgumentsUsageAnalyzer::IsArguments(Expression* expr) {
+  VariableProxy* proxy = expr->AsVariableProxy();
+  return proxy != NULL &&
+      proxy->name().is_identical_to(FACTORY->arguments_symbol());
+}
+
+
+bool ArgumentsUsageAnalyzer::IsParameter(Expression* expr) {
+  VariableProxy* proxy = expr->AsVariableProxy();
+  if (proxy == NULL || !scope_->is_function_scope()) return false;
+  for (int i = 0; i < scope_->num_parameters(); i++) {
+    if (proxy->name().is_identical_to(scope_->parameter(i)->name())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+void ArgumentsUsageAnalyzer::VisitReference(Expression* expr) {
+  Property* prop = expr->AsProperty();
+  if (prop != NULL) {
+    // Stores to and deletes from 'arguments' need the object.
+    Visit(prop->obj());
+    Visit(prop->key());
+  } else {
+    // Assigning to a parameter would have to update the arguments.
+    if (IsParameter(expr)) loads_only_ = false;
+    Visit(expr);
+  }
+}
+
+
+void ArgumentsUsageAnalyzer::VisitDeclaration(Declaration* decl) {
+  if (IsArguments(decl->proxy())) loads_only_ = false;
+  if (decl->fun() != NULL) {
+    if (IsParameter(decl->proxy())) loads_only_ = false;
+    Visit(decl->fun());
+  }
+}
+
+
+void ArgumentsUsageAnalyzer::VisitBlock(Block* stmt) {
+  VisitStatements(stmt->statements());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitExpressionStatement(
+    ExpressionStatement* stmt) {
+  Visit(stmt->expression());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitEmptyStatement(EmptyStatement* stmt) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitIfStatement(IfStatement* stmt) {
+  Visit(stmt->condition());
+  Visit(stmt->then_statement());
+  Visit(stmt->else_statement());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitContinueStatement(ContinueStatement* stmt) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitBreakStatement(BreakStatement* stmt) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitReturnStatement(ReturnStatement* stmt) {
+  Visit(stmt->expression());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitWithEnterStatement(
+    WithEnterStatement* stmt) {
+  Visit(stmt->expression());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitWithExitStatement(WithExitStatement* stmt) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitSwitchStatement(SwitchStatement* stmt) {
+  Visit(stmt->tag());
+  for (int i = 0; i < stmt->cases()->length(); i++) {
+    CaseClause* clause = stmt->cases()->at(i);
+    if (!clause->is_default()) Visit(clause->label());
+    VisitStatements(clause->statements());
+  }
+}
+
+
+void ArgumentsUsageAnalyzer::VisitDoWhileStatement(DoWhileStatement* stmt) {
+  Visit(stmt->body());
+  Visit(stmt->cond());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitWhileStatement(WhileStatement* stmt) {
+  Visit(stmt->cond());
+  Visit(stmt->body());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitForStatement(ForStatement* stmt) {
+  if (stmt->init() != NULL) Visit(stmt->init());
+  if (stmt->cond() != NULL) Visit(stmt->cond());
+  if (stmt->next() != NULL) Visit(stmt->next());
+  Visit(stmt->body());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitForInStatement(ForInStatement* stmt) {
+  VisitReference(stmt->each());
+  Visit(stmt->enumerable());
+  Visit(stmt->body());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitTryCatchStatement(TryCatchStatement* stmt) {
+  Visit(stmt->try_block());
+  Visit(stmt->catch_block());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitTryFinallyStatement(
+    TryFinallyStatement* stmt) {
+  Visit(stmt->try_block());
+  Visit(stmt->finally_block());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitDebuggerStatement(DebuggerStatement* stmt) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitFunctionLiteral(FunctionLiteral* expr) {
+  Analyze(expr);
+}
+
+
+void ArgumentsUsageAnalyzer::VisitSharedFunctionInfoLiteral(
+    SharedFunctionInfoLiteral* expr) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitConditional(Conditional* expr) {
+  Visit(expr->condition());
+  Visit(expr->then_expression());
+  Visit(expr->else_expression());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitSlot(Slot* expr) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitVariableProxy(VariableProxy* expr) {
+  // Any use of 'arguments' other than as the object of a load lets the
+  // object escape.
+  if (IsArguments(expr)) loads_only_ = false;
+}
+
+
+void ArgumentsUsageAnalyzer::VisitLiteral(Literal* expr) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitRegExpLiteral(RegExpLiteral* expr) {
+}
+
+
+void ArgumentsUsageAnalyzer::VisitObjectLiteral(ObjectLiteral* expr) {
+  for (int i = 0; i < expr->properties()->length(); i++) {
+    Visit(expr->properties()->at(i)->value());
+  }
+}
+
+
+void ArgumentsUsageAnalyzer::VisitArrayLiteral(ArrayLiteral* expr) {
+  VisitExpressions(expr->values());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitCatchExtensionObject(
+    CatchExtensionObject* expr) {
+  Visit(expr->key());
+  Visit(expr->value());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitAssignment(Assignment* expr) {
+  VisitReference(expr->target());
+  Visit(expr->value());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitThrow(Throw* expr) {
+  Visit(expr->exception());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitProperty(Property* expr) {
+  if (IsArguments(expr->obj())) {
+    // Loads of the elements, 'length' and 'callee' can read the actual
+    // arguments from the frame.  Other named properties come from the
+    // prototype and are left to the object.
+    if (expr->key()->IsPropertyName()) {
+      Handle<Object> name = expr->key()->AsLiteral()->handle();
+      if (!name.is_identical_to(FACTORY->length_symbol()) &&
+          !name.is_identical_to(FACTORY->callee_symbol())) {
+        loads_only_ = false;
+      }
+    }
+  } else {
+    Visit(expr->obj());
+  }
+  Visit(expr->key());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitCall(Call* expr) {
+  // Calling a function stored in 'arguments' passes the object as the
+  // receiver.
+  Property* prop = expr->expression()->AsProperty();
+  if (prop != NULL) {
+    Visit(prop->obj());
+    Visit(prop->key());
+  } else {
+    Visit(expr->expression());
+  }
+  VisitExpressions(expr->arguments());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitCallNew(CallNew* expr) {
+  Visit(expr->expression());
+  VisitExpressions(expr->arguments());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitCallRuntime(CallRuntime* expr) {
+  VisitExpressions(expr->arguments());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitUnaryOperation(UnaryOperation* expr) {
+  if (expr->op() == Token::DELETE) {
+    VisitReference(expr->expression());
+  } else {
+    Visit(expr->expression());
+  }
+}
+
+
+void ArgumentsUsageAnalyzer::VisitIncrementOperation(
+    IncrementOperation* expr) {
+  UNREACHABLE();
+}
+
+
+void ArgumentsUsageAnalyzer::VisitCountOperation(CountOperation* expr) {
+  VisitReference(expr->expression());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitBinaryOperation(BinaryOperation* expr) {
+  Visit(expr->left());
+  Visit(expr->right());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitCompareOperation(CompareOperation* expr) {
+  Visit(expr->left());
+  Visit(expr->right());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitCompareToNull(CompareToNull* expr) {
+  Visit(expr->expression());
+}
+
+
+void ArgumentsUsageAnalyzer::VisitThisFunction(ThisFunction* expr) {
+}
+
+
+void Scope::AnalyzeArgumentsUses(FunctionLiteral* function) {
+  ArgumentsUsageAnalyzer analyzer;
+  analyzer.Analyze(function);
+}
+
+
 bool Scope::Analyze(CompilationInfo* info) {
   ASSERT(info->function() != NULL);
+  AnalyzeArgumentsUses(info->function());
   Scope* top = info->function()->scope();
   while (top->outer_scope() != NULL) top = top->outer_scope();
   top->AllocateVariables(info->calling_context());
@@ -790,6 +1140,21 @@ bool Scope::HasArgumentsParameter() {
 }
 
 
+bool Scope::CanReadArgumentsFromFrame() {
+  // Without eval and with, the names recognized by ArgumentsUsageAnalyzer
+  // denote 'arguments' and the parameters of this function, and the
+  // parameters can only change if they are accessed from inner functions.
+  if (!arguments_loads_only_ ||
+      scope_calls_eval_ || inner_scope_calls_eval_ || scope_contains_with_) {
+    return false;
+  }
+  for (int i = 0; i < params_.length(); i++) {
+    if (params_[i]->is_accessed_from_inner_scope_) return false;
+  }
+  return true;
+}
+
+
 void Scope::AllocateStackSlot(Variable* var) {
   var->rewrite_ = new Slot(var, Slot::LOCAL, num_stack_slots_++);
 }
@@ -804,7 +1169,16 @@ void Scope::AllocateParameterLocals() {
   ASSERT(is_function_scope());
   Variable* arguments = LocalLookup(FACTORY->arguments_symbol());
   ASSERT(arguments != NULL);  // functions have 'arguments' declared implicitly
-  if (MustAllocate(arguments) && !HasArgumentsParameter()) {
+  bool uses_arguments = MustAllocate(arguments) && !HasArgumentsParameter();
+  if (uses_arguments && CanReadArgumentsFromFrame()) {
+    // 'arguments' is only used in loads that the code generators compile
+    // to read the actual arguments from the stack frame. Neither the
+    // arguments object nor the 'arguments' variable is allocated and the
+    // parameters are accessed directly.
+    arguments_read_from_frame_ = true;
+    uses_arguments = false;
+  }
+  if (uses_arguments) {
     // 'arguments' is used. Unless there is also a parameter called
     // 'arguments', we must be conservative and access all parameters via
     // the arguments object: The i'th parameter is rewritten into
@@ -912,6 +1286,7 @@ void Scope::AllocateNonParameterLocal(Variable* var) {
          (!var->IsVariable(FACTORY->result_symbol())) ||
          (var->AsSlot() == NULL || var->AsSlot()->type() != Slot::LOCAL));
   if (var->rewrite_ == NULL && MustAllocate(var)) {
+    if (arguments_read_from_frame_ && var->is_arguments()) return;
     if (MustAllocateInContext(var)) {
       AllocateHeapSlot(var);
     } else {
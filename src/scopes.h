@@ -193,6 +193,11 @@ class Scope: public ZoneObject {
   // Inform the scope that the corresponding code contains an eval call.
   void RecordEvalCall()  { scope_calls_eval_ = true; }
 
+  // Inform the scope that the corresponding code uses 'arguments' only in
+  // 'arguments.length' and 'arguments[key]' loads and never assigns to
+  // the parameters.
+  void RecordArgumentsLoadsOnly()  { arguments_loads_only_ = true; }
+
 
   // ---------------------------------------------------------------------------
   // Predicates.
@@ -211,6 +216,11 @@ class Scope: public ZoneObject {
   // Does this scope contain a with statement.
   bool contains_with() const { return scope_contains_with_; }
 
+  // Are the loads from 'arguments' compiled to read the actual arguments
+  // from the stack frame, so that no arguments object is allocated.
+  // Computed via AllocateVariables; function scopes only.
+  bool arguments_read_from_frame() const { return arguments_read_from_frame_; }
+
   // The scope immediately surrounding this scope, or NULL.
   Scope* outer_scope() const { return outer_scope_; }
 
@@ -344,6 +354,7 @@ class Scope: public ZoneObject {
   bool scope_inside_with_;  // this scope is inside a 'with' of some outer scope
   bool scope_contains_with_;  // this scope contains a 'with' statement
   bool scope_calls_eval_;  // this scope contains an 'eval' call
+  bool arguments_loads_only_;  // 'arguments' is only loaded from
 
   // Computed via PropagateScopeInfo.
   bool outer_scope_calls_eval_;
@@ -354,6 +365,7 @@ class Scope: public ZoneObject {
   // Computed via AllocateVariables; function scopes only.
   int num_stack_slots_;
   int num_heap_slots_;
+  bool arguments_read_from_frame_;
 
   // Create a non-local variable with a given name.
   // These variables are looked up dynamically at runtime.
@@ -370,6 +382,7 @@ class Scope: public ZoneObject {
                                    Handle<Context> context);
 
   // Scope analysis.
+  static void AnalyzeArgumentsUses(FunctionLiteral* function);
   bool PropagateScopeInfo(bool outer_scope_calls_eval,
                           bool outer_scope_is_eval_scope);
   bool HasTrivialContext() const;
@@ -378,6 +391,7 @@ class Scope: public ZoneObject {
   bool MustAllocate(Variable* var);
   bool MustAllocateInContext(Variable* var);
   bool HasArgumentsParameter();
+  bool CanReadArgumentsFromFrame();
 
   // Variable allocation.
   void AllocateStackSlot(Variable* var);
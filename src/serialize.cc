@@ -242,6 +242,10 @@ void ExternalReferenceTable::PopulateTable(Isolate* isolate) {
       DEBUG_ADDRESS,
       Debug::k_restarter_frame_function_pointer << kDebugIdShift,
       "Debug::restarter_frame_function_pointer_address()");
+  Add(Debug_Address(Debug::k_inlined_calls_disabled_address).address(isolate),
+      DEBUG_ADDRESS,
+      Debug::k_inlined_calls_disabled_address << kDebugIdShift,
+      "Debug::inlined_calls_disabled_address()");
 #endif
 
   // Stat counters
@@ -315,6 +319,14 @@ void ExternalReferenceTable::PopulateTable(Isolate* isolate) {
       STUB_CACHE_TABLE,
       4,
       "StubCache::secondary_->value");
+  Add(stub_cache->mask_reference(StubCache::kPrimary).address(),
+      STUB_CACHE_TABLE,
+      5,
+      "StubCache::primary_mask_");
+  Add(stub_cache->mask_reference(StubCache::kSecondary).address(),
+      STUB_CACHE_TABLE,
+      6,
+      "StubCache::secondary_mask_");
 
   // Runtime entries
   Add(ExternalReference::perform_gc_function().address(),
@@ -28,10 +28,160 @@
 #ifndef V8_STRING_SEARCH_H_
 #define V8_STRING_SEARCH_H_
 
+// The candidate filters below scan sixteen bytes at a time when the host
+// compiler targets SSE2.
+#ifdef V8_HOST_CAN_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace v8 {
 namespace internal {
 
 
+//---------------------------------------------------------------------
+// Candidate filters
+//---------------------------------------------------------------------
+
+#ifdef V8_HOST_CAN_USE_SSE2
+// Returns the index of the lowest set bit of a non-zero movemask result.
+static inline int LowestSetBit(int mask) {
+  ASSERT(mask != 0);
+#if defined(__GNUC__)
+  return __builtin_ctz(mask);
+#else
+  int index = 0;
+  while ((mask & 1) == 0) {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+
+// Returns the index of the highest set bit of a non-zero movemask result.
+static inline int HighestSetBit(int mask) {
+  ASSERT(mask != 0);
+#if defined(__GNUC__)
+  return 31 - __builtin_clz(mask);
+#else
+  int index = 31;
+  while ((mask & (1 << index)) == 0) index--;
+  return index;
+#endif
+}
+#endif  // V8_HOST_CAN_USE_SSE2
+
+
+// Returns the first index in [index, limit] at which the subject holds
+// the character c, or -1 if there is none.
+static inline int FindFirstCharacter(Vector<const char> subject,
+                                     char c,
+                                     int index,
+                                     int limit) {
+  ASSERT(0 <= index && limit < subject.length());
+  const char* start = subject.start();
+  const char* pos = reinterpret_cast<const char*>(
+      memchr(start + index, c, limit - index + 1));
+  if (pos == NULL) return -1;
+  return static_cast<int>(pos - start);
+}
+
+
+static inline int FindFirstCharacter(Vector<const uc16> subject,
+                                     uc16 c,
+                                     int index,
+                                     int limit) {
+  ASSERT(0 <= index && limit < subject.length());
+  const uc16* start = subject.start();
+  int i = index;
+#ifdef V8_HOST_CAN_USE_SSE2
+  // Eight characters per step; the movemask has two bits per character.
+  static const int kStep = sizeof(__m128i) / sizeof(uc16);
+  __m128i needle = _mm_set1_epi16(static_cast<int16_t>(c));
+  for (; i <= limit - (kStep - 1); i += kStep) {
+    __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(start + i));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chars, needle));
+    if (mask != 0) return i + (LowestSetBit(mask) >> 1);
+  }
+#endif  // V8_HOST_CAN_USE_SSE2
+  for (; i <= limit; i++) {
+    if (start[i] == c) return i;
+  }
+  return -1;
+}
+
+
+// Returns the first index i in [index, limit] at which the subject holds
+// the character first and, distance characters later, the character last.
+// Used to filter candidate positions for a pattern by its first and last
+// characters before comparing the rest of it.  The subject must extend
+// at least distance characters beyond limit.
+static inline int FindFirstAndLastCandidate(Vector<const char> subject,
+                                            char first,
+                                            char last,
+                                            int distance,
+                                            int index,
+                                            int limit) {
+  ASSERT(0 <= index && limit + distance < subject.length());
+  const char* start = subject.start();
+  int i = index;
+#ifdef V8_HOST_CAN_USE_SSE2
+  static const int kStep = sizeof(__m128i);
+  __m128i first_needle = _mm_set1_epi8(first);
+  __m128i last_needle = _mm_set1_epi8(last);
+  for (; i <= limit - (kStep - 1); i += kStep) {
+    __m128i firsts =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(start + i));
+    __m128i lasts = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(start + i + distance));
+    int mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(firsts, first_needle),
+                      _mm_cmpeq_epi8(lasts, last_needle)));
+    if (mask != 0) return i + LowestSetBit(mask);
+  }
+#endif  // V8_HOST_CAN_USE_SSE2
+  while (i <= limit) {
+    i = FindFirstCharacter(subject, first, i, limit);
+    if (i == -1 || start[i + distance] == last) return i;
+    i++;
+  }
+  return -1;
+}
+
+
+static inline int FindFirstAndLastCandidate(Vector<const uc16> subject,
+                                            uc16 first,
+                                            uc16 last,
+                                            int distance,
+                                            int index,
+                                            int limit) {
+  ASSERT(0 <= index && limit + distance < subject.length());
+  const uc16* start = subject.start();
+  int i = index;
+#ifdef V8_HOST_CAN_USE_SSE2
+  static const int kStep = sizeof(__m128i) / sizeof(uc16);
+  __m128i first_needle = _mm_set1_epi16(static_cast<int16_t>(first));
+  __m128i last_needle = _mm_set1_epi16(static_cast<int16_t>(last));
+  for (; i <= limit - (kStep - 1); i += kStep) {
+    __m128i firsts =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(start + i));
+    __m128i lasts = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(start + i + distance));
+    int mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi16(firsts, first_needle),
+                      _mm_cmpeq_epi16(lasts, last_needle)));
+    if (mask != 0) return i + (LowestSetBit(mask) >> 1);
+  }
+#endif  // V8_HOST_CAN_USE_SSE2
+  for (; i <= limit; i++) {
+    if (start[i] == first && start[i + distance] == last) return i;
+  }
+  return -1;
+}
+
+
 //---------------------------------------------------------------------
 // String Search object.
 //---------------------------------------------------------------------
@@ -218,27 +368,16 @@ int StringSearch<PatternChar, SubjectChar>::SingleCharSearch(
     int index) {
   ASSERT_EQ(1, search->pattern_.length());
   PatternChar pattern_first_char = search->pattern_[0];
-  int i = index;
-  if (sizeof(SubjectChar) == 1 && sizeof(PatternChar) == 1) {
-    const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
-        memchr(subject.start() + i,
-               pattern_first_char,
-               subject.length() - i));
-    if (pos == NULL) return -1;
-    return static_cast<int>(pos - subject.start());
-  } else {
-    if (sizeof(PatternChar) > sizeof(SubjectChar)) {
-      if (static_cast<uc16>(pattern_first_char) > String::kMaxAsciiCharCodeU) {
-        return -1;
-      }
+  if (sizeof(PatternChar) > sizeof(SubjectChar)) {
+    if (static_cast<uc16>(pattern_first_char) > String::kMaxAsciiCharCodeU) {
+      return -1;
     }
-    SubjectChar search_char = static_cast<SubjectChar>(pattern_first_char);
-    int n = subject.length();
-    while (i < n) {
-      if (subject[i++] == search_char) return i - 1;
-    }
-    return -1;
   }
+  if (index >= subject.length()) return -1;
+  return FindFirstCharacter(subject,
+                            static_cast<SubjectChar>(pattern_first_char),
+                            index,
+                            subject.length() - 1);
 }
 
 //---------------------------------------------------------------------
@@ -263,6 +402,8 @@ static inline bool CharCompare(const PatternChar* pattern,
 
 
 // Simple linear search for short patterns. Never bails out.
+// Candidate positions are found by matching the first and last pattern
+// characters together, and only those are compared in full.
 template <typename PatternChar, typename SubjectChar>
 int StringSearch<PatternChar, SubjectChar>::LinearSearch(
     StringSearch<PatternChar, SubjectChar>* search,
@@ -271,27 +412,28 @@ int StringSearch<PatternChar, SubjectChar>::LinearSearch(
   Vector<const PatternChar> pattern = search->pattern_;
   ASSERT(pattern.length() > 1);
   int pattern_length = pattern.length();
-  PatternChar pattern_first_char = pattern[0];
+  SubjectChar pattern_first_char = static_cast<SubjectChar>(pattern[0]);
+  SubjectChar pattern_last_char =
+      static_cast<SubjectChar>(pattern[pattern_length - 1]);
   int i = index;
   int n = subject.length() - pattern_length;
   while (i <= n) {
-    if (sizeof(SubjectChar) == 1 && sizeof(PatternChar) == 1) {
-      const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
-          memchr(subject.start() + i,
-                 pattern_first_char,
-                 n - i + 1));
-      if (pos == NULL) return -1;
-      i = static_cast<int>(pos - subject.start()) + 1;
-    } else {
-      if (subject[i++] != pattern_first_char) continue;
-    }
+    i = FindFirstAndLastCandidate(subject,
+                                  pattern_first_char,
+                                  pattern_last_char,
+                                  pattern_length - 1,
+                                  i,
+                                  n);
+    if (i == -1) return -1;
     // Loop extracted to separate function to allow using return to do
     // a deeper break.
-    if (CharCompare(pattern.start() + 1,
-                    subject.start() + i,
-                    pattern_length - 1)) {
-      return i - 1;
+    if (pattern_length == 2 ||
+        CharCompare(pattern.start() + 1,
+                    subject.start() + i + 1,
+                    pattern_length - 2)) {
+      return i;
     }
+    i++;
   }
   return -1;
 }
@@ -516,32 +658,29 @@ int StringSearch<PatternChar, SubjectChar>::InitialSearch(
   // algorithm.
   int badness = -10 - (pattern_length << 2);
 
-  // We know our pattern is at least 2 characters, we cache the first so
-  // the common case of the first character not matching is faster.
-  PatternChar pattern_first_char = pattern[0];
+  // We know our pattern is at least 2 characters.  Candidates are filtered
+  // on the first and last characters, so the common case of a mismatch is
+  // handled without looking at the rest of the pattern.
+  SubjectChar pattern_first_char = static_cast<SubjectChar>(pattern[0]);
+  SubjectChar pattern_last_char =
+      static_cast<SubjectChar>(pattern[pattern_length - 1]);
   for (int i = index, n = subject.length() - pattern_length; i <= n; i++) {
     badness++;
     if (badness <= 0) {
-      if (sizeof(SubjectChar) == 1 && sizeof(PatternChar) == 1) {
-        const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
-            memchr(subject.start() + i,
-                   pattern_first_char,
-                   n - i + 1));
-        if (pos == NULL) {
-          return -1;
-        }
-        i = static_cast<int>(pos - subject.start());
-      } else {
-        if (subject[i] != pattern_first_char) continue;
+      i = FindFirstAndLastCandidate(subject,
+                                    pattern_first_char,
+                                    pattern_last_char,
+                                    pattern_length - 1,
+                                    i,
+                                    n);
+      if (i == -1) {
+        return -1;
       }
       int j = 1;
-      do {
-        if (pattern[j] != subject[i + j]) {
-          break;
-        }
+      while (j < pattern_length - 1 && pattern[j] == subject[i + j]) {
         j++;
-      } while (j < pattern_length);
-      if (j == pattern_length) {
+      }
+      if (j == pattern_length - 1) {
         return i;
       }
       badness += j;
@@ -432,8 +432,7 @@ function StringReplaceGlobalRegExpWithFunction(subject, regexp, replace) {
       i++;
     }
   }
-  var resultBuilder = new ReplaceResultBuilder(subject, res);
-  var result = resultBuilder.generate();
+  var result = %StringBuilderConcat(res, res.length, subject);
   resultArray.length = 0;
   reusableReplaceArray = resultArray;
   return result;
@@ -834,44 +833,55 @@ function StringSup() {
 }
 
 
+// StringBuilder support.  The characters are collected in a buffer that
+// grows by doubling; only the first length characters of the buffer are
+// in use.  Until the first string is added the buffer is the capacity to
+// start out with.  The buffer must never escape, so the builder objects do
+// not inherit from Object.prototype (see SetupString).
+function StringBuilder(capacity) {
+  this.buffer = capacity;
+  this.length = 0;
+}
+
+
+// The argument must be a string.
+StringBuilder.prototype.add = function(str) {
+  this.buffer = %StringBuilderAdd(this.buffer, this.length, str);
+  this.length += str.length;
+}
+
+
+StringBuilder.prototype.generate = function() {
+  return %StringBuilderFinish(this.buffer, this.length);
+}
+
+
 // ReplaceResultBuilder support.
 function ReplaceResultBuilder(str) {
-  if (%_ArgumentsLength() > 1) {
-    this.elements = %_Arguments(1);
-  } else {
-    this.elements = new $Array();
-  }
+  this.buffer = str.length;
+  this.length = 0;
   this.special_string = str;
 }
 
 
 ReplaceResultBuilder.prototype.add = function(str) {
   str = TO_STRING_INLINE(str);
-  if (str.length > 0) {
-    var elements = this.elements;
-    elements[elements.length] = str;
-  }
+  this.buffer = %StringBuilderAdd(this.buffer, this.length, str);
+  this.length += str.length;
 }
 
 
 ReplaceResultBuilder.prototype.addSpecialSlice = function(start, end) {
   var len = end - start;
   if (start < 0 || len <= 0) return;
-  var elements = this.elements;
-  if (start < 0x80000 && len < 0x800) {
-    elements[elements.length] = (start << 11) | len;
-  } else {
-    // 0 < len <= String::kMaxLength and Smi::kMaxValue >= String::kMaxLength,
-    // so -len is a smi.
-    elements[elements.length] = -len;
-    elements[elements.length] = start;
-  }
+  this.buffer = %StringBuilderAddSlice(this.buffer, this.length,
+                                       this.special_string, start, end);
+  this.length += len;
 }
 
 
 ReplaceResultBuilder.prototype.generate = function() {
-  var elements = this.elements;
-  return %StringBuilderConcat(elements, elements.length, this.special_string);
+  return %StringBuilderFinish(this.buffer, this.length);
 }
 
 
@@ -886,6 +896,10 @@ function SetupString() {
   // Setup the constructor property on the String prototype object.
   %SetProperty($String.prototype, "constructor", $String, DONT_ENUM);
 
+  // Keep setters on Object.prototype from seeing the builder buffers.
+  StringBuilder.prototype.__proto__ = null;
+  ReplaceResultBuilder.prototype.__proto__ = null;
+
 
   // Setup the non-enumerable functions on the String object.
   InstallFunctions($String, DONT_ENUM, $Array(
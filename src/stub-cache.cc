@@ -39,16 +39,53 @@ namespace internal {
 // StubCache implementation.
 
 
-StubCache::StubCache(Isolate* isolate) : isolate_(isolate) {
+// Clamps a requested table size to a power of two in a sane range.  The
+// upper bound keeps a mistyped flag from reserving an unbounded amount of
+// memory for every isolate.
+static int StubCacheTableSize(int requested) {
+  const int kMinTableSize = 16;
+  const int kMaxTableSize = 1 << 16;
+  if (requested < kMinTableSize) return kMinTableSize;
+  if (requested > kMaxTableSize) return kMaxTableSize;
+  return static_cast<int>(RoundUpToPowerOf2(requested));
+}
+
+
+StubCache::StubCache(Isolate* isolate)
+    : primary_(NULL),
+      secondary_(NULL),
+      primary_size_(0),
+      secondary_size_(0),
+      primary_mask_(0),
+      secondary_mask_(0),
+      isolate_(isolate) {
   ASSERT(isolate == Isolate::Current());
-  memset(primary_, 0, sizeof(primary_[0]) * StubCache::kPrimaryTableSize);
-  memset(secondary_, 0, sizeof(secondary_[0]) * StubCache::kSecondaryTableSize);
+}
+
+
+void StubCache::AllocateTables() {
+  ASSERT(primary_ == NULL && secondary_ == NULL);
+  primary_size_ = StubCacheTableSize(FLAG_stub_cache_primary_size);
+  secondary_size_ = StubCacheTableSize(FLAG_stub_cache_secondary_size);
+  primary_mask_ = (primary_size_ - 1) << kHeapObjectTagSize;
+  secondary_mask_ = (secondary_size_ - 1) << kHeapObjectTagSize;
+  primary_ = NewArray<Entry>(primary_size_);
+  secondary_ = NewArray<Entry>(secondary_size_);
+  memset(primary_, 0, sizeof(primary_[0]) * primary_size_);
+  memset(secondary_, 0, sizeof(secondary_[0]) * secondary_size_);
+}
+
+
+StubCache::~StubCache() {
+  DeleteArray(primary_);
+  DeleteArray(secondary_);
 }
 
 
 void StubCache::Initialize(bool create_heap_objects) {
-  ASSERT(IsPowerOf2(kPrimaryTableSize));
-  ASSERT(IsPowerOf2(kSecondaryTableSize));
+  if (primary_ == NULL) AllocateTables();
+  ASSERT(IsPowerOf2(primary_size_));
+  ASSERT(IsPowerOf2(secondary_size_));
   if (create_heap_objects) {
     HandleScope scope;
     Clear();
@@ -951,12 +988,12 @@ MaybeObject* StubCache::ComputeCallDebugPrepareStepIn(int argc,
 
 
 void StubCache::Clear() {
-  for (int i = 0; i < kPrimaryTableSize; i++) {
+  for (int i = 0; i < primary_size_; i++) {
     primary_[i].key = isolate_->heap()->empty_string();
     primary_[i].value = isolate_->builtins()->builtin(
         Builtins::Illegal);
   }
-  for (int j = 0; j < kSecondaryTableSize; j++) {
+  for (int j = 0; j < secondary_size_; j++) {
     secondary_[j].key = isolate_->heap()->empty_string();
     secondary_[j].value = isolate_->builtins()->builtin(
         Builtins::Illegal);
@@ -964,6 +1001,31 @@ void StubCache::Clear() {
 }
 
 
+void StubCache::ClearDeadEntries(WeakSlotCallback is_dead) {
+  // The heap objects are marked at this point, so the entries are reset
+  // without checked casts.
+  Heap* heap = isolate_->heap();
+  String* empty = heap->raw_unchecked_empty_string();
+  Code* illegal = isolate_->builtins()->builtin(Builtins::Illegal);
+  for (int i = 0; i < primary_size_; i++) {
+    Entry* entry = &primary_[i];
+    if (is_dead(reinterpret_cast<Object**>(&entry->key)) ||
+        is_dead(reinterpret_cast<Object**>(&entry->value))) {
+      entry->key = empty;
+      entry->value = illegal;
+    }
+  }
+  for (int j = 0; j < secondary_size_; j++) {
+    Entry* entry = &secondary_[j];
+    if (is_dead(reinterpret_cast<Object**>(&entry->key)) ||
+        is_dead(reinterpret_cast<Object**>(&entry->value))) {
+      entry->key = empty;
+      entry->value = illegal;
+    }
+  }
+}
+
+
 // ------------------------------------------------------------------------
 // StubCompiler implementation.
 
@@ -238,6 +238,10 @@ class StubCache {
   // Clear the lookup table (@ mark compact collection).
   void Clear();
 
+  // Reset the entries whose key or code is reported dead by the callback
+  // (@ mark compact collection, after marking).
+  void ClearDeadEntries(WeakSlotCallback is_dead);
+
   // Generate code for probing the stub cache table.
   // Arguments extra and extra2 may be used to pass additional scratch
   // registers. Set to no_reg if not needed.
@@ -267,7 +271,23 @@ class StubCache {
   }
 
 
+  // The hash masks are loaded by the generated probe code rather than
+  // embedded as immediates, so that stubs in the snapshot work with any
+  // table size chosen at isolate creation.
+  SCTableReference mask_reference(StubCache::Table table) {
+    switch (table) {
+      case StubCache::kPrimary:
+        return SCTableReference(reinterpret_cast<Address>(&primary_mask_));
+      case StubCache::kSecondary:
+        return SCTableReference(reinterpret_cast<Address>(&secondary_mask_));
+    }
+    UNREACHABLE();
+    return SCTableReference(NULL);
+  }
+
+
   StubCache::Entry* first_entry(StubCache::Table table) {
+    if (primary_ == NULL) AllocateTables();
     switch (table) {
       case StubCache::kPrimary: return StubCache::primary_;
       case StubCache::kSecondary: return StubCache::secondary_;
@@ -277,18 +297,41 @@ class StubCache {
   }
 
 
+  int table_size(StubCache::Table table) {
+    if (primary_ == NULL) AllocateTables();
+    switch (table) {
+      case StubCache::kPrimary: return primary_size_;
+      case StubCache::kSecondary: return secondary_size_;
+    }
+    UNREACHABLE();
+    return 0;
+  }
+
+
  private:
   explicit StubCache(Isolate* isolate);
+  ~StubCache();
+
+  // The default isolate is created before the command line flags are
+  // parsed, so the tables are allocated on first use rather than in the
+  // constructor.  Generated code embeds their addresses, so they are never
+  // reallocated afterwards.
+  void AllocateTables();
 
   friend class Isolate;
   friend class SCTableReference;
-  static const int kPrimaryTableSize = 2048;
-  static const int kSecondaryTableSize = 512;
-  Entry primary_[kPrimaryTableSize];
-  Entry secondary_[kSecondaryTableSize];
+  // The tables are sized from --stub-cache-primary-size and
+  // --stub-cache-secondary-size.
+  Entry* primary_;
+  Entry* secondary_;
+  int primary_size_;
+  int secondary_size_;
+  // (size - 1) << kHeapObjectTagSize for the respective table.
+  int primary_mask_;
+  int secondary_mask_;
 
   // Computes the hashed offsets for primary and secondary caches.
-  RLYSTC int PrimaryOffset(String* name, Code::Flags flags, Map* map) {
+  int PrimaryOffset(String* name, Code::Flags flags, Map* map) {
     // This works well because the heap object tag size and the hash
     // shift are equal.  Shifting down the length field to get the
     // hash code would effectively throw away two bits of the hash
@@ -308,10 +351,10 @@ class StubCache {
         (static_cast<uint32_t>(flags) & ~Code::kFlagsNotUsedInLookup);
     // Base the offset on a simple combination of name, flags, and map.
     uint32_t key = (map_low32bits + field) ^ iflags;
-    return key & ((kPrimaryTableSize - 1) << kHeapObjectTagSize);
+    return key & primary_mask_;
   }
 
-  RLYSTC int SecondaryOffset(String* name, Code::Flags flags, int seed) {
+  int SecondaryOffset(String* name, Code::Flags flags, int seed) {
     // Use the seed from the primary cache in the secondary cache.
     uint32_t string_low32bits =
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(name));
@@ -320,7 +363,7 @@ class StubCache {
     uint32_t iflags =
         (static_cast<uint32_t>(flags) & ~Code::kFlagsICInLoopMask);
     uint32_t key = seed - string_low32bits + iflags;
-    return key & ((kSecondaryTableSize - 1) << kHeapObjectTagSize);
+    return key & secondary_mask_;
   }
 
   // Compute the entry for a given offset in exactly the same way as
@@ -482,6 +525,16 @@ class StubCompiler BASE_EMBEDDED {
                          String* name,
                          Label* miss);
 
+  // Inlines the load of an internal field accessor once the holder has
+  // been found.
+  void GenerateLoadInternalField(JSObject* holder,
+                                 Register holder_reg,
+                                 Register scratch1,
+                                 Register scratch2,
+                                 Register scratch3,
+                                 AccessorInfo* callback,
+                                 Label* miss);
+
   bool GenerateLoadCallback(JSObject* object,
                             JSObject* holder,
                             Register receiver,
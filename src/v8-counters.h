@@ -68,6 +68,11 @@ namespace internal {
   SC(objs_since_last_full, V8.ObjsSinceLastFull)                      \
   SC(symbol_table_capacity, V8.SymbolTableCapacity)                   \
   SC(number_of_symbols, V8.NumberOfSymbols)                           \
+  /* Maps in map space and the descriptor arrays they use */          \
+  SC(number_of_maps, V8.NumberOfMaps)                                 \
+  SC(map_space_bytes, V8.MapSpaceBytes)                               \
+  SC(map_descriptor_arrays, V8.MapDescriptorArrays)                   \
+  SC(map_descriptor_array_bytes, V8.MapDescriptorArrayBytes)          \
   SC(script_wrappers, V8.ScriptWrappers)                              \
   SC(call_initialize_stubs, V8.CallInitializeStubs)                   \
   SC(call_premonomorphic_stubs, V8.CallPreMonomorphicStubs)           \
@@ -150,6 +155,8 @@ namespace internal {
   SC(keyed_load_interceptor, V8.KeyedLoadInterceptor)                 \
   SC(keyed_load_inline, V8.KeyedLoadInline)                           \
   SC(keyed_load_inline_miss, V8.KeyedLoadInlineMiss)                  \
+  SC(keyed_load_external_array_inline,                                 \
+     V8.KeyedLoadExternalArrayInline)                                 \
   SC(named_load_inline, V8.NamedLoadInline)                           \
   SC(named_load_inline_miss, V8.NamedLoadInlineMiss)                  \
   SC(named_load_global_inline, V8.NamedLoadGlobalInline)              \
@@ -161,6 +168,8 @@ namespace internal {
   SC(keyed_store_field, V8.KeyedStoreField)                           \
   SC(keyed_store_inline, V8.KeyedStoreInline)                         \
   SC(keyed_store_inline_miss, V8.KeyedStoreInlineMiss)                \
+  SC(keyed_store_external_array_inline,                                \
+     V8.KeyedStoreExternalArrayInline)                                \
   SC(named_store_global_inline, V8.NamedStoreGlobalInline)            \
   SC(named_store_global_inline_miss, V8.NamedStoreGlobalInlineMiss)   \
   SC(store_normal_miss, V8.StoreNormalMiss)                           \
@@ -178,11 +187,20 @@ namespace internal {
   SC(call_const_interceptor_fast_api, V8.CallConstInterceptorFastApi) \
   SC(call_global_inline, V8.CallGlobalInline)                         \
   SC(call_global_inline_miss, V8.CallGlobalInlineMiss)                \
+  SC(call_global_fast_api, V8.CallGlobalFastApi)                      \
+  SC(inlined_calls, V8.InlinedCalls)                                  \
   SC(constructed_objects, V8.ConstructedObjects)                      \
   SC(constructed_objects_runtime, V8.ConstructedObjectsRuntime)       \
   SC(constructed_objects_stub, V8.ConstructedObjectsStub)             \
   SC(negative_lookups, V8.NegativeLookups)                            \
   SC(negative_lookups_miss, V8.NegativeLookupsMiss)                   \
+  /* Stub cache hits match name and flags; the stub checks the map. */ \
+  SC(megamorphic_stub_cache_probes, V8.MegamorphicStubCacheProbes)    \
+  SC(megamorphic_stub_cache_primary_hits,                             \
+     V8.MegamorphicStubCachePrimaryHits)                              \
+  SC(megamorphic_stub_cache_secondary_hits,                           \
+     V8.MegamorphicStubCacheSecondaryHits)                            \
+  SC(megamorphic_stub_cache_misses, V8.MegamorphicStubCacheMisses)    \
   SC(array_function_runtime, V8.ArrayFunctionRuntime)                 \
   SC(array_function_native, V8.ArrayFunctionNative)                   \
   SC(for_in, V8.ForIn)                                                \
@@ -207,6 +225,7 @@ namespace internal {
   SC(string_compare_runtime, V8.StringCompareRuntime)                 \
   SC(regexp_entry_runtime, V8.RegExpEntryRuntime)                     \
   SC(regexp_entry_native, V8.RegExpEntryNative)                       \
+  SC(regexp_nfa_fallbacks, V8.RegExpNfaFallbacks)                     \
   SC(number_to_string_native, V8.NumberToStringNative)                \
   SC(number_to_string_runtime, V8.NumberToStringRuntime)              \
   SC(math_acos, V8.MathAcos)                                          \
@@ -296,6 +296,27 @@ static inline void CopyChars(sinkchar* dest, const sourcechar* src, int chars) {
   }
 }
 
+
+// Returns the index of the first character that is not ASCII, or length
+// if all the characters are ASCII.  Checks a word of characters at a time.
+static inline int NonAsciiStart(const char* chars, int length) {
+  const char* start = chars;
+  const char* limit = chars + length;
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+  // Number of characters in a uintptr_t.
+  static const int kStepSize = sizeof(uintptr_t);  // NOLINT
+  // The top bit of every character in a uintptr_t.
+  static const uintptr_t kNonAsciiMask =
+      ~static_cast<uintptr_t>(0) / 0xFF * 0x80;
+  while (chars <= limit - kStepSize) {
+    if (*reinterpret_cast<const uintptr_t*>(chars) & kNonAsciiMask) break;
+    chars += kStepSize;
+  }
+#endif
+  while (chars < limit && (*chars & 0x80) == 0) chars++;
+  return static_cast<int>(chars - start);
+}
+
 } }  // namespace v8::internal
 
 #endif  // V8_V8UTILS_H_
@@ -321,6 +321,23 @@ void Builtins::Generate_FunctionCall(MacroAssembler* masm) {
 }
 
 
+// Load the map of arguments objects from the global context of the
+// current context.
+static void GenerateLoadArgumentsBoilerplateMap(MacroAssembler* masm,
+                                                Register result) {
+  __ movq(result, Operand(rsi, Context::SlotOffset(Context::GLOBAL_INDEX)));
+  __ movq(result, FieldOperand(result, GlobalObject::kGlobalContextOffset));
+  __ movq(result, Operand(result, Context::SlotOffset(
+      Context::ARGUMENTS_BOILERPLATE_INDEX)));
+  __ movq(result, FieldOperand(result, HeapObject::kMapOffset));
+}
+
+
+// Function.prototype.apply copies at most this many arguments without
+// calling APPLY_PREPARE; it matches the limit checked there.
+static const int kMaxFastApplyLength = 0x800000;
+
+
 void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   // Stack at entry:
   //    rsp: return address
@@ -337,9 +354,36 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   static const int kArgumentsOffset = 2 * kPointerSize;
   static const int kReceiverOffset = 3 * kPointerSize;
   static const int kFunctionOffset = 4 * kPointerSize;
+
+  // Skip APPLY_PREPARE if the function is a JSFunction and the arguments
+  // are a JSArray or an arguments object with a small smi length.
+  Label prepare, prepared, arguments_object, check_length;
+  __ movq(rdi, Operand(rbp, kFunctionOffset));
+  __ JumpIfSmi(rdi, &prepare);
+  __ CmpObjectType(rdi, JS_FUNCTION_TYPE, rcx);
+  __ j(not_equal, &prepare);
+  __ movq(rdx, Operand(rbp, kArgumentsOffset));
+  __ JumpIfSmi(rdx, &prepare);
+  __ CmpObjectType(rdx, JS_ARRAY_TYPE, rcx);
+  __ j(not_equal, &arguments_object);
+  __ movq(rax, FieldOperand(rdx, JSArray::kLengthOffset));
+  __ jmp(&check_length);
+  __ bind(&arguments_object);
+  GenerateLoadArgumentsBoilerplateMap(masm, rbx);
+  __ cmpq(rcx, rbx);
+  __ j(not_equal, &prepare);
+  __ movq(rax, FieldOperand(rdx, JSObject::kHeaderSize +
+                                 Heap::arguments_length_index * kPointerSize));
+  __ bind(&check_length);
+  __ JumpUnlessNonNegativeSmi(rax, &prepare);
+  __ SmiCompare(rax, Smi::FromInt(kMaxFastApplyLength));
+  __ j(less, &prepared);
+
+  __ bind(&prepare);
   __ push(Operand(rbp, kFunctionOffset));
   __ push(Operand(rbp, kArgumentsOffset));
   __ InvokeBuiltin(Builtins::APPLY_PREPARE, CALL_FUNCTION);
+  __ bind(&prepared);
 
   // Check the stack for overflow. We are not trying need to catch
   // interruptions (e.g. debug break and preemption) here, so the "real stack
@@ -412,8 +456,52 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   __ bind(&push_receiver);
   __ push(rbx);
 
+  // Copy the elements of a JSArray or an arguments object with a fast
+  // backing store straight onto the stack.  The checks are done here,
+  // after any calls that could have changed the arguments.
+  Label generic, fast_elements, copy, fast_loop, fast_entry, hole, invoke;
+  __ movq(rdx, Operand(rbp, kArgumentsOffset));
+  __ JumpIfSmi(rdx, &generic);
+  __ CmpObjectType(rdx, JS_ARRAY_TYPE, rcx);
+  __ j(equal, &fast_elements);
+  GenerateLoadArgumentsBoilerplateMap(masm, rbx);
+  __ cmpq(rcx, rbx);
+  __ j(not_equal, &generic);
+  __ bind(&fast_elements);
+  __ movq(rbx, FieldOperand(rdx, JSObject::kElementsOffset));
+  __ movq(rcx, FieldOperand(rbx, HeapObject::kMapOffset));
+  __ CompareRoot(rcx, Heap::kFixedArrayMapRootIndex);
+  __ j(equal, &copy);
+  __ CompareRoot(rcx, Heap::kFixedCOWArrayMapRootIndex);
+  __ j(not_equal, &generic);
+  __ bind(&copy);
+  __ movq(rax, Operand(rbp, kLimitOffset));
+  __ SmiCompare(rax, FieldOperand(rbx, FixedArray::kLengthOffset));
+  __ j(above, &generic);
+  __ SmiToInteger32(rax, rax);
+  __ xor_(rcx, rcx);
+  __ jmp(&fast_entry);
+  __ bind(&fast_loop);
+  __ movq(rdx, FieldOperand(rbx, rcx, times_pointer_size,
+                            FixedArray::kHeaderSize));
+  __ CompareRoot(rdx, Heap::kTheHoleValueRootIndex);
+  __ j(equal, &hole);
+  __ push(rdx);
+  __ incq(rcx);
+  __ bind(&fast_entry);
+  __ cmpq(rcx, rax);
+  __ j(less, &fast_loop);
+  __ movq(rax, Operand(rbp, kLimitOffset));
+  __ jmp(&invoke);
+
+  // Holes are looked up in the prototype chain.  Drop the elements
+  // copied so far, keeping the receiver, and use keyed loads instead.
+  __ bind(&hole);
+  __ lea(rsp, Operand(rbp, kIndexOffset - kPointerSize));
+
   // Copy all arguments from the array to the stack.
   Label entry, loop;
+  __ bind(&generic);
   __ movq(rax, Operand(rbp, kIndexOffset));
   __ jmp(&entry);
   __ bind(&loop);
@@ -441,6 +529,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
   __ j(not_equal, &loop);
 
   // Invoke the function.
+  __ bind(&invoke);
   ParameterCount actual(rax);
   __ SmiToInteger32(rax, rax);
   __ movq(rdi, Operand(rbp, kFunctionOffset));
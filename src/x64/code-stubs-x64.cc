@@ -203,6 +203,57 @@ void FastCloneShallowArrayStub::Generate(MacroAssembler* masm) {
 }
 
 
+void FastCloneShallowObjectStub::Generate(MacroAssembler* masm) {
+  // Stack layout on entry:
+  //
+  // [rsp + kPointerSize]: fast elements flag.
+  // [rsp + (2 * kPointerSize)]: constant properties.
+  // [rsp + (3 * kPointerSize)]: literal index.
+  // [rsp + (4 * kPointerSize)]: literals array.
+
+  // All properties are expected to be in-object.
+  int size = JSObject::kHeaderSize + length_ * kPointerSize;
+
+  // Load boilerplate object into rcx and check if we need to create a
+  // boilerplate.
+  Label slow_case;
+  __ movq(rcx, Operand(rsp, 4 * kPointerSize));
+  __ movq(rax, Operand(rsp, 3 * kPointerSize));
+  SmiIndex index = masm->SmiToIndex(rax, rax, kPointerSizeLog2);
+  __ movq(rcx,
+          FieldOperand(rcx, index.reg, index.scale, FixedArray::kHeaderSize));
+  __ CompareRoot(rcx, Heap::kUndefinedValueRootIndex);
+  __ j(equal, &slow_case);
+
+  // Check that the boilerplate has the expected size and that it has
+  // neither out-of-object properties nor elements to copy.
+  __ movq(rax, FieldOperand(rcx, HeapObject::kMapOffset));
+  __ cmpb(FieldOperand(rax, Map::kInstanceSizeOffset),
+          Immediate(size >> kPointerSizeLog2));
+  __ j(not_equal, &slow_case);
+  __ CompareRoot(FieldOperand(rcx, JSObject::kPropertiesOffset),
+                 Heap::kEmptyFixedArrayRootIndex);
+  __ j(not_equal, &slow_case);
+  __ CompareRoot(FieldOperand(rcx, JSObject::kElementsOffset),
+                 Heap::kEmptyFixedArrayRootIndex);
+  __ j(not_equal, &slow_case);
+
+  // Allocate the JS object and copy the boilerplate.  The copy is in new
+  // space, so no write barrier is needed.
+  __ AllocateInNewSpace(size, rax, rbx, rdx, &slow_case, TAG_OBJECT);
+  for (int i = 0; i < size; i += kPointerSize) {
+    __ movq(rbx, FieldOperand(rcx, i));
+    __ movq(FieldOperand(rax, i), rbx);
+  }
+
+  // Return and remove the on-stack parameters.
+  __ ret(4 * kPointerSize);
+
+  __ bind(&slow_case);
+  __ TailCallRuntime(Runtime::kCreateObjectLiteralShallow, 4, 1);
+}
+
+
 void ToBooleanStub::Generate(MacroAssembler* masm) {
   NearLabel false_result, true_result, not_string;
   __ movq(rax, Operand(rsp, 1 * kPointerSize));
@@ -1744,6 +1795,20 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ SmiCompare(rbx, FieldOperand(rax, String::kLengthOffset));
   __ j(above_equal, &runtime);
 
+  // rax: Subject string.
+  // rcx: RegExp data (FixedArray).
+  // Searching for the literal that every match contains is faster than
+  // trying each start position in the regexp code, so long subjects are
+  // matched in the runtime system if there is such a literal.
+  NearLabel no_literal_search;
+  __ SmiCompare(FieldOperand(rax, String::kLengthOffset),
+                Smi::FromInt(RegExpImpl::kLiteralSearchMinSubjectLength));
+  __ j(less, &no_literal_search);
+  __ Cmp(FieldOperand(rcx, JSRegExp::kDataIrregexpLiteralOffset),
+         FACTORY->undefined_value());
+  __ j(not_equal, &runtime);
+  __ bind(&no_literal_search);
+
   // rcx: RegExp data (FixedArray)
   // rdx: Number of capture registers
   // Check that the fourth object is a JSArray object.
@@ -1925,7 +1990,8 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmpl(rax, Immediate(NativeRegExpMacroAssembler::FAILURE));
   __ j(equal, &failure);
   __ cmpl(rax, Immediate(NativeRegExpMacroAssembler::EXCEPTION));
-  // If not exception it can only be retry. Handle that in the runtime system.
+  // If not exception it can only be retry or the backtrack limit. Handle that
+  // in the runtime system.
   __ j(not_equal, &runtime);
   // Result must now be exception. If there is no pending exception already a
   // stack overflow (on the backtrack stack) was detected in RegExp code but
@@ -3049,6 +3115,7 @@ const char* CompareStub::GetName() {
 
 void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   Label flat_string;
+  Label cons_string;
   Label ascii_string;
   Label got_char_code;
 
@@ -3079,14 +3146,32 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   __ j(zero, &flat_string);
 
   // Handle non-flat strings.
-  __ testb(result_, Immediate(kIsConsStringMask));
-  __ j(zero, &call_runtime_);
+  __ andl(result_, Immediate(kStringRepresentationMask));
+  __ cmpl(result_, Immediate(kConsStringTag));
+  __ j(equal, &cons_string);
+  __ cmpl(result_, Immediate(kSlicedStringTag));
+  __ j(not_equal, &call_runtime_);
+
+  // SlicedString.
+  // Read the character from the parent if it is sequential.  The runtime
+  // system is called with the slice itself otherwise.
+  __ movq(result_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ movq(result_, FieldOperand(result_, HeapObject::kMapOffset));
+  __ movzxbl(result_, FieldOperand(result_, Map::kInstanceTypeOffset));
+  STATIC_ASSERT(kSeqStringTag == 0);
+  __ testb(result_, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &call_runtime_);
+  // Both the index and the offset are smis.
+  __ addq(scratch_, FieldOperand(object_, SlicedString::kOffsetOffset));
+  __ movq(object_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ jmp(&flat_string);
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
   // this is really a flat string in a cons string). If that is not
   // the case we would rather go to the runtime system now to flatten
   // the string.
+  __ bind(&cons_string);
   __ CompareRoot(FieldOperand(object_, ConsString::kSecondOffset),
                  Heap::kEmptyStringRootIndex);
   __ j(not_equal, &call_runtime_);
@@ -3374,8 +3459,8 @@ void StringAddStub::Generate(MacroAssembler* masm) {
   __ AllocateConsString(rcx, rdi, no_reg, &string_add_runtime);
   __ jmp(&allocated);
 
-  // Handle creating a flat result. First check that both strings are not
-  // external strings.
+  // Handle creating a flat result. First check that both strings are
+  // sequential strings.
   // rax: first string
   // rbx: length of resulting flat string as smi
   // rdx: second string
@@ -3383,14 +3468,11 @@ void StringAddStub::Generate(MacroAssembler* masm) {
   // r9: instance type of first string
   __ bind(&string_add_flat_result);
   __ SmiToInteger32(rbx, rbx);
-  __ movl(rcx, r8);
-  __ and_(rcx, Immediate(kStringRepresentationMask));
-  __ cmpl(rcx, Immediate(kExternalStringTag));
-  __ j(equal, &string_add_runtime);
-  __ movl(rcx, r9);
-  __ and_(rcx, Immediate(kStringRepresentationMask));
-  __ cmpl(rcx, Immediate(kExternalStringTag));
-  __ j(equal, &string_add_runtime);
+  STATIC_ASSERT(kSeqStringTag == 0);
+  __ testb(r8, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &string_add_runtime);
+  __ testb(r9, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &string_add_runtime);
   // Now check if both strings are ascii strings.
   // rax: first string
   // rbx: length of resulting flat string
@@ -3799,6 +3881,64 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   // rax: string
   // rbx: instance type
   // rcx: result string length
+  // Find the string holding the characters and the position of the sub
+  // string in it.
+  __ movq(rdx, Operand(rsp, kFromOffset));
+  if (FLAG_string_slices) {
+    Label not_sliced;
+    __ movl(rdi, rbx);
+    __ andl(rdi, Immediate(kStringRepresentationMask));
+    __ cmpl(rdi, Immediate(kSlicedStringTag));
+    __ j(not_equal, &not_sliced);
+    // Both the from index and the offset are smis.
+    __ addq(rdx, FieldOperand(rax, SlicedString::kOffsetOffset));
+    __ movq(rax, FieldOperand(rax, SlicedString::kParentOffset));
+    __ movq(rbx, FieldOperand(rax, HeapObject::kMapOffset));
+    __ movzxbl(rbx, FieldOperand(rbx, Map::kInstanceTypeOffset));
+    __ bind(&not_sliced);
+
+    // rax: sequential or external string, or a cons string
+    // rbx: instance type
+    // rcx: result string length
+    // rdx: from index in rax (smi)
+    // Long sub strings of sequential and external strings share their
+    // characters.
+    Label copy_characters, two_byte_slice, set_slice_header;
+    __ cmpl(rcx, Immediate(SlicedString::kMinLength));
+    __ j(less, &copy_characters);
+    __ movl(rdi, rbx);
+    __ andl(rdi, Immediate(kStringRepresentationMask));
+    __ cmpl(rdi, Immediate(kConsStringTag));
+    __ j(equal, &runtime);
+    STATIC_ASSERT(kAsciiStringTag != 0);
+    __ testb(rbx, Immediate(kStringEncodingMask));
+    __ j(zero, &two_byte_slice);
+    __ AllocateAsciiSlicedString(rdi, rbx, r14, &runtime);
+    __ jmp(&set_slice_header);
+    __ bind(&two_byte_slice);
+    __ AllocateSlicedString(rdi, rbx, r14, &runtime);
+    __ bind(&set_slice_header);
+    __ Integer32ToSmi(rcx, rcx);
+    __ movq(FieldOperand(rdi, SlicedString::kLengthOffset), rcx);
+    __ movq(FieldOperand(rdi, SlicedString::kHashFieldOffset),
+            Immediate(String::kEmptyHashField));
+    __ movq(FieldOperand(rdi, SlicedString::kParentOffset), rax);
+    __ movq(FieldOperand(rdi, SlicedString::kOffsetOffset), rdx);
+    __ movq(rax, rdi);
+    __ IncrementCounter(COUNTERS->sub_string_native(), 1);
+    __ ret(kArgumentsSize);
+
+    __ bind(&copy_characters);
+  }
+  // Keep the string and the from index for copying the characters.
+  __ movq(r14, rax);
+  __ movq(r11, rdx);
+
+  // rax: string
+  // rbx: instance type
+  // rcx: result string length
+  // r11: from index (smi)
+  // r14: string
   // Check for flat ascii string
   Label non_ascii_flat;
   __ JumpIfInstanceTypeIsNotSequentialAscii(rbx, rbx, &non_ascii_flat);
@@ -3811,9 +3951,9 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ movq(rdx, rsi);  // esi used by following code.
   // Locate first character of result.
   __ lea(rdi, FieldOperand(rax, SeqAsciiString::kHeaderSize));
-  // Load string argument and locate character of sub string start.
-  __ movq(rsi, Operand(rsp, kStringOffset));
-  __ movq(rbx, Operand(rsp, kFromOffset));
+  // Locate character of sub string start in the string argument.
+  __ movq(rsi, r14);
+  __ movq(rbx, r11);
   {
     SmiIndex smi_as_index = masm->SmiToIndex(rbx, rbx, times_1);
     __ lea(rsi, Operand(rsi, smi_as_index.reg, smi_as_index.scale,
@@ -3834,6 +3974,8 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   // rax: string
   // rbx: instance type & kStringRepresentationMask | kStringEncodingMask
   // rcx: result string length
+  // r11: from index (smi)
+  // r14: string
   // Check for sequential two byte string
   __ cmpb(rbx, Immediate(kSeqStringTag | kTwoByteStringTag));
   __ j(not_equal, &runtime);
@@ -3846,9 +3988,9 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ movq(rdx, rsi);  // esi used by following code.
   // Locate first character of result.
   __ lea(rdi, FieldOperand(rax, SeqTwoByteString::kHeaderSize));
-  // Load string argument and locate character of sub string start.
-  __ movq(rsi, Operand(rsp, kStringOffset));
-  __ movq(rbx, Operand(rsp, kFromOffset));
+  // Locate character of sub string start in the string argument.
+  __ movq(rsi, r14);
+  __ movq(rbx, r11);
   {
     SmiIndex smi_as_index = masm->SmiToIndex(rbx, rbx, times_2);
     __ lea(rsi, Operand(rsi, smi_as_index.reg, smi_as_index.scale,
@@ -152,6 +152,8 @@ CodeGenerator::CodeGenerator(MacroAssembler* masm)
       state_(NULL),
       loop_nesting_(0),
       function_return_is_shadowed_(false),
+      inlined_arguments_base_(-1),
+      inlined_argument_count_(0),
       in_spilled_code_(false) {
 }
 
@@ -4382,7 +4384,15 @@ void CodeGenerator::LoadFromSlot(Slot* slot, TypeofState typeof_state) {
     frame_->EmitPush(rcx);
 
   } else if (slot->type() == Slot::PARAMETER) {
-    frame_->PushParameterAt(slot->index());
+    if (!in_inlined_call()) {
+      frame_->PushParameterAt(slot->index());
+    } else if (slot->index() < inlined_argument_count_) {
+      // A parameter of an inlined function is the argument on the frame.
+      int index = inlined_arguments_base_ + slot->index();
+      frame_->PushElementAt(frame_->element_count() - index - 1);
+    } else {
+      frame_->Push(FACTORY->undefined_value());
+    }
 
   } else if (slot->type() == Slot::LOCAL) {
     frame_->PushLocalAt(slot->index());
@@ -4865,11 +4875,17 @@ void CodeGenerator::VisitObjectLiteral(ObjectLiteral* node) {
   frame_->Push(node->constant_properties());
   // Should the object literal have fast elements?
   frame_->Push(Smi::FromInt(node->fast_elements() ? 1 : 0));
+  int properties_count = node->constant_properties()->length() / 2;
   Result clone;
   if (node->depth() > 1) {
     clone = frame_->CallRuntime(Runtime::kCreateObjectLiteral, 4);
-  } else {
+  } else if (!node->fast_elements() ||
+             properties_count >
+                 FastCloneShallowObjectStub::kMaximumClonedProperties) {
     clone = frame_->CallRuntime(Runtime::kCreateObjectLiteralShallow, 4);
+  } else {
+    FastCloneShallowObjectStub stub(properties_count);
+    clone = frame_->CallStub(&stub, 4);
   }
   frame_->Push(&clone);
 
@@ -5329,6 +5345,18 @@ void CodeGenerator::VisitThrow(Throw* node) {
 
 void CodeGenerator::VisitProperty(Property* node) {
   Comment cmnt(masm_, "[ Property");
+  if (node->IsArgumentsReadFromFrame()) {
+    // Read the actual arguments from the frame instead of loading from
+    // an arguments object, which this function never allocates.
+    ZoneList<Expression*>* args = new ZoneList<Expression*>(1);
+    if (node->IsArgumentsLengthReadFromFrame()) {
+      GenerateArgumentsLength(args);
+    } else {
+      args->Add(node->key());
+      GenerateArguments(args);
+    }
+    return;
+  }
   Reference property(this, node);
   property.GetValue();
 }
@@ -5464,15 +5492,29 @@ void CodeGenerator::VisitCall(Call* node) {
       frame_->SpillTop();
     }
 
+    // Use the body of the called function instead of calling it if it is
+    // small enough.  The call IC is used when the global variable has
+    // changed since this code was generated.
+    InlinedCall* inlined = InlinedCall::Analyze(info_, node);
+    JumpTarget slow;
+    JumpTarget done;
+    Result result;
+    if (inlined != NULL) {
+      result = GenerateInlinedCall(node, inlined, &slow);
+      done.Jump(&result);
+      slow.Bind();
+    }
+
     // Push the name of the function on the frame.
     frame_->Push(var->name());
 
     // Call the IC initialization code.
     CodeForSourcePosition(node->position());
-    Result result = frame_->CallCallIC(RelocInfo::CODE_TARGET_CONTEXT,
-                                       arg_count,
-                                       loop_nesting());
+    result = frame_->CallCallIC(RelocInfo::CODE_TARGET_CONTEXT,
+                                arg_count,
+                                loop_nesting());
     frame_->RestoreContextRegister();
+    if (done.is_linked()) done.Bind(&result);
     // Replace the function on the stack with the result.
     frame_->Push(&result);
 
@@ -5646,6 +5688,73 @@ void CodeGenerator::VisitCall(Call* node) {
 }
 
 
+Result CodeGenerator::GenerateInlinedCall(Call* node,
+                                          InlinedCall* inlined,
+                                          JumpTarget* slow) {
+  Comment cmnt(masm_, "[ Inlined call");
+  ASSERT(!in_inlined_call());
+  int arg_count = node->arguments()->length();
+  Handle<String> name = node->expression()->AsVariableProxy()->name();
+
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  // Make the real call once break points are set or LiveEdit has been used.
+  __ movq(kScratchRegister,
+          ExternalReference(Debug_Address::InlinedCallsDisabled()));
+  __ cmpb(Operand(kScratchRegister, 0), Immediate(0));
+  slow->Branch(not_equal);
+#endif
+
+  // The function is resolved after the arguments have been evaluated.
+  // Load it from the global object and check that it is still a function
+  // with the shared function info of the inlined one.
+  CodeForSourcePosition(node->position());
+  frame_->PushElementAt(arg_count);
+  Result function = EmitNamedLoad(name, true);
+  function.ToRegister();
+  Condition is_smi = masm_->CheckSmi(function.reg());
+  slow->Branch(is_smi);
+  __ CmpObjectType(function.reg(), JS_FUNCTION_TYPE, kScratchRegister);
+  slow->Branch(not_equal);
+  __ Move(kScratchRegister, inlined->shared());
+  __ cmpq(FieldOperand(function.reg(), JSFunction::kSharedFunctionInfoOffset),
+          kScratchRegister);
+  function.Unuse();
+  slow->Branch(not_equal);
+
+  // Converting an object argument could call valueOf or toString, which
+  // would see the frame of the inlined function missing.
+  if (inlined->needs_number_arguments()) {
+    for (int i = 0; i < arg_count; i++) {
+      frame_->PushElementAt(arg_count - 1 - i);
+      Result arg = frame_->Pop();
+      if (arg.is_constant() && arg.handle()->IsNumber()) continue;
+      arg.ToRegister();
+      NearLabel is_number;
+      __ JumpIfSmi(arg.reg(), &is_number);
+      __ CompareRoot(FieldOperand(arg.reg(), HeapObject::kMapOffset),
+                     Heap::kHeapNumberMapRootIndex);
+      arg.Unuse();
+      slow->Branch(not_equal);
+      __ bind(&is_number);
+    }
+  }
+
+  // Load the returned expression with the parameters of the inlined
+  // function bound to the arguments on the frame.
+  inlined_arguments_base_ = frame_->element_count() - arg_count;
+  inlined_argument_count_ = arg_count;
+  Load(inlined->result());
+  inlined_arguments_base_ = -1;
+  inlined_argument_count_ = 0;
+
+  // Drop the arguments and the receiver.
+  Result result = frame_->Pop();
+  frame_->Drop(arg_count + 1);
+  __ IncrementCounter(COUNTERS->inlined_calls(), 1);
+  return result;
+}
+
+
 void CodeGenerator::VisitCallNew(CallNew* node) {
   Comment cmnt(masm_, "[ CallNew");
 
@@ -8084,10 +8193,21 @@ class DeferredReferenceGetKeyedValue: public DeferredCode {
 
   virtual void Generate();
 
+  // Registers are saved around the IC call only, so that the external
+  // array case can exit without restoring them.
+  virtual bool AutoSaveAndRestore() { return false; }
+
   Label* patch_site() { return &patch_site_; }
 
+  // Entry for receivers that passed the map check but do not have fast
+  // elements.
+  Label* external_array_label() { return &external_array_; }
+
  private:
+  void GenerateExternalArrayLoad();
+
   Label patch_site_;
+  Label external_array_;
   Register dst_;
   Register receiver_;
   Register key_;
@@ -8095,6 +8215,7 @@ class DeferredReferenceGetKeyedValue: public DeferredCode {
 
 
 void DeferredReferenceGetKeyedValue::Generate() {
+  SaveRegisters();
   if (receiver_.is(rdx)) {
     if (!key_.is(rax)) {
       __ movq(rax, key_);
@@ -8138,6 +8259,88 @@ void DeferredReferenceGetKeyedValue::Generate() {
   __ IncrementCounter(COUNTERS->keyed_load_inline_miss(), 1);
 
   if (!dst_.is(rax)) __ movq(dst_, rax);
+  RestoreRegisters();
+  Exit();
+
+  if (external_array_.is_linked()) GenerateExternalArrayLoad();
+}
+
+
+void DeferredReferenceGetKeyedValue::GenerateExternalArrayLoad() {
+  // Only dst_, kScratchRegister and xmm0 are clobbered here.  All bailouts
+  // go to the IC call above, which saves the frame registers itself.
+  __ bind(&external_array_);
+  __ JumpIfNotSmi(key_, entry_label());
+  __ movq(dst_, FieldOperand(receiver_, JSObject::kElementsOffset));
+
+  // Dispatch on the map of the elements array.
+  static const int kTypeCount = kExternalFloatArray - kExternalByteArray + 1;
+  Label elements_of_type[kTypeCount];
+  for (int i = 0; i < kTypeCount; i++) {
+    ExternalArrayType type = static_cast<ExternalArrayType>(
+        kExternalByteArray + i);
+    __ CompareRoot(FieldOperand(dst_, HeapObject::kMapOffset),
+                   HEAP->RootIndexForExternalArrayType(type));
+    __ j(equal, &elements_of_type[i]);
+  }
+  __ jmp(entry_label());
+
+  Label box_unsigned_int, box, done;
+  for (int i = 0; i < kTypeCount; i++) {
+    ExternalArrayType type = static_cast<ExternalArrayType>(
+        kExternalByteArray + i);
+    __ bind(&elements_of_type[i]);
+    __ SmiToInteger32(kScratchRegister, key_);
+    __ cmpl(kScratchRegister,
+            FieldOperand(dst_, ExternalArray::kLengthOffset));
+    // Unsigned comparison catches both negative and too-large values.
+    __ j(above_equal, entry_label());
+    __ movq(dst_, FieldOperand(dst_, ExternalArray::kExternalPointerOffset));
+    switch (type) {
+      case kExternalByteArray:
+        __ movsxbq(dst_, Operand(dst_, kScratchRegister, times_1, 0));
+        break;
+      case kExternalUnsignedByteArray:
+        __ movzxbq(dst_, Operand(dst_, kScratchRegister, times_1, 0));
+        break;
+      case kExternalShortArray:
+        __ movsxwq(dst_, Operand(dst_, kScratchRegister, times_2, 0));
+        break;
+      case kExternalUnsignedShortArray:
+        __ movzxwq(dst_, Operand(dst_, kScratchRegister, times_2, 0));
+        break;
+      case kExternalIntArray:
+        __ movsxlq(dst_, Operand(dst_, kScratchRegister, times_4, 0));
+        break;
+      case kExternalUnsignedIntArray:
+        __ movl(dst_, Operand(dst_, kScratchRegister, times_4, 0));
+        // Values with the top bit set do not fit in a smi.
+        __ testl(dst_, dst_);
+        __ j(sign, &box_unsigned_int);
+        break;
+      case kExternalFloatArray:
+        __ cvtss2sd(xmm0, Operand(dst_, kScratchRegister, times_4, 0));
+        __ jmp(&box);
+        continue;
+      default:
+        UNREACHABLE();
+        break;
+    }
+    __ Integer32ToSmi(dst_, dst_);
+    __ jmp(&done);
+  }
+
+  __ bind(&box_unsigned_int);
+  // The value is zero-extended, so a 64-bit conversion gives the unsigned
+  // value.
+  __ cvtqsi2sd(xmm0, dst_);
+  __ bind(&box);
+  __ AllocateHeapNumber(dst_, no_reg, entry_label());
+  __ movsd(FieldOperand(dst_, HeapNumber::kValueOffset), xmm0);
+
+  __ bind(&done);
+  __ IncrementCounter(COUNTERS->keyed_load_external_array_inline(), 1);
+  Exit();
 }
 
 
@@ -8145,68 +8348,90 @@ class DeferredReferenceSetKeyedValue: public DeferredCode {
  public:
   DeferredReferenceSetKeyedValue(Register value,
                                  Register key,
-                                 Register receiver)
-      : value_(value), key_(key), receiver_(receiver) {
+                                 Register receiver,
+                                 Register scratch1,
+                                 Register scratch2)
+      : value_(value),
+        key_(key),
+        receiver_(receiver),
+        scratch1_(scratch1),
+        scratch2_(scratch2) {
     set_comment("[ DeferredReferenceSetKeyedValue");
   }
 
   virtual void Generate();
 
+  // Registers are saved around the IC call only, so that the external
+  // array case can exit without restoring them.
+  virtual bool AutoSaveAndRestore() { return false; }
+
   Label* patch_site() { return &patch_site_; }
 
+  // Entry for receivers whose elements failed the fixed array map check,
+  // with the map checked against in kScratchRegister.
+  Label* external_array_label() { return &external_array_; }
+
  private:
+  void GenerateExternalArrayStore();
+
   Register value_;
   Register key_;
   Register receiver_;
+  Register scratch1_;
+  Register scratch2_;
   Label patch_site_;
+  Label external_array_;
 };
 
 
 void DeferredReferenceSetKeyedValue::Generate() {
+  SaveRegisters();
   __ IncrementCounter(COUNTERS->keyed_store_inline_miss(), 1);
   // Move value, receiver, and key to registers rax, rdx, and rcx, as
   // the IC stub expects.
+  Register receiver = receiver_;
+  Register key = key_;
   // Move value to rax, using xchg if the receiver or key is in rax.
   if (!value_.is(rax)) {
-    if (!receiver_.is(rax) && !key_.is(rax)) {
+    if (!receiver.is(rax) && !key.is(rax)) {
       __ movq(rax, value_);
     } else {
       __ xchg(rax, value_);
-      // Update receiver_ and key_ if they are affected by the swap.
-      if (receiver_.is(rax)) {
-        receiver_ = value_;
-      } else if (receiver_.is(value_)) {
-        receiver_ = rax;
+      // Update receiver and key if they are affected by the swap.
+      if (receiver.is(rax)) {
+        receiver = value_;
+      } else if (receiver.is(value_)) {
+        receiver = rax;
       }
-      if (key_.is(rax)) {
-        key_ = value_;
-      } else if (key_.is(value_)) {
-        key_ = rax;
+      if (key.is(rax)) {
+        key = value_;
+      } else if (key.is(value_)) {
+        key = rax;
       }
     }
   }
   // Value is now in rax. Its original location is remembered in value_,
   // and the value is restored to value_ before returning.
-  // The variables receiver_ and key_ are not preserved.
+  // The registers receiver and key are not preserved.
   // Move receiver and key to rdx and rcx, swapping if necessary.
-  if (receiver_.is(rdx)) {
-    if (!key_.is(rcx)) {
-      __ movq(rcx, key_);
+  if (receiver.is(rdx)) {
+    if (!key.is(rcx)) {
+      __ movq(rcx, key);
     }  // Else everything is already in the right place.
-  } else if (receiver_.is(rcx)) {
-    if (key_.is(rdx)) {
+  } else if (receiver.is(rcx)) {
+    if (key.is(rdx)) {
       __ xchg(rcx, rdx);
-    } else if (key_.is(rcx)) {
-      __ movq(rdx, receiver_);
+    } else if (key.is(rcx)) {
+      __ movq(rdx, receiver);
     } else {
-      __ movq(rdx, receiver_);
-      __ movq(rcx, key_);
+      __ movq(rdx, receiver);
+      __ movq(rcx, key);
     }
-  } else if (key_.is(rcx)) {
-    __ movq(rdx, receiver_);
+  } else if (key.is(rcx)) {
+    __ movq(rdx, receiver);
   } else {
-    __ movq(rcx, key_);
-    __ movq(rdx, receiver_);
+    __ movq(rcx, key);
+    __ movq(rdx, receiver);
   }
 
   // Call the IC stub.
@@ -8224,6 +8449,126 @@ void DeferredReferenceSetKeyedValue::Generate() {
   masm_->testl(rax, Immediate(-delta_to_patch_site));
   // Restore value (returned from store IC).
   if (!value_.is(rax)) __ movq(value_, rax);
+  RestoreRegisters();
+  Exit();
+
+  if (external_array_.is_linked()) GenerateExternalArrayStore();
+}
+
+
+void DeferredReferenceSetKeyedValue::GenerateExternalArrayStore() {
+  // The receiver is a heap object and the key a smi.  Only the scratch
+  // registers, kScratchRegister and xmm0 are clobbered here.  All bailouts
+  // go to the IC call above.
+  __ bind(&external_array_);
+  // A cleared inline cache has replaced the fixed array map, so that all
+  // stores go through the IC call.
+  __ CompareRoot(kScratchRegister, Heap::kFixedArrayMapRootIndex);
+  __ j(not_equal, entry_label());
+  __ movq(scratch1_, FieldOperand(receiver_, HeapObject::kMapOffset));
+  // Nothing but the receiver type is checked, so objects requiring access
+  // checks must go through the IC.
+  __ testb(FieldOperand(scratch1_, Map::kBitFieldOffset),
+           Immediate(1 << Map::kIsAccessCheckNeeded));
+  __ j(not_zero, entry_label());
+  __ CmpInstanceType(scratch1_, JS_OBJECT_TYPE);
+  __ j(not_equal, entry_label());
+  __ movq(scratch1_, FieldOperand(receiver_, JSObject::kElementsOffset));
+
+  // Dispatch on the map of the elements array.  Signed and unsigned
+  // elements of the same size are stored the same way.
+  Label byte_elements, short_elements, int_elements, float_elements;
+  static const int kTypeCount = kExternalFloatArray - kExternalByteArray + 1;
+  for (int i = 0; i < kTypeCount; i++) {
+    ExternalArrayType type = static_cast<ExternalArrayType>(
+        kExternalByteArray + i);
+    Label* target = NULL;
+    switch (type) {
+      case kExternalByteArray:
+      case kExternalUnsignedByteArray:
+        target = &byte_elements;
+        break;
+      case kExternalShortArray:
+      case kExternalUnsignedShortArray:
+        target = &short_elements;
+        break;
+      case kExternalIntArray:
+      case kExternalUnsignedIntArray:
+        target = &int_elements;
+        break;
+      case kExternalFloatArray:
+        target = &float_elements;
+        break;
+      default:
+        UNREACHABLE();
+        break;
+    }
+    __ CompareRoot(FieldOperand(scratch1_, HeapObject::kMapOffset),
+                   HEAP->RootIndexForExternalArrayType(type));
+    __ j(equal, target);
+  }
+  __ jmp(entry_label());
+
+  Label done;
+  Label* element_labels[] = {
+    &byte_elements, &short_elements, &int_elements, &float_elements
+  };
+  ScaleFactor scales[] = { times_1, times_2, times_4, times_4 };
+  for (int i = 0; i < 4; i++) {
+    Label* element_label = element_labels[i];
+    bool is_float = element_label == &float_elements;
+    __ bind(element_label);
+    __ SmiToInteger32(kScratchRegister, key_);
+    __ cmpl(kScratchRegister,
+            FieldOperand(scratch1_, ExternalArray::kLengthOffset));
+    // Unsigned comparison catches both negative and too-large values.
+    __ j(above_equal, entry_label());
+    __ movq(scratch1_,
+            FieldOperand(scratch1_, ExternalArray::kExternalPointerOffset));
+    Operand element(scratch1_, kScratchRegister, scales[i], 0);
+
+    // Handle both smis and heap numbers, converting them the same way
+    // the external array store stubs do.
+    NearLabel heap_number;
+    __ JumpIfNotSmi(value_, &heap_number);
+    __ SmiToInteger32(scratch2_, value_);
+    if (is_float) {
+      __ cvtlsi2ss(xmm0, scratch2_);
+      __ movss(element, xmm0);
+    } else if (scales[i] == times_1) {
+      __ movb(element, scratch2_);
+    } else if (scales[i] == times_2) {
+      __ movw(element, scratch2_);
+    } else {
+      __ movl(element, scratch2_);
+    }
+    __ jmp(&done);
+
+    __ bind(&heap_number);
+    __ CmpObjectType(value_, HEAP_NUMBER_TYPE, scratch2_);
+    __ j(not_equal, entry_label());
+    __ movsd(xmm0, FieldOperand(value_, HeapNumber::kValueOffset));
+    if (is_float) {
+      __ cvtsd2ss(xmm0, xmm0);
+      __ movss(element, xmm0);
+    } else if (scales[i] == times_1) {
+      __ cvtsd2si(scratch2_, xmm0);
+      __ movb(element, scratch2_);
+    } else if (scales[i] == times_2) {
+      __ cvtsd2si(scratch2_, xmm0);
+      __ movw(element, scratch2_);
+    } else {
+      // Convert to int64, so that NaN and infinities become
+      // 0x8000000000000000, which is zero mod 2^32.
+      __ cvtsd2siq(scratch2_, xmm0);
+      __ movl(element, scratch2_);
+    }
+    __ jmp(&done);
+  }
+
+  __ bind(&done);
+  __ IncrementCounter(COUNTERS->keyed_store_external_array_inline(), 1);
+  Exit();
 }
 
 
@@ -8473,6 +8818,12 @@ Result CodeGenerator::EmitKeyedLoad() {
                 kScratchRegister);
     deferred->Branch(not_equal);
 
+    // The map is also patched in for receivers with external array
+    // elements.  Those are handled out of line.
+    __ testb(FieldOperand(kScratchRegister, Map::kBitField2Offset),
+             Immediate(1 << Map::kHasFastElements));
+    __ j(zero, deferred->external_array_label());
+
     __ JumpUnlessNonNegativeSmi(key.reg(), deferred->entry_label());
 
     // Get the elements array from the receiver.
@@ -8552,7 +8903,9 @@ Result CodeGenerator::EmitKeyedStore(StaticType* key_type) {
     DeferredReferenceSetKeyedValue* deferred =
         new DeferredReferenceSetKeyedValue(result.reg(),
                                            key.reg(),
-                                           receiver.reg());
+                                           receiver.reg(),
+                                           tmp.reg(),
+                                           tmp2.reg());
 
     // Check that the receiver is not a smi.
     __ JumpIfSmi(receiver.reg(), deferred->entry_label());
@@ -8564,21 +8917,36 @@ Result CodeGenerator::EmitKeyedStore(StaticType* key_type) {
       __ AbortIfNotSmi(key.reg());
     }
 
-    // Check that the receiver is a JSArray.
+    // Check that the receiver is a JSObject and get its elements array.
+    __ CmpObjectType(receiver.reg(), FIRST_JS_OBJECT_TYPE, kScratchRegister);
+    deferred->Branch(below);
+    __ movq(tmp.reg(),
+            FieldOperand(receiver.reg(), JSObject::kElementsOffset));
+
+    // Bind the deferred code patch site to be able to locate the fixed
+    // array map comparison.  When debugging, we patch this comparison to
+    // always fail so that we will hit the IC call in the deferred code
+    // which will allow the debugger to break for fast case stores.  The
+    // external array case is handled out of line, and checks the map left
+    // in kScratchRegister to see whether the check has been disabled.
+    __ bind(deferred->patch_site());
+    // Avoid using __ to ensure the distance from patch_site
+    // to the map address is always the same.
+    masm()->movq(kScratchRegister, FACTORY->fixed_array_map(),
+               RelocInfo::EMBEDDED_OBJECT);
+    __ cmpq(FieldOperand(tmp.reg(), HeapObject::kMapOffset),
+            kScratchRegister);
+    __ j(not_equal, deferred->external_array_label());
+
+    // Check that the receiver is a JSArray and that the key is within
+    // bounds.  Both the key and the length of the JSArray are smis.  Use
+    // unsigned comparison to handle negative keys.
     __ CmpObjectType(receiver.reg(), JS_ARRAY_TYPE, kScratchRegister);
     deferred->Branch(not_equal);
-
-    // Check that the key is within bounds.  Both the key and the length of
-    // the JSArray are smis. Use unsigned comparison to handle negative keys.
     __ SmiCompare(FieldOperand(receiver.reg(), JSArray::kLengthOffset),
                   key.reg());
     deferred->Branch(below_equal);
 
-    // Get the elements array from the receiver and check that it is not a
-    // dictionary.
-    __ movq(tmp.reg(),
-            FieldOperand(receiver.reg(), JSArray::kElementsOffset));
-
     // Check whether it is possible to omit the write barrier. If the elements
     // array is in new space or the value written is a smi we can safely update
     // the elements array without write barrier.
@@ -8589,19 +8957,6 @@ Result CodeGenerator::EmitKeyedStore(StaticType* key_type) {
     }
 
     __ bind(&in_new_space);
-    // Bind the deferred code patch site to be able to locate the fixed
-    // array map comparison.  When debugging, we patch this comparison to
-    // always fail so that we will hit the IC call in the deferred code
-    // which will allow the debugger to break for fast case stores.
-    __ bind(deferred->patch_site());
-    // Avoid using __ to ensure the distance from patch_site
-    // to the map address is always the same.
-    masm()->movq(kScratchRegister, FACTORY->fixed_array_map(),
-               RelocInfo::EMBEDDED_OBJECT);
-    __ cmpq(FieldOperand(tmp.reg(), HeapObject::kMapOffset),
-            kScratchRegister);
-    deferred->Branch(not_equal);
-
     // Store the value.
     SmiIndex index =
         masm()->SmiToIndex(kScratchRegister, key.reg(), kPointerSizeLog2);
@@ -8653,9 +9008,11 @@ void Reference::GetValue() {
   ASSERT(!is_illegal());
   MacroAssembler* masm = cgen_->masm();
 
-  // Record the source position for the property load.
+  // Record the source position for the property load.  Positions in the
+  // body of an inlined function belong to another function, so its code
+  // keeps the position of the call.
   Property* property = expression_->AsProperty();
-  if (property != NULL) {
+  if (property != NULL && !cgen_->in_inlined_call()) {
     cgen_->CodeForSourcePosition(property->position());
   }
 
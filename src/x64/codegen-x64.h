@@ -38,6 +38,7 @@ namespace internal {
 // Forward declarations
 class CompilationInfo;
 class DeferredCode;
+class InlinedCall;
 class RegisterAllocator;
 class RegisterFile;
 
@@ -454,6 +455,16 @@ class CodeGenerator: public AstVisitor {
   // Receiver is passed on the frame and not consumed.
   Result EmitNamedLoad(Handle<String> name, bool is_contextual);
 
+  // Generate the body of the function called by a call to a global
+  // function in place of the call.  The receiver and the arguments are
+  // passed on the frame and consumed.  Jumps to slow with the frame
+  // unchanged when the global variable no longer holds the function.
+  Result GenerateInlinedCall(Call* node,
+                             InlinedCall* inlined,
+                             JumpTarget* slow);
+
+  bool in_inlined_call() const { return inlined_arguments_base_ >= 0; }
+
   // If the store is contextual, value is passed on the frame and consumed.
   // Otherwise, receiver and value are passed on the frame and consumed.
   Result EmitNamedStore(Handle<String> name, bool is_contextual);
@@ -720,6 +731,13 @@ class CodeGenerator: public AstVisitor {
   // to some unlinking code).
   bool function_return_is_shadowed_;
 
+  // While generating the body of an inlined function, the frame element
+  // index of the first argument passed by the call and the number of
+  // arguments.  The parameters of the inlined function are read from
+  // these elements.  The base is -1 outside inlined function bodies.
+  int inlined_arguments_base_;
+  int inlined_argument_count_;
+
   // True when we are in code that expects the virtual frame to be fully
   // spilled.  Some virtual frame function are disabled in DEBUG builds when
   // called from spilled code, because they do not leave the virtual frame
@@ -116,8 +116,8 @@ static void GenerateStringDictionaryProbes(MacroAssembler* masm,
   __ decl(r0);
 
   // Generate an unrolled loop that performs a few probes before
-  // giving up. Measurements done on Gmail indicate that 2 probes
-  // cover ~93% of loads from dictionaries.
+  // falling back to a probing loop. Measurements done on Gmail indicate
+  // that 2 probes cover ~93% of loads from dictionaries.
   static const int kProbes = 4;
   const int kElementsStartOffset =
       StringDictionary::kHeaderSize +
@@ -135,15 +135,48 @@ static void GenerateStringDictionaryProbes(MacroAssembler* masm,
     ASSERT(StringDictionary::kEntrySize == 3);
     __ lea(r1, Operand(r1, r1, times_2, 0));  // r1 = r1 * 3
 
-    // Check if the key is identical to the name.
+    // Check if the key is identical to the name.  An undefined key ends
+    // the probe sequence.
     __ cmpq(name, Operand(elements, r1, times_pointer_size,
                           kElementsStartOffset - kHeapObjectTag));
-    if (i != kProbes - 1) {
-      __ j(equal, done);
-    } else {
-      __ j(not_equal, miss);
-    }
+    __ j(equal, done);
+    __ CompareRoot(Operand(elements, r1, times_pointer_size,
+                           kElementsStartOffset - kHeapObjectTag),
+                   Heap::kUndefinedValueRootIndex);
+    __ j(equal, miss);
   }
+
+  // Keep probing until the name or an undefined key is found, as the
+  // lookup in the runtime does.  There are no registers left for the
+  // probe number, so it is kept on the stack.
+  Label loop, found;
+  __ push(Immediate(kProbes));
+  __ bind(&loop);
+  __ movl(r1, Operand(rsp, 0));
+  __ incl(Operand(rsp, 0));
+  __ movl(r0, r1);
+  __ imull(r0, r1);
+  __ addl(r0, r1);
+  __ shrl(r0, Immediate(1));  // r0 = (i + i * i) / 2
+  __ movl(r1, FieldOperand(name, String::kHashFieldOffset));
+  __ shrl(r1, Immediate(String::kHashShift));
+  __ addl(r1, r0);
+  __ SmiToInteger32(r0, FieldOperand(elements, kCapacityOffset));
+  __ decl(r0);
+  __ and_(r1, r0);
+  __ lea(r1, Operand(r1, r1, times_2, 0));  // r1 = r1 * 3
+  __ cmpq(name, Operand(elements, r1, times_pointer_size,
+                        kElementsStartOffset - kHeapObjectTag));
+  __ j(equal, &found);
+  __ CompareRoot(Operand(elements, r1, times_pointer_size,
+                         kElementsStartOffset - kHeapObjectTag),
+                 Heap::kUndefinedValueRootIndex);
+  __ j(not_equal, &loop);
+  __ addq(rsp, Immediate(kPointerSize));
+  __ jmp(miss);
+  __ bind(&found);
+  __ addq(rsp, Immediate(kPointerSize));
+  __ jmp(done);
 }
 
 
@@ -579,7 +612,8 @@ void KeyedLoadIC::GenerateGeneric(MacroAssembler* masm) {
   //  -- rsp[0] : return address
   // -----------------------------------
   Label slow, check_string, index_smi, index_string, property_array_property;
-  Label check_pixel_array, probe_dictionary, check_number_dictionary;
+  Label check_pixel_array, check_double_array, probe_dictionary;
+  Label check_number_dictionary;
 
   // Check that the key is a smi.
   __ JumpIfNotSmi(rax, &check_string);
@@ -615,7 +649,7 @@ void KeyedLoadIC::GenerateGeneric(MacroAssembler* masm) {
   __ SmiToInteger32(rbx, rax);  // Used on both directions of next branch.
   __ CompareRoot(FieldOperand(rcx, HeapObject::kMapOffset),
                  Heap::kPixelArrayMapRootIndex);
-  __ j(not_equal, &check_number_dictionary);
+  __ j(not_equal, &check_double_array);
   __ cmpl(rbx, FieldOperand(rcx, PixelArray::kLengthOffset));
   __ j(above_equal, &slow);
   __ movq(rax, FieldOperand(rcx, PixelArray::kExternalPointerOffset));
@@ -623,6 +657,28 @@ void KeyedLoadIC::GenerateGeneric(MacroAssembler* masm) {
   __ Integer32ToSmi(rax, rax);
   __ ret(0);
 
+  __ bind(&check_double_array);
+  // Check whether the elements is an array of unboxed doubles.
+  // rdx: receiver
+  // rax: key
+  // rbx: key as untagged int32
+  // rcx: elements
+  __ CompareRoot(FieldOperand(rcx, HeapObject::kMapOffset),
+                 Heap::kFixedDoubleArrayMapRootIndex);
+  __ j(not_equal, &check_number_dictionary);
+  __ SmiCompare(rax, FieldOperand(rcx, FixedDoubleArray::kLengthOffset));
+  __ j(above_equal, &slow);
+  // Holes are looked up in the prototype chain by the runtime.
+  __ cmpl(FieldOperand(rcx, rbx, times_8,
+                       FixedDoubleArray::kHeaderSize + kIntSize),
+          Immediate(FixedDoubleArray::kHoleNanUpper32));
+  __ j(equal, &slow);
+  __ movq(rdi, FieldOperand(rcx, rbx, times_8, FixedDoubleArray::kHeaderSize));
+  __ AllocateHeapNumber(rcx, rbx, &slow);
+  __ movq(FieldOperand(rcx, HeapNumber::kValueOffset), rdi);
+  __ movq(rax, rcx);
+  __ ret(0);
+
   __ bind(&check_number_dictionary);
   // Check whether the elements is a number dictionary.
   // rdx: receiver
@@ -968,6 +1024,7 @@ void KeyedStoreIC::GenerateGeneric(MacroAssembler* masm) {
   //  -- rsp[0]  : return address
   // -----------------------------------
   Label slow, slow_with_tagged_index, fast, array, extra, check_pixel_array;
+  Label double_array;
 
   // Check that the object isn't a smi.
   __ JumpIfSmi(rdx, &slow_with_tagged_index);
@@ -1065,7 +1122,7 @@ void KeyedStoreIC::GenerateGeneric(MacroAssembler* masm) {
   __ movq(rbx, FieldOperand(rdx, JSObject::kElementsOffset));
   __ CompareRoot(FieldOperand(rbx, HeapObject::kMapOffset),
                  Heap::kFixedArrayMapRootIndex);
-  __ j(not_equal, &slow);
+  __ j(not_equal, &double_array);
 
   // Check the key against the length in the array, compute the
   // address to store into and fall through to fast case.
@@ -1088,6 +1145,41 @@ void KeyedStoreIC::GenerateGeneric(MacroAssembler* masm) {
   __ movq(rdx, rax);
   __ RecordWriteNonSmi(rbx, 0, rdx, rcx);
   __ ret(0);
+
+  // Array of unboxed doubles case: store a number within the length of
+  // the array.  Other values and stores that grow the array go to the
+  // runtime.
+  __ bind(&double_array);
+  // rax: value
+  // rdx: receiver (a JSArray)
+  // rbx: receiver's elements array
+  // rcx: index
+  __ CompareRoot(FieldOperand(rbx, HeapObject::kMapOffset),
+                 Heap::kFixedDoubleArrayMapRootIndex);
+  __ j(not_equal, &slow);
+  __ SmiCompareInteger32(FieldOperand(rdx, JSArray::kLengthOffset), rcx);
+  __ j(below_equal, &slow);
+  NearLabel non_smi_double_value;
+  __ JumpIfNotSmi(rax, &non_smi_double_value);
+  __ SmiToInteger32(rdi, rax);
+  __ cvtlsi2sd(xmm0, rdi);
+  __ movsd(FieldOperand(rbx, rcx, times_8, FixedDoubleArray::kHeaderSize),
+           xmm0);
+  __ ret(0);
+  __ bind(&non_smi_double_value);
+  __ CompareRoot(FieldOperand(rax, HeapObject::kMapOffset),
+                 Heap::kHeapNumberMapRootIndex);
+  __ j(not_equal, &slow);
+  // The runtime canonicalizes NaNs so they cannot be taken for the hole.
+  // Infinities share their exponent and take the same path.
+  __ movl(rdi, FieldOperand(rax, HeapNumber::kExponentOffset));
+  __ andl(rdi, Immediate(HeapNumber::kExponentMask));
+  __ cmpl(rdi, Immediate(HeapNumber::kExponentMask));
+  __ j(equal, &slow);
+  __ movq(rdi, FieldOperand(rax, HeapNumber::kValueOffset));
+  __ movq(FieldOperand(rbx, rcx, times_8, FixedDoubleArray::kHeaderSize),
+          rdi);
+  __ ret(0);
 }
 
 
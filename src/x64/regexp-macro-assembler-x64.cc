@@ -136,6 +136,7 @@ RegExpMacroAssemblerX64::~RegExpMacroAssemblerX64() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -162,6 +163,11 @@ void RegExpMacroAssemblerX64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerX64::Backtrack() {
   CheckPreemption();
+  if (backtrack_limit() > 0) {
+    __ incq(Operand(rbp, kBacktrackCount));
+    __ cmpq(Operand(rbp, kBacktrackCount), Immediate(backtrack_limit()));
+    __ j(equal, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(rbx);
   __ addq(rbx, code_object_pointer());
@@ -737,6 +743,7 @@ Handle<Object> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
 #endif
 
   __ push(Immediate(0));  // Make room for "at start" constant.
+  __ push(Immediate(0));  // Backtrack counter.
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -953,6 +960,14 @@ Handle<Object> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
     __ jmp(&exit_label_);
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    // Exit with Result BACKTRACK_LIMIT(-3) to have the caller match with
+    // RegExpNfa.
+    __ bind(&backtrack_limit_label_);
+    __ movq(rax, Immediate(BACKTRACK_LIMIT));
+    __ jmp(&exit_label_);
+  }
+
   FixupCodeRelativePositions();
 
   CodeDesc code_desc;
@@ -1193,11 +1208,12 @@ int RegExpMacroAssemblerX64::CheckStackGuardState(Address* return_address,
   }
 
   // Otherwise, the content of the string might have moved. It must still
-  // be a sequential or external string with the same content.
+  // be a sequential, external or sliced string with the same content.
   // Update the start and end pointers in the stack frame to the current
   // location (whether it has actually moved or not).
   ASSERT(StringShape(*subject).IsSequential() ||
-      StringShape(*subject).IsExternal());
+      StringShape(*subject).IsExternal() ||
+      StringShape(*subject).IsSliced());
 
   // The original start address of the characters to match.
   const byte* start_address = frame_entry<const byte*>(re_frame, kInputStart);
@@ -56,6 +56,9 @@ static void ProbeTable(Isolate* isolate,
   // The offset register holds the entry offset times four (due to masking
   // and shifting optimizations).
   ExternalReference key_offset(isolate->stub_cache()->key_reference(table));
+  StatsCounter* hit_counter = table == StubCache::kPrimary
+      ? COUNTERS->megamorphic_stub_cache_primary_hits()
+      : COUNTERS->megamorphic_stub_cache_secondary_hits();
   Label miss;
 
   __ movq(kScratchRegister, key_offset);
@@ -67,17 +70,20 @@ static void ProbeTable(Isolate* isolate,
   __ j(not_equal, &miss);
   // Get the code entry from the cache.
   // Use key_offset + kPointerSize, rather than loading value_offset.
-  __ movq(kScratchRegister,
-          Operand(kScratchRegister, offset, times_4, kPointerSize));
+  // The offset is not needed any more, so the code entry is kept in the
+  // offset register, leaving kScratchRegister free for the hit counter.
+  __ movq(offset, Operand(kScratchRegister, offset, times_4, kPointerSize));
   // Check that the flags match what we're looking for.
-  __ movl(offset, FieldOperand(kScratchRegister, Code::kFlagsOffset));
-  __ and_(offset, Immediate(~Code::kFlagsNotUsedInLookup));
-  __ cmpl(offset, Immediate(flags));
+  __ movl(kScratchRegister, FieldOperand(offset, Code::kFlagsOffset));
+  __ and_(kScratchRegister, Immediate(~Code::kFlagsNotUsedInLookup));
+  __ cmpl(kScratchRegister, Immediate(flags));
   __ j(not_equal, &miss);
 
+  __ IncrementCounter(hit_counter, 1);
+
   // Jump to the first instruction in the code stub.
-  __ addq(kScratchRegister, Immediate(Code::kHeaderSize - kHeapObjectTag));
-  __ jmp(kScratchRegister);
+  __ addq(offset, Immediate(Code::kHeaderSize - kHeapObjectTag));
+  __ jmp(offset);
 
   __ bind(&miss);
 }
@@ -296,15 +302,22 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   ASSERT(!scratch.is(no_reg));
   ASSERT(extra2.is(no_reg));
 
+  __ IncrementCounter(COUNTERS->megamorphic_stub_cache_probes(), 1);
+
   // Check that the receiver isn't a smi.
   __ JumpIfSmi(receiver, &miss);
 
+  StubCache* stub_cache = isolate->stub_cache();
+  ExternalReference primary_mask(stub_cache->mask_reference(kPrimary));
+  ExternalReference secondary_mask(stub_cache->mask_reference(kSecondary));
+
   // Get the map of the receiver and compute the hash.
   __ movl(scratch, FieldOperand(name, String::kHashFieldOffset));
   // Use only the low 32 bits of the map pointer.
   __ addl(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, Immediate(flags));
-  __ and_(scratch, Immediate((kPrimaryTableSize - 1) << kHeapObjectTagSize));
+  __ movq(kScratchRegister, primary_mask);
+  __ andl(scratch, Operand(kScratchRegister, 0));
 
   // Probe the primary table.
   ProbeTable(isolate, masm, flags, kPrimary, name, scratch);
@@ -313,10 +326,12 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ movl(scratch, FieldOperand(name, String::kHashFieldOffset));
   __ addl(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, Immediate(flags));
-  __ and_(scratch, Immediate((kPrimaryTableSize - 1) << kHeapObjectTagSize));
+  __ movq(kScratchRegister, primary_mask);
+  __ andl(scratch, Operand(kScratchRegister, 0));
   __ subl(scratch, name);
   __ addl(scratch, Immediate(flags));
-  __ and_(scratch, Immediate((kSecondaryTableSize - 1) << kHeapObjectTagSize));
+  __ movq(kScratchRegister, secondary_mask);
+  __ andl(scratch, Operand(kScratchRegister, 0));
 
   // Probe the secondary table.
   ProbeTable(isolate, masm, flags, kSecondary, name, scratch);
@@ -324,6 +339,7 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(COUNTERS->megamorphic_stub_cache_misses(), 1);
 }
 
 
@@ -538,12 +554,15 @@ static void FreeSpaceForFastApiCall(MacroAssembler* masm, Register scratch) {
 }
 
 
-// Generates call to API function.
+// Generates call to API function.  The function is passed in rdi rather
+// than embedded in the code, so that the global call stub can call any
+// closure of the api function that it found in the property cell.
 static bool GenerateFastApiCall(MacroAssembler* masm,
                                 const CallOptimization& optimization,
                                 int argc,
                                 Failure** failure) {
   // ----------- S t a t e -------------
+  //  -- rdi                 : api function
   //  -- rsp[0]              : return address
   //  -- rsp[8]              : object passing the type check
   //                           (last fast api call extra argument,
@@ -557,9 +576,7 @@ static bool GenerateFastApiCall(MacroAssembler* masm,
   //  -- rsp[(argc + 4) * 8] : receiver
   // -----------------------------------
 
-  // Get the function and setup the context.
-  JSFunction* function = optimization.constant_function();
-  __ Move(rdi, Handle<JSFunction>(function));
+  // Setup the context.
   __ movq(rsi, FieldOperand(rdi, JSFunction::kContextOffset));
 
   // Pass the additional arguments.
@@ -603,6 +620,10 @@ static bool GenerateFastApiCall(MacroAssembler* masm,
 
   // v8::InvocationCallback's argument.
   __ lea(arguments_arg, StackSpaceOperand(0));
+  // The callback returns a v8::Handle<Value>, so it needs an open handle
+  // scope to allocate its result in.  The scope is entered and left inline
+  // by bumping the isolate's handle scope data; returning the value
+  // without a handle would need a different InvocationCallback signature.
   // Emitting a stub call may try to allocate (if the code is not
   // already generated).  Do not allow the assembler to perform a
   // garbage collection but instead return the allocation failure
@@ -746,6 +767,7 @@ class CallInterceptorCompiler BASE_EMBEDDED {
 
     // Invoke function.
     if (can_do_fast_api_call) {
+      __ Move(rdi, Handle<JSFunction>(optimization.constant_function()));
       bool success = GenerateFastApiCall(masm,
                                          optimization,
                                          arguments_.immediate(),
@@ -1082,6 +1104,7 @@ MaybeObject* CallStubCompiler::CompileCallConstant(
 
     // rsp[2 * kPointerSize] is uninitialized, rsp[3 * kPointerSize] contains
     // duplicate of return address and will be overwritten.
+    __ Move(rdi, Handle<JSFunction>(function));
     bool success = GenerateFastApiCall(masm(), optimization, argc, &failure);
     if (!success) {
       return failure;
@@ -1206,7 +1229,7 @@ MaybeObject* CallStubCompiler::CompileArrayPushCall(Object* object,
     __ movq(rax, FieldOperand(rdx, JSArray::kLengthOffset));
     __ ret((argc + 1) * kPointerSize);
   } else {
-    Label call_builtin;
+    Label call_builtin, double_elements;
 
     // Get the elements array of the object.
     __ movq(rbx, FieldOperand(rdx, JSArray::kElementsOffset));
@@ -1214,7 +1237,7 @@ MaybeObject* CallStubCompiler::CompileArrayPushCall(Object* object,
     // Check that the elements are in fast mode and writable.
     __ Cmp(FieldOperand(rbx, HeapObject::kMapOffset),
            FACTORY->fixed_array_map());
-    __ j(not_equal, &call_builtin);
+    __ j(not_equal, argc == 1 ? &double_elements : &call_builtin);
 
     if (argc == 1) {  // Otherwise fall through to call builtin.
       Label exit, with_write_barrier, attempt_to_grow_elements;
@@ -1310,6 +1333,43 @@ MaybeObject* CallStubCompiler::CompileArrayPushCall(Object* object,
 
       // Elements are in new space, so write barrier is not required.
       __ ret((argc + 1) * kPointerSize);
+
+      // Push a number onto an array of unboxed doubles with spare capacity.
+      // Growing the elements is left to the builtin.
+      __ bind(&double_elements);
+      __ Cmp(FieldOperand(rbx, HeapObject::kMapOffset),
+             FACTORY->fixed_double_array_map());
+      __ j(not_equal, &call_builtin);
+      __ SmiToInteger32(rax, FieldOperand(rdx, JSArray::kLengthOffset));
+      __ SmiCompareInteger32(
+          FieldOperand(rbx, FixedDoubleArray::kLengthOffset), rax);
+      __ j(below_equal, &call_builtin);
+
+      Label not_smi, store_double;
+      __ movq(rcx, Operand(rsp, argc * kPointerSize));
+      __ JumpIfNotSmi(rcx, &not_smi);
+      __ SmiToInteger32(rdi, rcx);
+      __ cvtlsi2sd(xmm0, rdi);
+      __ jmp(&store_double);
+
+      __ bind(&not_smi);
+      __ CompareRoot(FieldOperand(rcx, HeapObject::kMapOffset),
+                     Heap::kHeapNumberMapRootIndex);
+      __ j(not_equal, &call_builtin);
+      // NaNs are canonicalized by the builtin.
+      __ movl(rdi, FieldOperand(rcx, HeapNumber::kExponentOffset));
+      __ andl(rdi, Immediate(HeapNumber::kExponentMask));
+      __ cmpl(rdi, Immediate(HeapNumber::kExponentMask));
+      __ j(equal, &call_builtin);
+      __ movsd(xmm0, FieldOperand(rcx, HeapNumber::kValueOffset));
+
+      __ bind(&store_double);
+      __ movsd(FieldOperand(rbx, rax, times_8, FixedDoubleArray::kHeaderSize),
+               xmm0);
+      __ incl(rax);
+      __ Integer32ToSmi(rax, rax);
+      __ movq(FieldOperand(rdx, JSArray::kLengthOffset), rax);
+      __ ret((argc + 1) * kPointerSize);
     }
 
     __ bind(&call_builtin);
@@ -1862,16 +1922,33 @@ MaybeObject* CallStubCompiler::CompileCallGlobal(JSObject* object,
     __ movq(Operand(rsp, (argc + 1) * kPointerSize), rdx);
   }
 
-  // Setup the context (function already in edi).
-  __ movq(rsi, FieldOperand(rdi, JSFunction::kContextOffset));
-
-  // Jump to the cached code (tail call).
-  __ IncrementCounter(COUNTERS->call_global_inline(), 1);
-  ASSERT(function->is_compiled());
-  Handle<Code> code(function->code());
-  ParameterCount expected(function->shared()->formal_parameter_count());
-  __ InvokeCode(code, expected, arguments(),
-                RelocInfo::CODE_TARGET, JUMP_FUNCTION);
+  // Call api functions without a receiver signature straight from the
+  // stub instead of through the HandleApiCall builtin.  Their type check
+  // always passes and the holder is the receiver.
+  CallOptimization optimization(function);
+  if (optimization.is_simple_api_call() &&
+      optimization.expected_receiver_type() == NULL) {
+    __ IncrementCounter(COUNTERS->call_global_fast_api(), 1);
+    __ movq(rdx, Operand(rsp, (argc + 1) * kPointerSize));
+    ReserveSpaceForFastApiCall(masm(), rax);
+    __ movq(Operand(rsp, 1 * kPointerSize), rdx);
+    Failure* failure;
+    bool success = GenerateFastApiCall(masm(), optimization, argc, &failure);
+    if (!success) {
+      return failure;
+    }
+  } else {
+    // Setup the context (function already in edi).
+    __ movq(rsi, FieldOperand(rdi, JSFunction::kContextOffset));
+
+    // Jump to the cached code (tail call).
+    __ IncrementCounter(COUNTERS->call_global_inline(), 1);
+    ASSERT(function->is_compiled());
+    Handle<Code> code(function->code());
+    ParameterCount expected(function->shared()->formal_parameter_count());
+    __ InvokeCode(code, expected, arguments(),
+                  RelocInfo::CODE_TARGET, JUMP_FUNCTION);
+  }
 
   // Handle call cache miss.
   __ bind(&miss);
@@ -2623,6 +2700,55 @@ void StubCompiler::GenerateLoadInterceptor(JSObject* object,
 }
 
 
+void StubCompiler::GenerateLoadInternalField(JSObject* holder,
+                                             Register holder_reg,
+                                             Register scratch1,
+                                             Register scratch2,
+                                             Register scratch3,
+                                             AccessorInfo* callback,
+                                             Label* miss) {
+  // The receiver and name registers are still needed on a miss, so the
+  // result is only moved to rax at the end.
+  int index = callback->internal_field_index();
+  __ movq(scratch2,
+          FieldOperand(holder_reg,
+                       holder->GetHeaderSize() + index * kPointerSize));
+  v8::InternalFieldAccessorType type = callback->internal_field_type();
+  if (type == v8::INTERNAL_FIELD_VALUE) {
+    __ movq(rax, scratch2);
+    __ ret(0);
+    return;
+  }
+
+  // Get the pointer stored in the field.  Aligned pointers are stored as
+  // smis, others in a proxy.  Leave NULL and fields holding anything else
+  // to the getter.
+  Label not_smi, pointer_loaded;
+  __ JumpIfNotSmi(scratch2, &not_smi);
+  __ testq(scratch2, scratch2);
+  __ j(zero, miss);
+  __ jmp(&pointer_loaded);
+  __ bind(&not_smi);
+  __ CmpObjectType(scratch2, PROXY_TYPE, scratch3);
+  __ j(not_equal, miss);
+  __ movq(scratch2, FieldOperand(scratch2, Proxy::kProxyOffset));
+  __ bind(&pointer_loaded);
+
+  int offset = callback->internal_field_offset();
+  if (type == v8::INTERNAL_FIELD_INT32) {
+    __ movl(scratch2, Operand(scratch2, offset));
+    __ Integer32ToSmi(rax, scratch2);
+  } else {
+    ASSERT(type == v8::INTERNAL_FIELD_DOUBLE);
+    __ movq(scratch3, Operand(scratch2, offset));
+    __ AllocateHeapNumber(scratch1, scratch2, miss);
+    __ movq(FieldOperand(scratch1, HeapNumber::kValueOffset), scratch3);
+    __ movq(rax, scratch1);
+  }
+  __ ret(0);
+}
+
+
 bool StubCompiler::GenerateLoadCallback(JSObject* object,
                                         JSObject* holder,
                                         Register receiver,
@@ -2642,6 +2768,13 @@ bool StubCompiler::GenerateLoadCallback(JSObject* object,
       CheckPrototypes(object, receiver, holder, scratch1,
                       scratch2, scratch3, name, miss);
 
+  if (callback->is_internal_field_accessor() &&
+      callback->internal_field_index() < holder->GetInternalFieldCount()) {
+    GenerateLoadInternalField(holder, reg, scratch1, scratch2, scratch3,
+                              callback, miss);
+    return true;
+  }
+
   Handle<AccessorInfo> callback_handle(callback);
 
   // Insert additional parameters into the stack frame above return address.
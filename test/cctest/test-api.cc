@@ -33,6 +33,7 @@
 #include "compilation-cache.h"
 #include "execution.h"
 #include "snapshot.h"
+#include "stub-cache.h"
 #include "platform.h"
 #include "utils.h"
 #include "cctest.h"
@@ -1551,6 +1552,82 @@ THREADED_TEST(InternalFieldsNativePointersAndExternal) {
 }
 
 
+THREADED_TEST(InternalFieldAccessors) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  Local<v8::FunctionTemplate> templ = v8::FunctionTemplate::New();
+  Local<v8::ObjectTemplate> instance_templ = templ->InstanceTemplate();
+  instance_templ->SetInternalFieldCount(2);
+  instance_templ->SetInternalFieldAccessor(v8_str("value"), 0);
+  instance_templ->SetInternalFieldAccessor(v8_str("i"), 1,
+                                           v8::INTERNAL_FIELD_INT32, 4);
+  instance_templ->SetInternalFieldAccessor(v8_str("d"), 1,
+                                           v8::INTERNAL_FIELD_DOUBLE, 8);
+  instance_templ->SetInternalFieldAccessor(v8_str("missing"), 2);
+  Local<v8::Object> obj = templ->GetFunction()->NewInstance();
+  env->Global()->Set(v8_str("obj"), obj);
+  CompileRun(
+      "function getValue() { return obj.value; }"
+      "function getInt() { return obj.i; }"
+      "function getDouble() { return obj.d; }"
+      "function getKeyedValue() { var key = 'value'; return obj[key]; }"
+      "function getKeyedInt() { var key = 'i'; return obj[key]; }"
+      "function getKeyedDouble() { var key = 'd'; return obj[key]; }"
+      "function getMissing() { return obj.missing; }"
+      "function run(f) {"
+      "  var result;"
+      "  for (var i = 0; i < 10; i++) result = f();"
+      "  return result;"
+      "}");
+
+  // The same C++ object is reached through an aligned pointer, stored as
+  // a smi, and through an unaligned one, stored in a proxy.
+  char* data = new char[40];
+  for (int i = 0; i < 2; i++) {
+    char* object = i == 0 ? data : data + 1;
+    obj->SetInternalField(0, v8_str("field"));
+    obj->SetPointerInInternalField(1, object);
+    int32_t int_value = -17;
+    double double_value = 1.5;
+    memcpy(object + 4, &int_value, sizeof(int_value));
+    memcpy(object + 8, &double_value, sizeof(double_value));
+    CHECK_EQ(v8_str("field"), CompileRun("run(getValue)"));
+    CHECK_EQ(v8_str("field"), CompileRun("run(getKeyedValue)"));
+    CHECK_EQ(-17, CompileRun("run(getInt)")->Int32Value());
+    CHECK_EQ(-17, CompileRun("run(getKeyedInt)")->Int32Value());
+    CHECK_EQ(1.5, CompileRun("run(getDouble)")->NumberValue());
+    CHECK_EQ(1.5, CompileRun("run(getKeyedDouble)")->NumberValue());
+    CHECK(CompileRun("run(getMissing)")->IsUndefined());
+
+    // The loads see changes made from C++.
+    obj->SetInternalField(0, v8::Integer::New(3));
+    int_value = 1 << 30;
+    double_value = -0.25;
+    memcpy(object + 4, &int_value, sizeof(int_value));
+    memcpy(object + 8, &double_value, sizeof(double_value));
+    CHECK_EQ(3, CompileRun("run(getValue)")->Int32Value());
+    CHECK_EQ(1 << 30, CompileRun("run(getInt)")->Int32Value());
+    CHECK_EQ(1 << 30, CompileRun("run(getKeyedInt)")->Int32Value());
+    CHECK_EQ(-0.25, CompileRun("run(getDouble)")->NumberValue());
+    CHECK_EQ(-0.25, CompileRun("run(getKeyedDouble)")->NumberValue());
+    HEAP->CollectAllGarbage(false);
+  }
+
+  // Fields that do not hold a pointer read as undefined.
+  obj->SetPointerInInternalField(1, NULL);
+  CHECK(CompileRun("run(getInt)")->IsUndefined());
+  CHECK(CompileRun("run(getKeyedDouble)")->IsUndefined());
+  obj->SetInternalField(1, v8_str("not a pointer"));
+  CHECK(CompileRun("run(getDouble)")->IsUndefined());
+
+  // The properties are read-only.
+  CHECK_EQ(3, CompileRun("obj.value = 4; obj.value")->Int32Value());
+
+  delete[] data;
+}
+
+
 THREADED_TEST(IdentityHash) {
   v8::HandleScope scope;
   LocalContext env;
@@ -4244,6 +4321,43 @@ THREADED_TEST(Enumerators) {
 }
 
 
+static v8::Handle<Value> GetTrue(Local<String> name, const AccessorInfo&) {
+  ApiTestFuzzer::Fuzz();
+  return v8::True();
+}
+
+
+static v8::Handle<v8::Array> DoubleKeysEnum(const AccessorInfo&) {
+  ApiTestFuzzer::Fuzz();
+  return v8::Handle<v8::Array>::Cast(CompileRun("double_keys"));
+}
+
+
+// Enumerators may return arrays with unboxed double elements.
+THREADED_TEST(EnumeratorsWithDoubleKeys) {
+  if (!i::FLAG_unbox_double_arrays) return;
+  v8::HandleScope scope;
+  v8::Handle<v8::ObjectTemplate> obj = ObjectTemplate::New();
+  obj->SetNamedPropertyHandler(GetTrue, NULL, NULL, NULL, DoubleKeysEnum);
+  LocalContext context;
+  context->Global()->Set(v8_str("k"), obj->NewInstance());
+  v8::Handle<v8::Array> keys = v8::Handle<v8::Array>::Cast(CompileRun(
+    "var double_keys = [0.5];"
+    "double_keys.push(2.5);"
+    "double_keys"));
+  CHECK(v8::Utils::OpenHandle(*keys)->HasFastDoubleElements());
+  v8::Handle<v8::Array> result = v8::Handle<v8::Array>::Cast(CompileRun(
+    "var result = [];"
+    "for (var prop in k) {"
+    "  result.push(prop);"
+    "}"
+    "result"));
+  CHECK_EQ(2, result->Length());
+  CHECK_EQ(v8_str("0.5"), result->Get(v8::Integer::New(0)));
+  CHECK_EQ(v8_str("2.5"), result->Get(v8::Integer::New(1)));
+}
+
+
 int p_getter_count;
 int p_getter_count2;
 
@@ -7366,6 +7480,50 @@ THREADED_TEST(CallICFastApi_SimpleSignature_Miss2) {
 }
 
 
+static v8::Handle<Value> FastApiCallback_Global(const v8::Arguments& args) {
+  ApiTestFuzzer::Fuzz();
+  CHECK_EQ(args.This(), args.Holder());
+  CHECK(args.This()->Equals(v8::Context::GetCurrent()->Global()));
+  CHECK(args.Data()->Equals(v8_str("global_data")));
+  CHECK(args.Callee()->Equals(
+      v8::Context::GetCurrent()->Global()->Get(v8_str("method"))));
+  if (args.Length() == 0) return v8::ThrowException(v8_str("no arguments"));
+  int sum = 0;
+  for (int i = 0; i < args.Length(); i++) sum += args[i]->Int32Value();
+  if (sum % 25 == 0) HEAP->CollectAllGarbage(false);
+  return v8::Integer::New(sum);
+}
+
+THREADED_TEST(CallICFastApi_Global) {
+  v8::HandleScope scope;
+  v8::Handle<v8::FunctionTemplate> method_templ =
+      v8::FunctionTemplate::New(FastApiCallback_Global,
+                                v8_str("global_data"));
+  v8::Handle<v8::ObjectTemplate> global_templ = v8::ObjectTemplate::New();
+  global_templ->Set(v8_str("method"), method_templ);
+  // Each context gets its own closure of the api function.
+  for (int i = 0; i < 2; i++) {
+    LocalContext context(NULL, global_templ);
+    GenerateSomeGarbage();
+    v8::TryCatch try_catch;
+    CompileRun(
+        "var result = 0;"
+        "var saved_result = 0;"
+        "function f(x) { return method(x, 1); }"
+        "for (var i = 0; i < 100; i++) {"
+        "  result += f(i);"
+        "  result += method(i);"
+        "}"
+        "saved_result = result;"
+        "method();");
+    CHECK(try_catch.HasCaught());
+    CHECK_EQ(v8_str("no arguments"), try_catch.Exception()->ToString());
+    CHECK_EQ(2 * 4950 + 100,
+             context->Global()->Get(v8_str("saved_result"))->Int32Value());
+  }
+}
+
+
 v8::Handle<Value> keyed_call_ic_function;
 
 static v8::Handle<Value> InterceptorKeyedCallICGetter(
@@ -10415,6 +10573,84 @@ THREADED_TEST(ExternalArrays) {
 }
 
 
+template <class ElementType>
+static void ExternalArrayKernelTestHelper(v8::ExternalArrayType array_type,
+                                          ElementType first) {
+  v8::HandleScope scope;
+  LocalContext context;
+  const int kElementCount = 64;
+  ElementType src_data[kElementCount];
+  ElementType dst_data[kElementCount];
+  double expected_sum = 0;
+  for (int i = 0; i < kElementCount; i++) {
+    src_data[i] = (i == 0) ? first : static_cast<ElementType>(i);
+    dst_data[i] = 0;
+    expected_sum += static_cast<ElementType>(src_data[i] + 1);
+  }
+  v8::Handle<v8::Object> src = v8::Object::New();
+  src->SetIndexedPropertiesToExternalArrayData(src_data,
+                                               array_type,
+                                               kElementCount);
+  v8::Handle<v8::Object> dst = v8::Object::New();
+  dst->SetIndexedPropertiesToExternalArrayData(dst_data,
+                                               array_type,
+                                               kElementCount);
+  context->Global()->Set(v8_str("src"), src);
+  context->Global()->Set(v8_str("dst"), dst);
+
+  // The loads and stores in the loop are inlined and patched to the
+  // receiver map on the first miss, so later iterations of the outer loop
+  // run without calling the inline caches.
+  v8::Handle<v8::Value> result =
+      CompileRun("function kernel(dst, src, n) {"
+                 "  var sum = 0;"
+                 "  for (var i = 0; i < n; i++) {"
+                 "    dst[i] = src[i] + 1;"
+                 "    sum += dst[i];"
+                 "  }"
+                 "  return sum;"
+                 "}"
+                 "var sum;"
+                 "for (var j = 0; j < 100; j++) sum = kernel(dst, src, 64);"
+                 "sum;");
+  CHECK_EQ(expected_sum, result->NumberValue());
+  for (int i = 0; i < kElementCount; i++) {
+    CHECK_EQ(static_cast<double>(static_cast<ElementType>(src_data[i] + 1)),
+             static_cast<double>(dst_data[i]));
+  }
+
+  // Out of range keys fall back on the inline caches.
+  result = CompileRun("function read(a, i) {"
+                      "  var x;"
+                      "  for (var j = 0; j < 2; j++) x = a[i];"
+                      "  return x;"
+                      "}"
+                      "read(src, 64) === undefined &&"
+                      "    read(src, -1) === undefined;");
+  CHECK_EQ(true, result->BooleanValue());
+
+  // So do receivers with the same map but dictionary elements.
+  v8::Handle<v8::Object> slow = v8::Object::New();
+  context->Global()->Set(v8_str("slow"), slow);
+  result = CompileRun("slow[100000] = 1;"
+                      "read(src, 1) + read(slow, 100000);");
+  CHECK_EQ(2.0, result->NumberValue());
+}
+
+
+THREADED_TEST(ExternalArrayKernel) {
+  ExternalArrayKernelTestHelper<int8_t>(v8::kExternalByteArray, -128);
+  ExternalArrayKernelTestHelper<uint8_t>(v8::kExternalUnsignedByteArray, 200);
+  ExternalArrayKernelTestHelper<int16_t>(v8::kExternalShortArray, -32768);
+  ExternalArrayKernelTestHelper<uint16_t>(v8::kExternalUnsignedShortArray,
+                                          60000);
+  ExternalArrayKernelTestHelper<int32_t>(v8::kExternalIntArray, -0x7FFFFFF0);
+  ExternalArrayKernelTestHelper<uint32_t>(v8::kExternalUnsignedIntArray,
+                                          0xFFFFFFF0u);
+  ExternalArrayKernelTestHelper<float>(v8::kExternalFloatArray, 0.5f);
+}
+
+
 void ExternalArrayInfoTestHelper(v8::ExternalArrayType array_type) {
   v8::HandleScope scope;
   LocalContext context;
@@ -11805,6 +12041,84 @@ TEST(MultipleIsolatesOnIndividualThreads) {
 }
 
 
+static int stub_cache_probes = 0;
+static int stub_cache_primary_hits = 0;
+static int stub_cache_secondary_hits = 0;
+static int stub_cache_misses = 0;
+
+
+static int* LookupStubCacheCounter(const char* name) {
+  if (strcmp(name, "c:V8.MegamorphicStubCacheProbes") == 0) {
+    return &stub_cache_probes;
+  } else if (strcmp(name, "c:V8.MegamorphicStubCachePrimaryHits") == 0) {
+    return &stub_cache_primary_hits;
+  } else if (strcmp(name, "c:V8.MegamorphicStubCacheSecondaryHits") == 0) {
+    return &stub_cache_secondary_hits;
+  } else if (strcmp(name, "c:V8.MegamorphicStubCacheMisses") == 0) {
+    return &stub_cache_misses;
+  }
+  return NULL;
+}
+
+
+// Runs a megamorphic property load in a fresh isolate whose stub cache is
+// sized by the flags, and checks that the generated probe code accounts
+// for every probe as a primary hit, a secondary hit or a miss.
+TEST(MegamorphicStubCacheCounters) {
+  // Counters are compiled into the megamorphic stubs, which come from the
+  // snapshot when there is one.
+  if (i::Snapshot::IsEnabled()) return;
+
+  bool saved_native_code_counters = i::FLAG_native_code_counters;
+  int saved_primary_size = i::FLAG_stub_cache_primary_size;
+  int saved_secondary_size = i::FLAG_stub_cache_secondary_size;
+  i::FLAG_native_code_counters = true;
+  i::FLAG_stub_cache_primary_size = 64;
+  i::FLAG_stub_cache_secondary_size = 16;
+
+  v8::Isolate* isolate = v8::Isolate::New();
+  isolate->Enter();
+  v8::V8::SetCounterFunction(LookupStubCacheCounter);
+  {
+    v8::HandleScope scope;
+    LocalContext context;
+    CHECK_EQ(64, i::Isolate::Current()->stub_cache()->table_size(
+        i::StubCache::kPrimary));
+    CHECK_EQ(16, i::Isolate::Current()->stub_cache()->table_size(
+        i::StubCache::kSecondary));
+    v8::Local<v8::Value> result = CompileRun(
+        "var objects = [];"
+        "for (var i = 0; i < 200; i++) {"
+        "  var o = { x: i };"
+        "  o['p' + i] = i;"
+        "  objects.push(o);"
+        "}"
+        "function load(o) { return o.x; }"
+        "var sum = 0;"
+        "for (var k = 0; k < 10; k++) {"
+        "  for (var i = 0; i < objects.length; i++) {"
+        "    sum += load(objects[i]);"
+        "  }"
+        "}"
+        "sum");
+    CHECK_EQ(10 * (199 * 200 / 2), result->Int32Value());
+  }
+  isolate->Exit();
+  isolate->Dispose();
+
+  i::FLAG_native_code_counters = saved_native_code_counters;
+  i::FLAG_stub_cache_primary_size = saved_primary_size;
+  i::FLAG_stub_cache_secondary_size = saved_secondary_size;
+
+  CHECK_GT(stub_cache_probes, 0);
+  CHECK_GT(stub_cache_misses, 0);
+  CHECK_GT(stub_cache_primary_hits + stub_cache_secondary_hits, 0);
+  CHECK_EQ(stub_cache_probes,
+           stub_cache_primary_hits + stub_cache_secondary_hits +
+           stub_cache_misses);
+}
+
+
 TEST(StringCheckMultipleContexts) {
   const char* code =
       "(function() { return \"a\".charAt(0); })()";
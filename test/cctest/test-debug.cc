@@ -1110,6 +1110,50 @@ TEST(BreakPointICStore) {
 }
 
 
+// Test that a break point can be set at a keyed store to an external array
+// which has been inlined in a loop.
+TEST(BreakPointInlinedExternalArrayStore) {
+  break_point_hit_count = 0;
+  v8::HandleScope scope;
+  DebugLocalContext env;
+  const int kElementCount = 4;
+  int32_t data[kElementCount] = { 0, 0, 0, 0 };
+  v8::Handle<v8::Object> array = v8::Object::New();
+  array->SetIndexedPropertiesToExternalArrayData(data,
+                                                 v8::kExternalIntArray,
+                                                 kElementCount);
+  const char* src = "function foo(a, x) {"
+                    "  for (var i = 0; i < 4; i++) {"
+                    "    a[i] = x;"
+                    "  }"
+                    "}";
+  v8::Local<v8::Function> foo = CompileFunction(&env, src, "foo");
+  v8::Handle<v8::Value> argv[2] = { array, v8::Integer::New(1) };
+
+  // Compile foo with the store inlined before the debugger is active.
+  foo->Call(env->Global(), 2, argv);
+  CHECK_EQ(1, data[3]);
+
+  v8::Debug::SetDebugEventListener(DebugEventBreakPointHitCount,
+                                   v8::Undefined());
+
+  // Run with breakpoint at "a[i] = x;".
+  int bp = SetBreakPoint(foo, 43);
+  argv[1] = v8::Integer::New(2);
+  foo->Call(env->Global(), 2, argv);
+  CHECK_EQ(4, break_point_hit_count);
+  CHECK_EQ(2, data[3]);
+
+  // Run without breakpoints.
+  ClearBreakPoint(bp);
+  foo->Call(env->Global(), 2, argv);
+  CHECK_EQ(4, break_point_hit_count);
+
+  v8::Debug::SetDebugEventListener(NULL);
+  CheckDebuggerUnloaded();
+}
+
+
 // Test that a break point can be set at an IC load location.
 TEST(BreakPointICLoad) {
   break_point_hit_count = 0;
@@ -1132,3 +1132,89 @@ TEST(TestSizeOfObjectsVsHeapIteratorPrecision) {
     CHECK_GT(size_of_objects_2 / 100, delta);
   }
 }
+
+
+static Code* FindFirstLoadIC(const char* function_name) {
+  Handle<String> name = FACTORY->LookupAsciiSymbol(function_name);
+  Object* value = Isolate::Current()->context()->global()->
+      GetProperty(*name)->ToObjectChecked();
+  CHECK(value->IsJSFunction());
+  Code* code = JSFunction::cast(value)->code();
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::CODE_TARGET) |
+                  RelocInfo::ModeMask(RelocInfo::CODE_TARGET_CONTEXT);
+  for (RelocIterator it(code, mode_mask); !it.done(); it.next()) {
+    Code* target = Code::GetCodeFromTargetAddress(it.rinfo()->target_address());
+    if (target->is_inline_cache_stub() && target->kind() == Code::LOAD_IC) {
+      return target;
+    }
+  }
+  UNREACHABLE();
+  return NULL;
+}
+
+
+TEST(InlineCachesWithLiveMapsSurviveGC) {
+  // If all inline caches are flushed this test is invalid.
+  if (FLAG_cleanup_ics_at_gc) return;
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("function Live() { this.x = 1; }"
+             "function Dead() { this.y = 2; }"
+             "var live = new Live();"
+             "var dead = new Dead();"
+             "function getLive(o) { return o.x; }"
+             "function getDead(o) { return o.y; }"
+             "getLive(live); getLive(live);"
+             "getDead(dead); getDead(dead);"
+             "Dead = dead = null;");
+  CHECK_EQ(MONOMORPHIC, FindFirstLoadIC("getLive")->ic_state());
+  CHECK_EQ(MONOMORPHIC, FindFirstLoadIC("getDead")->ic_state());
+
+  HEAP->CollectAllGarbage(false);
+
+  // The map of live is still reachable, so its load stub is kept.  The map
+  // of dead is not, so that inline cache is reset.
+  CHECK_EQ(MONOMORPHIC, FindFirstLoadIC("getLive")->ic_state());
+  CHECK_EQ(UNINITIALIZED, FindFirstLoadIC("getDead")->ic_state());
+}
+
+
+static Handle<JSObject> GetGlobalObject(const char* name) {
+  Handle<String> symbol = FACTORY->LookupAsciiSymbol(name);
+  Object* value = Isolate::Current()->context()->global()->
+      GetProperty(*symbol)->ToObjectChecked();
+  CHECK(value->IsJSObject());
+  return Handle<JSObject>(JSObject::cast(value));
+}
+
+
+TEST(MapCopiesShareDescriptorArrays) {
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("var a = { x: 1, y: 2 };"
+             "var b = { x: 1, y: 2 };"
+             "b.__proto__ = { z: 3 };"
+             "var c = { x: 1 };"
+             "var d = { x: 1 };"
+             "d.y = 2;"
+             "var e = { x: 1 };"
+             "e.__proto__ = { z: 3 };");
+  // Changing the prototype copies the map but keeps its descriptors.
+  Handle<JSObject> a = GetGlobalObject("a");
+  Handle<JSObject> b = GetGlobalObject("b");
+  CHECK(a->map() != b->map());
+  CHECK_EQ(a->map()->instance_descriptors(), b->map()->instance_descriptors());
+
+  // A map with a transition keeps its own descriptor array, and copies
+  // of it get one without the transition.
+  Handle<JSObject> c = GetGlobalObject("c");
+  Handle<JSObject> e = GetGlobalObject("e");
+  CHECK_EQ(2, c->map()->instance_descriptors()->number_of_descriptors());
+  CHECK(c->map()->instance_descriptors() != e->map()->instance_descriptors());
+  CHECK_EQ(1, e->map()->instance_descriptors()->number_of_descriptors());
+
+  // Sharing survives a full collection, which clears dead transitions.
+  HEAP->CollectAllGarbage(true);
+  CHECK_EQ(a->map()->instance_descriptors(), b->map()->instance_descriptors());
+  CHECK_EQ(1, e->map()->instance_descriptors()->number_of_descriptors());
+}
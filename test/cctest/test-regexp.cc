@@ -38,9 +38,8 @@
 #include "jsregexp.h"
 #include "regexp-macro-assembler.h"
 #include "regexp-macro-assembler-irregexp.h"
-#ifdef V8_INTERPRETED_REGEXP
 #include "interpreter-irregexp.h"
-#else  // V8_INTERPRETED_REGEXP
+#ifndef V8_INTERPRETED_REGEXP
 #ifdef V8_TARGET_ARCH_ARM
 #include "arm/macro-assembler-arm.h"
 #include "arm/regexp-macro-assembler-arm.h"
@@ -1268,7 +1267,8 @@ TEST(MacroAssemblerNativeLotsOfRegisters) {
   Isolate::Current()->clear_pending_exception();
 }
 
-#else  // V8_INTERPRETED_REGEXP
+#endif  // V8_INTERPRETED_REGEXP
+
 
 TEST(MacroAssembler) {
   V8::Initialize(NULL);
@@ -1318,7 +1318,11 @@ TEST(MacroAssembler) {
   Handle<String> f1_16 =
       FACTORY->NewStringFromTwoByte(Vector<const uc16>(str1, 6));
 
-  CHECK(IrregexpInterpreter::Match(array, f1_16, captures, 0));
+  CHECK(IrregexpInterpreter::Match(Isolate::Current(),
+                                   array,
+                                   f1_16,
+                                   captures,
+                                   0));
   CHECK_EQ(0, captures[0]);
   CHECK_EQ(3, captures[1]);
   CHECK_EQ(1, captures[2]);
@@ -1329,12 +1333,14 @@ TEST(MacroAssembler) {
   Handle<String> f2_16 =
       FACTORY->NewStringFromTwoByte(Vector<const uc16>(str2, 6));
 
-  CHECK(!IrregexpInterpreter::Match(array, f2_16, captures, 0));
+  CHECK(!IrregexpInterpreter::Match(Isolate::Current(),
+                                    array,
+                                    f2_16,
+                                    captures,
+                                    0));
   CHECK_EQ(42, captures[0]);
 }
 
-#endif  // V8_INTERPRETED_REGEXP
-
 
 TEST(AddInverseToTable) {
   v8::internal::V8::Initialize(NULL);
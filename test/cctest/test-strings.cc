@@ -273,6 +273,66 @@ TEST(Traverse) {
 }
 
 
+static void ReadWithCursor(Handle<String> flat, Handle<String> string) {
+  AssertNoAllocation no_alloc;
+  int length = flat->length();
+  CHECK_EQ(length, string->length());
+  StringCharacterCursor forwards(*string, kMaxInt);
+  for (int i = 0; i < length; i++) {
+    CHECK_EQ(flat->Get(i), forwards.Get(i));
+  }
+  // Reading a tree in order visits each cons string at most twice.
+  CHECK(forwards.steps() <= 2 * DEEP_DEPTH);
+  StringCharacterCursor backwards(*string, kMaxInt);
+  for (int i = length - 1; i >= 0; i--) {
+    CHECK_EQ(flat->Get(i), backwards.Get(i));
+  }
+  StringCharacterCursor strided(*string, kMaxInt);
+  for (int i = 0; i < length; i += 997) {
+    CHECK_EQ(flat->Get(i), strided.Get(i));
+    CHECK_EQ(flat->Get(length - 1 - i), strided.Get(length - 1 - i));
+  }
+  StringCharacterCursor leaves(*string, kMaxInt);
+  int i = 0;
+  while (i < length) {
+    int leaf_start;
+    String* leaf = leaves.LeafAt(i, &leaf_start);
+    CHECK_EQ(i, leaf_start);
+    CHECK(!StringShape(leaf).IsCons());
+    CHECK_EQ(flat->Get(i), leaf->Get(0));
+    i += leaf->length();
+  }
+}
+
+
+TEST(StringCharacterCursor) {
+  InitializeVM();
+  v8::HandleScope scope;
+  Handle<String> building_blocks[NUMBER_OF_BUILDING_BLOCKS];
+  ZoneScope zone(DELETE_ON_EXIT);
+  InitializeBuildingBlocks(building_blocks);
+  Handle<String> flat = ConstructBalanced(building_blocks);
+  FlattenString(flat);
+  ReadWithCursor(flat, ConstructLeft(building_blocks, DEEP_DEPTH));
+  ReadWithCursor(flat, ConstructRight(building_blocks, DEEP_DEPTH));
+  ReadWithCursor(flat, ConstructBalanced(building_blocks));
+  ReadWithCursor(flat, flat);
+
+  // A cursor gives up once it has visited too many cons strings.
+  Handle<String> left = ConstructLeft(building_blocks, DEEP_DEPTH);
+  AssertNoAllocation no_alloc;
+  int leaf_start;
+  StringCharacterCursor shallow(*left, 100);
+  CHECK(shallow.LeafAt(left->length() - 1, &leaf_start) != NULL);
+  CHECK_EQ(left->Get(left->length() - 1), shallow.Get(left->length() - 1));
+  CHECK(!shallow.has_given_up());
+  StringCharacterCursor deep(*left, 100);
+  CHECK(deep.LeafAt(0, &leaf_start) == NULL);
+  CHECK(deep.has_given_up());
+  CHECK_EQ(0, deep.Get(left->length() - 1));
+}
+
+
 static const int DEEP_ASCII_DEPTH = 100000;
 
 
@@ -347,6 +407,42 @@ TEST(Utf8Conversion) {
 }
 
 
+TEST(Utf8ConversionAsciiPrefix) {
+  // Check conversions of strings that are ascii up to a non-ascii
+  // character at every position within and across word boundaries.
+  InitializeVM();
+  v8::HandleScope handle_scope;
+  const int kLength = 40;
+  // U+00E9 -> C3 A9
+  char utf8[kLength + 2];
+  char buffer[kLength + 2];
+  for (int i = 0; i < kLength; i++) {
+    int pos = 0;
+    for (int j = 0; j < kLength; j++) {
+      if (j == i) {
+        utf8[pos++] = '\xC3';
+        utf8[pos++] = '\xA9';
+      } else {
+        utf8[pos++] = 'a' + j % 26;
+      }
+    }
+    utf8[pos] = '\0';
+    v8::Handle<v8::String> string = v8::String::New(utf8, kLength + 1);
+    CHECK_EQ(kLength, string->Length());
+    CHECK_EQ(kLength + 1, string->Utf8Length());
+    Handle<String> internal = v8::Utils::OpenHandle(*string);
+    for (int j = 0; j < kLength; j++) {
+      CHECK_EQ(j == i ? 0xE9 : 'a' + j % 26, internal->Get(j));
+    }
+    int chars_written;
+    int written = string->WriteUtf8(buffer, sizeof(buffer), &chars_written);
+    CHECK_EQ(kLength + 2, written);
+    CHECK_EQ(kLength, chars_written);
+    CHECK_EQ(0, strcmp(utf8, buffer));
+  }
+}
+
+
 TEST(ExternalShortStringAdd) {
   ZoneScope zone(DELETE_ON_EXIT);
 
@@ -481,3 +577,50 @@ TEST(CachedHashOverflow) {
     }
   }
 }
+
+
+static void CheckHashField(Vector<const char> chars) {
+  unibrow::Utf8InputBuffer<> buffer(chars.start(), chars.length());
+  int expected =
+      static_cast<int>(String::ComputeHashField(&buffer, chars.length()));
+  CHECK_EQ(expected, static_cast<int>(
+      StringHasher::HashSequentialString(chars.start(), chars.length())));
+  ScopedVector<uc16> two_byte(chars.length());
+  for (int i = 0; i < chars.length(); i++) two_byte[i] = chars[i];
+  CHECK_EQ(expected, static_cast<int>(
+      StringHasher::HashSequentialString(two_byte.start(), chars.length())));
+  // Symbol lookup hashes its UTF-8 key directly when it is ASCII.
+  Handle<String> symbol = FACTORY->LookupSymbol(chars);
+  CHECK_EQ(expected, static_cast<int>(symbol->hash_field()));
+}
+
+
+TEST(HashSequentialString) {
+  InitializeVM();
+  v8::HandleScope scope;
+  const char* strings[] = {
+      "", "a", "ab", "abc", "abcd", "abcde", "length", "prototype",
+      "0", "00", "01", "1", "9", "10", "123", "1a", "a1", "12345678",
+      "429496729", "4294967294", "4294967295", "4294967296", "9999999999",
+      "10000000000", "-1", "1.5", " 1", NULL
+  };
+  for (int i = 0; strings[i] != NULL; i++) {
+    CheckHashField(CStrVector(strings[i]));
+  }
+  // Lengths around the unrolled loop and the trivial hash limit.
+  static const int kLength = String::kMaxHashCalcLength + 3;
+  ScopedVector<char> chars(kLength);
+  for (int i = 0; i < kLength; i++) chars[i] = 'a' + (gen() % 26);
+  for (int length = 0; length < 40; length++) {
+    CheckHashField(Vector<const char>(chars.start(), length));
+  }
+  for (int length = kLength - 6; length <= kLength; length++) {
+    CheckHashField(Vector<const char>(chars.start(), length));
+  }
+  for (int i = 0; i < kLength; i++) chars[i] = '0' + (gen() % 10);
+  for (int start = 0; start < 3; start++) {
+    for (int length = 1; length < 14; length++) {
+      CheckHashField(Vector<const char>(chars.start() + start, length));
+    }
+  }
+}
@@ -0,0 +1,162 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Functions that only read 'arguments.length' and 'arguments[i]' read the
+// actual arguments from the stack frame instead of allocating an arguments
+// object.  Check that they see the same values as functions that do
+// allocate it, with and without arguments adaptor frames.
+
+function sum() {
+  var result = 0;
+  for (var i = 0; i < arguments.length; i++) result += arguments[i];
+  return result;
+}
+
+function sumWithParameters(a, b, c) {
+  var result = 0;
+  for (var i = 0; i < arguments.length; i++) result += arguments[i];
+  return result + a;
+}
+
+function sumAllocating() {
+  var args = arguments;
+  var result = 0;
+  for (var i = 0; i < args.length; i++) result += args[i];
+  return result;
+}
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(0, sum());
+  assertEquals(1, sum(1));
+  assertEquals(15, sum(1, 2, 3, 4, 5));
+  assertEquals(sumAllocating(1, 2, 3), sum(1, 2, 3));
+  assertEquals(2, sumWithParameters(1));
+  assertEquals(4, sumWithParameters(1, 2));
+  assertEquals(7, sumWithParameters(1, 2, 3));
+  assertEquals(16, sumWithParameters(1, 2, 3, 4, 5));
+}
+
+function element(i) { return arguments[i]; }
+assertEquals(0, element(0));
+assertEquals(2, element(1, 2));
+assertEquals("x", element(3, 1, 2, "x"));
+assertEquals(undefined, element(1));
+assertEquals(undefined, element(-1, 2));
+assertEquals(undefined, element(100, 1, 2, 3));
+assertEquals(2, element("1", 2));
+assertEquals(undefined, element("foo", 1));
+
+function length() { return arguments.length; }
+assertEquals(0, length());
+assertEquals(3, length(1, 2, 3));
+
+function callee() { return arguments.callee; }
+assertEquals(callee, callee());
+
+function keyedLength() { return arguments["length"]; }
+assertEquals(2, keyedLength(1, 2));
+
+Object.prototype[7] = "proto";
+assertEquals("proto", element(7, 1));
+delete Object.prototype[7];
+
+// The parameters and the arguments stay in sync when either is
+// assigned to.
+function assignParameter(a) {
+  a = 10;
+  return arguments[0];
+}
+assertEquals(10, assignParameter(1));
+assertEquals(10, assignParameter(1, 2));
+
+function assignParameterInner(a) {
+  (function() { a = 10; })();
+  return arguments[0];
+}
+assertEquals(10, assignParameterInner(1));
+
+function assignArguments(a) {
+  arguments[0] = 10;
+  return a;
+}
+assertEquals(10, assignArguments(1));
+
+function countParameter(a) {
+  a++;
+  return arguments[0];
+}
+assertEquals(2, countParameter(1));
+
+function parameterLoop(a) {
+  for (a in { x: 1 }) ;
+  return arguments[0];
+}
+assertEquals("x", parameterLoop(1));
+
+function functionDeclaration(a) {
+  function a() { }
+  return typeof arguments[0];
+}
+assertEquals("function", functionDeclaration(1));
+
+// Uses that let the arguments object escape.
+function escape() { return arguments; }
+var args = escape(1, 2);
+assertEquals(2, args.length);
+assertEquals("[object Arguments]", Object.prototype.toString.call(args));
+
+function callElement() { return arguments[0](); }
+assertEquals("[object Arguments]",
+             callElement(function() {
+               return Object.prototype.toString.call(this);
+             }));
+
+function deleteElement() {
+  delete arguments[0];
+  return arguments[0];
+}
+assertEquals(undefined, deleteElement(1));
+
+function namedProperty() { return arguments.toString(); }
+assertEquals("[object Arguments]", namedProperty());
+
+function withEval(a) {
+  eval("a = 5");
+  return arguments[0];
+}
+assertEquals(5, withEval(1));
+
+// f.arguments gives the arguments of the active invocation.
+function outer() { return inner(); }
+function inner() { return outer.arguments; }
+var fromAccessor = outer(1, 2);
+assertEquals(2, fromAccessor.length);
+assertEquals(1, fromAccessor[0]);
+function accessorFromFrame() {
+  return accessorFromFrame.arguments.length + arguments.length;
+}
+assertEquals(6, accessorFromFrame(1, 2, 3));
@@ -0,0 +1,140 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test indexOf, lastIndexOf and join on arrays with fast elements, which
+// are handled natively, and the cases that use the generic version.
+
+// Smis, heap numbers and strictly equal but distinct numbers.
+var numbers = [1, 2, 3, 1.5, 2, -0, NaN, 1];
+assertEquals(0, numbers.indexOf(1));
+assertEquals(7, numbers.lastIndexOf(1));
+assertEquals(1, numbers.indexOf(2));
+assertEquals(4, numbers.lastIndexOf(2));
+assertEquals(3, numbers.indexOf(1.5));
+assertEquals(5, numbers.indexOf(0));
+assertEquals(5, numbers.indexOf(-0));
+assertEquals(-1, numbers.indexOf(NaN));
+assertEquals(-1, numbers.lastIndexOf(NaN));
+assertEquals(-1, numbers.indexOf("1"));
+var heap_number = 1.5 * 2;
+assertEquals(2, numbers.indexOf(heap_number));
+assertEquals(0, [heap_number, 3].indexOf(3));
+
+// Start indices.
+assertEquals(7, numbers.indexOf(1, 1));
+assertEquals(7, numbers.indexOf(1, -1));
+assertEquals(0, numbers.indexOf(1, -100));
+assertEquals(-1, numbers.indexOf(1, 8));
+assertEquals(0, numbers.indexOf(1, undefined));
+assertEquals(7, numbers.indexOf(1, 0.5 + 0.6));
+assertEquals(7, numbers.indexOf(1, "1"));
+assertEquals(0, numbers.lastIndexOf(1, 6));
+assertEquals(4, numbers.lastIndexOf(2, -4));
+assertEquals(-1, numbers.lastIndexOf(2, -100));
+assertEquals(7, numbers.lastIndexOf(1, 100));
+assertEquals(0, numbers.lastIndexOf(1, undefined));
+assertEquals(-1, numbers.lastIndexOf(2, undefined));
+assertEquals(-1, [].indexOf(1));
+assertEquals(-1, [].lastIndexOf(1));
+var start = { valueOf: function() { return 2; } };
+assertEquals(4, numbers.indexOf(2, start));
+assertEquals(1, numbers.lastIndexOf(2, start));
+
+// Strings, including cons strings and symbols.
+var strings = ["foo", "bar", "foo" + "bar", "baz", "bar"];
+assertEquals(0, strings.indexOf("foo"));
+assertEquals(1, strings.indexOf("bar"));
+assertEquals(4, strings.lastIndexOf("bar"));
+var cons = "fooba";
+cons += "r";
+assertEquals(2, strings.indexOf(cons));
+assertEquals(-1, strings.indexOf("qux"));
+
+// Objects and oddballs are compared by identity.
+var o = {};
+var mixed = [null, o, undefined, true, {}, false, o];
+assertEquals(0, mixed.indexOf(null));
+assertEquals(1, mixed.indexOf(o));
+assertEquals(6, mixed.lastIndexOf(o));
+assertEquals(2, mixed.indexOf(undefined));
+assertEquals(2, mixed.indexOf());
+assertEquals(3, mixed.indexOf(true));
+assertEquals(5, mixed.lastIndexOf(false));
+assertEquals(-1, mixed.indexOf({}));
+
+// Holes do not match undefined, unless a prototype has the element.
+var holey = [1, , 3, undefined];
+assertEquals(3, holey.indexOf(undefined));
+assertEquals(3, holey.lastIndexOf(undefined));
+assertEquals(-1, [1, , 3].indexOf(undefined));
+Array.prototype[1] = 2;
+assertEquals(1, [1, , 3].indexOf(2));
+assertEquals(1, [1, , 3].lastIndexOf(2));
+assertEquals("1,2,3", [1, , 3].join());
+delete Array.prototype[1];
+Object.prototype[1] = undefined;
+assertEquals(1, [1, , 3].indexOf(undefined));
+delete Object.prototype[1];
+
+// Copy-on-write literals.
+function literal() { return [1, 2, 3]; }
+assertEquals(2, literal().indexOf(3));
+assertEquals("1-2-3", literal().join("-"));
+
+// Array-like receivers and dictionary elements use the generic version.
+var array_like = { length: 3, 0: "a", 1: "b", 2: "a" };
+assertEquals(2, Array.prototype.lastIndexOf.call(array_like, "a"));
+assertEquals("a,b,a", Array.prototype.join.call(array_like));
+var sparse = [];
+sparse[100000] = "x";
+sparse[5] = "y";
+assertEquals(5, sparse.indexOf("y"));
+assertEquals(100000, sparse.lastIndexOf("x"));
+
+// Join.
+assertEquals("", [].join());
+assertEquals("a", ["a"].join());
+assertEquals("1", [1].join("-"));
+assertEquals("a,b,c", ["a", "b", "c"].join());
+assertEquals("a,b,c", ["a", "b", "c"].join(undefined));
+assertEquals("abc", ["a", "b", "c"].join(""));
+assertEquals("a--b--c", ["a", "b", "c"].join("--"));
+assertEquals("1,-2,0,1073741823,-1073741824",
+             [1, -2, 0, 1073741823, -1073741824].join());
+assertEquals(",,a,,", [undefined, null, "a", , ,].join());
+assertEquals("ሴ,a,1", ["ሴ", "a", 1].join());
+assertEquals("aሴb", ["a", "b"].join("ሴ"));
+assertEquals("a1b", ["a", "b"].join(1));
+assertEquals("1.5,true,x", [1.5, true, "x"].join());
+var to_string = { toString: function() { return "o"; } };
+assertEquals("a,o", ["a", to_string].join());
+var cyclic = ["a"];
+cyclic.push(cyclic);
+assertEquals("a,", cyclic.join());
+assertEquals(1, [1].indexOf.length);
+assertEquals(1, [1].lastIndexOf.length);
+assertEquals(1, [1].join.length);
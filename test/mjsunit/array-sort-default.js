@@ -0,0 +1,93 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Arrays of numbers and strings without holes are sorted natively when
+// there is no comparison function.  The result must be the one of sorting
+// by the string values of the elements.
+
+function compareStrings(x, y) {
+  x = String(x);
+  y = String(y);
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+function checkSort(array) {
+  var expected = array.slice().sort(compareStrings);
+  var actual = array.slice().sort();
+  assertEquals(expected.length, actual.length);
+  for (var i = 0; i < expected.length; i++) {
+    assertEquals(String(expected[i]), String(actual[i]), "index " + i);
+  }
+}
+
+checkSort([3, 1, 2, 10, -1, -10, 0, 100, 21, 9, -9, 91, -91]);
+checkSort([1073741823, -1073741824, 1000000000, -1000000000, 999999999]);
+checkSort(["b", "a", "c", "aa", "", "ä", "ሴ", "B", "aሴ"]);
+checkSort([1.5, 2, -0.5, NaN, Infinity, -Infinity, 1e21, 1e-7, 0, -0]);
+checkSort([1, "1", 2, "10", 1.5, "a", -3, "-4"]);
+
+var smis = [];
+var doubles = [];
+var strings = [];
+for (var i = 0; i < 2000; i++) {
+  smis.push((i * 7919) % 4001 - 2000);
+  doubles.push(((i * 7919) % 4001 - 2000) / 7);
+  strings.push("s" + (i * 7919) % 1000 + (i % 2 ? "" : "ሴ"));
+}
+checkSort(smis);
+checkSort(doubles);
+checkSort(strings);
+checkSort(smis.concat(strings));
+
+// Cons strings are flattened before they are compared.
+var cons = [];
+for (var i = 0; i < 100; i++) {
+  cons.push(strings[i] + "--------------------" + strings[i + 1]);
+}
+checkSort(cons);
+
+// Equal keys keep their order.
+var mixed = ["1", 1, "1", 1.0, "2", 2];
+mixed.sort();
+assertEquals("string", typeof mixed[0]);
+assertEquals("number", typeof mixed[1]);
+assertEquals("string", typeof mixed[2]);
+assertEquals("number", typeof mixed[3]);
+
+// Arrays with holes, undefined or objects take the generic path.
+assertEquals([1, 2, , ], [2, , 1].sort());
+assertEquals([1, 2, undefined], [2, undefined, 1].sort());
+var object = { toString: function() { return "0"; } };
+var withObject = [2, object, 1].sort();
+assertEquals(object, withObject[0]);
+assertEquals([1, 2], withObject.slice(1));
+
+// Copy-on-write literals are copied before they are sorted.
+function literal() { return [3, 1, 2]; }
+assertEquals([1, 2, 3], literal().sort());
+assertEquals([3, 1, 2], literal());
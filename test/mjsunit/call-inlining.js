@@ -0,0 +1,137 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test calls to small global functions whose bodies are inlined at the
+// call site.  The callers contain loops so they are not compiled by the
+// full code generator.
+
+function add(a, b) { return a + b; }
+function getX(o) { return o.x; }
+function pick(c, a, b) { return c ? a : b; }
+function second(a, b) { return b; }
+function element(a, i) { return a[i]; }
+
+function sumAdd(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) sum = add(sum, i);
+  return sum;
+}
+
+assertEquals(45, sumAdd(10));
+assertEquals("ab", add("a", "b"));
+
+function sumX(objects) {
+  var sum = 0;
+  for (var i = 0; i < objects.length; i++) sum += getX(objects[i]);
+  return sum;
+}
+
+assertEquals(6, sumX([{x: 1}, {x: 2}, {y: 0, x: 3}]));
+assertTrue(isNaN(sumX([{x: 1}, {}])));
+
+function pickAll(n) {
+  var result = [];
+  for (var i = 0; i < n; i++) result.push(pick(i % 2, "odd", "even"));
+  return result.join();
+}
+
+assertEquals("even,odd,even", pickAll(3));
+
+// Missing arguments are undefined and extra arguments are evaluated.
+function argumentCount() {
+  var effects = 0;
+  var result = [];
+  for (var i = 0; i < 2; i++) {
+    result.push(second(1));
+    result.push(second(1, 2, effects++));
+  }
+  assertEquals(2, effects);
+  return result;
+}
+
+assertEquals([undefined, 2, undefined, 2], argumentCount());
+
+// Arguments are evaluated once and in order.
+function evaluationOrder() {
+  var log = [];
+  function f(x) { log.push(x); return x; }
+  var result = 0;
+  for (var i = 0; i < 2; i++) result = add(f(1), f(2));
+  assertEquals([1, 2, 1, 2], log);
+  return result;
+}
+
+assertEquals(3, evaluationOrder());
+
+// Keyed loads and exceptions from the inlined body.
+function elements(a) {
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) sum += element(a, i);
+  return sum;
+}
+
+assertEquals(10, elements([1, 2, 3, 4]));
+
+function getXOfUndefined() {
+  for (var i = 0; i < 1; i++) getX(undefined);
+}
+
+assertThrows(getXOfUndefined, TypeError);
+
+// Redefining the global function is noticed by the inlined code.
+function addTwice(a, b) {
+  var result = [];
+  for (var i = 0; i < 2; i++) {
+    result.push(add(a, b));
+    add = function(a, b) { return a * b; };
+  }
+  return result;
+}
+
+assertEquals([5, 6], addTwice(2, 3));
+assertEquals(6, add(2, 3));
+
+function callDeleted() {
+  for (var i = 0; i < 1; i++) deleted(1);
+}
+
+deleted = function(a) { return a; };
+callDeleted();
+delete deleted;
+assertThrows(callDeleted, ReferenceError);
+
+var notFunction = function(a) { return a; };
+
+function callNotFunction() {
+  var sum = 0;
+  for (var i = 0; i < 2; i++) sum += notFunction(i);
+  return sum;
+}
+
+assertEquals(1, callNotFunction());
+notFunction = 1;
+assertThrows(callNotFunction, TypeError);
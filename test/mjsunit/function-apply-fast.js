@@ -0,0 +1,116 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test Function.prototype.apply with arrays and arguments objects that
+// are copied onto the stack directly, and the cases that fall back to
+// the generic path.
+
+function collect() {
+  var result = [];
+  for (var i = 0; i < arguments.length; i++) result.push(arguments[i]);
+  return result;
+}
+
+function receiver() { return this; }
+
+function forward() { return collect.apply(this, arguments); }
+
+for (var i = 0; i < 5; i++) {
+  assertEquals([], collect.apply(null, []));
+  assertEquals([1, 2, 3], collect.apply(null, [1, 2, 3]));
+  assertEquals([1, "a", null], forward(1, "a", null));
+  assertEquals([], forward());
+  assertEquals([], collect.apply(null, null));
+  assertEquals([], collect.apply(null, undefined));
+}
+
+// Copy-on-write array literals.
+function literal() { return collect.apply(null, [4, 5, 6]); }
+assertEquals([4, 5, 6], literal());
+assertEquals([4, 5, 6], literal());
+
+// Holes are read through the prototype chain.
+var holey = [1, , 3];
+assertEquals([1, undefined, 3], collect.apply(null, holey));
+Object.prototype[1] = "proto";
+assertEquals([1, "proto", 3], collect.apply(null, holey));
+delete Object.prototype[1];
+Array.prototype[2] = "array";
+assertEquals([0, undefined, "array"], collect.apply(null, [0, , , ]));
+delete Array.prototype[2];
+
+// Array with a length larger than its backing store.
+var long_array = [1, 2];
+long_array.length = 5;
+assertEquals([1, 2, undefined, undefined, undefined],
+             collect.apply(null, long_array));
+
+// Arguments objects with a changed length.
+function shorter() {
+  arguments.length = 1;
+  return collect.apply(null, arguments);
+}
+assertEquals([1], shorter(1, 2, 3));
+function longer() {
+  arguments.length = 3;
+  return collect.apply(null, arguments);
+}
+assertEquals([1, undefined, undefined], longer(1));
+
+// Dictionary-mode arrays.
+var sparse = [];
+sparse[100000] = 1;
+sparse.length = 3;
+sparse[1] = 2;
+assertEquals([undefined, 2, undefined], collect.apply(null, sparse));
+
+// Receivers are converted as before.
+assertEquals(this, receiver.apply(null, [1]));
+assertEquals(this, receiver.apply(undefined, [1]));
+assertEquals("object", typeof receiver.apply(1, [1]));
+(function() {
+  assertEquals("object", typeof receiver.apply("s", arguments));
+})(1);
+var o = {};
+assertTrue(o === receiver.apply(o, [1]));
+
+// Errors are reported as before.
+assertThrows(function() { Function.prototype.apply.call({}, null, []); },
+             TypeError);
+assertThrows(function() { collect.apply(null, 1); }, TypeError);
+
+// Large arrays.
+var large = [];
+for (var i = 0; i < 10000; i++) large.push(i);
+var copied = collect.apply(null, large);
+assertEquals(10000, copied.length);
+assertEquals(9999, copied[9999]);
+assertEquals(10000, Math.max.apply(Math, large) + 1);
+
+var too_large = [];
+too_large.length = 1000000;
+assertThrows(function() { collect.apply(null, too_large); }, RangeError);
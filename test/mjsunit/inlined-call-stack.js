@@ -0,0 +1,64 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Calls to small global functions are inlined by the classic code
+// generator.  The frame of the inlined function must still show up when
+// the call throws.
+
+function load(a) { return a.x.y; }
+function callLoad(o) { return load(o); }
+
+function add(a) { return a + 1; }
+function callAdd(o) { return add(o); }
+
+function stackOf(f, arg) {
+  try {
+    f(arg);
+  } catch (e) {
+    return e.stack;
+  }
+  assertUnreachable();
+}
+
+for (var i = 0; i < 100; i++) {
+  assertEquals(1, callLoad({ x: { y: 1 } }));
+  assertEquals(i + 1, callAdd(i));
+  assertEquals(i + 1.5, callAdd(i + 0.5));
+}
+
+var stack = stackOf(callLoad, {});
+assertTrue(/at load /.test(stack));
+assertTrue(stack.indexOf("at load ") < stack.indexOf("at callLoad "));
+
+var throwing = { valueOf: function() { throw new Error("valueOf"); } };
+stack = stackOf(callAdd, throwing);
+assertTrue(/at add /.test(stack));
+assertTrue(stack.indexOf("at add ") < stack.indexOf("at callAdd "));
+
+assertEquals("x1", callAdd("x"));
+assertEquals(3, callAdd({ valueOf: function() { return 2; } }));
@@ -0,0 +1,139 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test load and store ICs on objects in dictionary mode, including
+// lookups that need more probes than the unrolled ones in the
+// generated code.
+
+function load(obj, i) {
+  switch (i % 4) {
+    case 0: return obj.alpha;
+    case 1: return obj.beta;
+    case 2: return obj.gamma;
+    default: return obj.delta;
+  }
+}
+
+function store(obj, value) {
+  obj.alpha = value;
+  obj.delta = value + 1;
+}
+
+function loadAbsent(obj) { return obj.missing; }
+
+// A large dictionary with a deleted entry, so it stays in dictionary
+// mode.  With this many keys some of them need long probe sequences.
+var dict = {};
+for (var i = 0; i < 300; i++) dict["key" + i] = i;
+dict.alpha = "a";
+dict.beta = "b";
+dict.gamma = "c";
+dict.delta = "d";
+delete dict.key0;
+
+var expected = ["a", "b", "c", "d"];
+for (var i = 0; i < 20; i++) {
+  assertEquals(expected[i % 4], load(dict, i));
+  assertEquals(undefined, loadAbsent(dict));
+}
+
+function loadKey(obj, name) { return obj[name]; }
+for (var round = 0; round < 3; round++) {
+  for (var i = 1; i < 300; i++) {
+    assertEquals(i, loadKey(dict, "key" + i));
+  }
+  assertEquals(undefined, loadKey(dict, "key0"));
+  assertEquals(undefined, loadKey(dict, "key300"));
+}
+
+for (var i = 0; i < 10; i++) {
+  store(dict, i);
+  assertEquals(i, dict.alpha);
+  assertEquals(i + 1, dict.delta);
+}
+
+// Deleting and re-adding properties keeps the remaining ones reachable.
+for (var i = 1; i < 300; i += 2) delete dict["key" + i];
+expected = [9, "b", "c", 10];
+for (var i = 0; i < 20; i++) {
+  assertEquals(expected[i % 4], load(dict, i));
+  assertEquals(undefined, loadAbsent(dict));
+}
+for (var i = 1; i < 300; i++) {
+  assertEquals(i % 2 == 0 ? i : undefined, dict["key" + i]);
+}
+dict.key1 = "again";
+assertEquals("again", dict.key1);
+
+// A configuration object that gets many properties added once and is
+// only read afterwards.
+function makeConfig() {
+  var config = {};
+  for (var i = 0; i < 60; i++) config["option" + i] = i * 2;
+  config.alpha = 1;
+  config.beta = 2;
+  config.gamma = 3;
+  config.delta = 4;
+  return config;
+}
+
+var config = makeConfig();
+for (var i = 0; i < 20; i++) {
+  assertEquals(i % 4 + 1, load(config, i));
+  assertEquals(undefined, loadAbsent(config));
+}
+for (var i = 0; i < 60; i++) {
+  assertEquals(i * 2, config["option" + i]);
+}
+
+// Adding and deleting properties after the loads still works.
+for (var i = 60; i < 100; i++) config["option" + i] = i * 2;
+delete config.option0;
+config.alpha = "changed";
+for (var i = 0; i < 20; i++) {
+  assertEquals(i % 4 == 0 ? "changed" : i % 4 + 1, load(config, i));
+}
+for (var i = 1; i < 100; i++) {
+  assertEquals(i * 2, config["option" + i]);
+}
+assertEquals(undefined, config.option0);
+
+// Other objects with the same shape are not affected.
+var other = makeConfig();
+other.beta = "other";
+for (var i = 0; i < 20; i++) {
+  assertEquals(i % 4 == 1 ? "other" : i % 4 + 1, load(other, i));
+}
+assertEquals(2, config.beta);
+
+// Enumeration order is preserved.
+var keys = Object.keys(makeConfig());
+assertEquals(64, keys.length);
+assertEquals("option0", keys[0]);
+assertEquals("option59", keys[59]);
+assertEquals("alpha", keys[60]);
+assertEquals("delta", keys[63]);
@@ -0,0 +1,94 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --expose-gc
+
+// Test that shallow object literals cloned in generated code are
+// independent copies of their boilerplate, also across garbage
+// collections.
+
+function point(x, y) {
+  return { x: x, y: y };
+}
+
+function constant() {
+  return { a: 1, b: "two", c: 3.5 };
+}
+
+function withElements() {
+  return { a: 1, 0: "zero" };
+}
+
+function withAccessor() {
+  return { a: 1, get b() { return this.a + 1; } };
+}
+
+var points = [];
+for (var i = 0; i < 1000; i++) {
+  points.push(point(i, -i));
+  if (i % 100 == 0) gc();
+}
+for (var i = 0; i < points.length; i++) {
+  assertEquals(i, points[i].x);
+  assertEquals(-i, points[i].y);
+}
+
+var first = constant();
+var second = constant();
+assertFalse(first === second);
+first.a = 42;
+first.d = "added";
+delete first.b;
+var third = constant();
+assertEquals(1, third.a);
+assertEquals("two", third.b);
+assertEquals(3.5, third.c);
+assertFalse("d" in third);
+assertEquals(1, second.a);
+
+for (var i = 0; i < 3; i++) {
+  var o = withElements();
+  assertEquals("zero", o[0]);
+  o[0] = i;
+  o[1] = i;
+  assertEquals(undefined, withElements()[1]);
+}
+
+for (var i = 0; i < 3; i++) {
+  var o = withAccessor();
+  o.a = i;
+  assertEquals(i + 1, o.b);
+  assertEquals(2, withAccessor().b);
+}
+
+var empty = [];
+for (var i = 0; i < 3; i++) {
+  empty.push({});
+  empty[i].p = i;
+}
+assertFalse("p" in {});
+assertEquals(2, empty[2].p);
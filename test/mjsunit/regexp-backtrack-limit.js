@@ -0,0 +1,98 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --regexp-backtrack-limit=100
+
+// Patterns without backreferences or lookaheads fall back to a linear-time
+// matcher when the native code runs out of backtracks.  Each of these
+// would take exponential time with backtracking alone.
+
+function repeat(string, count) {
+  var result = "";
+  for (var i = 0; i < count; i++) result += string;
+  return result;
+}
+
+var as = repeat("a", 40);
+assertNull(/(a+)+b/.exec(as));
+assertNull(/(a|aa)+b/.exec(as));
+assertNull(/(a*)*b/.exec(as));
+assertNull(/(x+x+)+y/.exec(repeat("x", 40)));
+assertNull(/^(\w+\s?)*$/.exec(repeat("word ", 20) + "!"));
+assertNull(/^(([a-z])+.)+[A-Z]([a-z])+$/.exec(repeat("a", 35) + "!"));
+assertNull(/(a+)+b/i.exec(repeat("aA", 20)));
+assertNull(/(?:[\s\S]*?a){12}b/.exec(as));
+assertFalse(/(a+)+b/.test(as));
+
+var match = /(a|aa)+\d|a{30}(x)/.exec(as + "x");
+assertEquals([repeat("a", 30) + "x", undefined, "x"], match);
+assertEquals(10, match.index);
+
+match = /^(a+)+(b)?$/.exec(as);
+assertEquals([as, as, undefined], match);
+
+assertEquals("!", (as + "b").replace(/(a+)+a(b)/, "!"));
+assertEquals("-a-", (as + "c").replace(/(a|aa)+c/, "-a-"));
+assertEquals(["", ""], (as + "b").split(/(?:a+)+b/));
+
+// Patterns with a backreference or lookahead keep the backtracking
+// matcher.
+assertEquals(["aa", "a"], /(a)\1/.exec("aa"));
+assertEquals(["a"], /a(?=b)/.exec("aab"));
+
+// The fallback matcher finds the same matches and captures as the
+// backtracking one.  A lookahead that always succeeds keeps the
+// backtracking matcher for the reference result.
+var subject = repeat("aabcd ab\nAB bbc 12-3 x yz Ää __ ", 40) + "end";
+var patterns = [
+  "a+b", "(a+)+b", "(a|ab)(c|bcd)(d*)", "^(\\w+)\\s(\\w+)$", "\\b\\w+\\b",
+  "\\Bb\\B", "(a*)*", "(a*)+b", "(?:a|b)*?c", "(a)|b", "x*y*z*", "[^a]+",
+  "(\\d{2,4})-(\\d{1,2}?)", "(?:(a)|b)+", "(a?){3}", "(a?)*?b", "()*",
+  "(|a)+", "[A-Z]+", "ä+", "^$", "$", ".*", "(\\w)+?\\s", "(?:(b)|(c))+d",
+  "[\\s\\S]{3,5}?z", "(a|b|c|d)*(b)", "(\\n|^)AB", "end$", "q|(e)nd",
+  "(_+)|(\\d+)", "[^\\W\\d]+_", "(((a)b)|c)*d", "([a]*?)*", "([ab]*?)*c",
+  "(?:(a*)b?)*?d", "(?:(?:(a?)b?)*c?)*d"
+];
+var flag_sets = ["", "i", "m", "g", "gim"];
+
+for (var i = 0; i < patterns.length; i++) {
+  for (var j = 0; j < flag_sets.length; j++) {
+    var flags = flag_sets[j];
+    var fallback = new RegExp(patterns[i], flags);
+    var reference = new RegExp("(?=)(?:" + patterns[i] + ")", flags);
+    var description = "/" + patterns[i] + "/" + flags;
+    var expected = reference.exec(subject);
+    var actual = fallback.exec(subject);
+    assertEquals(expected, actual, description);
+    if (expected !== null) {
+      assertEquals(expected.index, actual.index, description);
+    }
+    assertEquals(subject.replace(reference, "<$&|$1|$2>"),
+                 subject.replace(fallback, "<$&|$1|$2>"),
+                 description);
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --regexp-interpret-all
+
+// Run regexps with the bytecode interpreter instead of native code.
+
+function repeat(string, count) {
+  var result = "";
+  for (var i = 0; i < count; i++) result += string;
+  return result;
+}
+
+assertEquals(["foo", "o"], /f(o)o/.exec("afoob"));
+assertEquals(["fOO"], /foo/i.exec("xfOO"));
+assertNull(/^foo/.exec("xfoo"));
+assertEquals(["abab", "ab"], /(ab)\1/.exec("xxabab"));
+assertEquals(["AbaB", "Ab"], /(ab)\1/i.exec("xxAbaB"));
+assertEquals(["a1b2"], /[a-z]\d[a-z]\d/.exec("--a1b2--"));
+assertEquals(["bar"], /bar$/.exec("foobar"));
+assertEquals(["x\u1234y"], /x\u1234y/.exec("ax\u1234yb"));
+assertEquals(["\u1234\u1235"], /[\u1230-\u1240]+/.exec("ab\u1234\u1235c"));
+assertEquals("a-b-c", "a b c".replace(/ /g, "-"));
+assertEquals(["12", "34", "56"], "12 ab 34 cd 56".match(/\d+/g));
+
+var re = /o+/g;
+assertEquals("oo", re.exec("foo boo")[0]);
+assertEquals(3, re.lastIndex);
+assertEquals("oo", re.exec("foo boo")[0]);
+assertEquals(7, re.lastIndex);
+assertNull(re.exec("foo boo"));
+
+// Each iteration of the loop pushes onto the backtrack stack, which grows
+// beyond its initial size.
+var long_subject = repeat("a", 100000) + "c";
+var result = /(?:a|b)*c/.exec(long_subject);
+assertEquals(long_subject, result[0]);
+assertEquals(long_subject, /(?:a|b)*c/.exec(long_subject)[0]);
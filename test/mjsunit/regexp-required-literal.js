@@ -0,0 +1,111 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Regexps that contain a literal every match must contain search for the
+// literal before running the regexp code.  Check that the search does not
+// change the results, both for short subjects and for subjects long
+// enough to be matched in the runtime system.
+
+function repeat(string, count) {
+  var result = "";
+  for (var i = 0; i < count; i++) result += string;
+  return result;
+}
+
+var padding = repeat("x-y ", 100) + "\n";
+
+function test(re, subject, expected_index, expected_match) {
+  for (var i = 0; i < 2; i++) {
+    var prefix = (i == 0) ? "" : padding;
+    var result = re.exec(prefix + subject);
+    if (expected_index < 0) {
+      assertNull(result, re + " " + i);
+    } else {
+      assertEquals(expected_match, result[0], re + " " + i);
+      assertEquals(prefix.length + expected_index, result.index, re + " " + i);
+    }
+  }
+}
+
+// Literal at a fixed offset from the start of the match.
+test(/foo/, "a foo b", 2, "foo");
+test(/a.cde/, "abcdx abcde", 6, "abcde");
+test(/[a-c]{2}bar/, "cbar abbar", 5, "abbar");
+test(/(x)(y)zzz/, "xyzz xyzzz", 5, "xyzzz");
+test(/foo\d/, "foo foox foo7", 9, "foo7");
+
+// Literal at a varying offset.
+test(/a+bcd/, "abc aaabcd", 4, "aaabcd");
+test(/\w*ing\b/, "things running", 7, "running");
+test(/(?:ab|c)xyz/, "cxy abxyz", 4, "abxyz");
+test(/(foo)+bar/, "foofoo foobar", 7, "foobar");
+
+// Literal missing from the subject.
+test(/a.cde/, "abcd abcdf", -1);
+test(/\d+px/, "12 em 34pt", -1);
+
+// The literal occurs before the earliest possible start of a match.
+test(/..abc/, "abc xyabc", 4, "xyabc");
+test(/^abc/m, "xabc\nabc", 5, "abc");
+test(/^abc/, "xabc\nabc", -1);
+
+// Assertions that look at the character before the match.
+test(/\bfoo/, "xfoo foo", 5, "foo");
+test(/\Bfoo/, " foo xfoo", 6, "foo");
+
+// Global matching and lastIndex.
+var re = /a\d+b/g;
+var subject = padding + "a1b a22b xa333b";
+assertEquals(["a1b", "a22b", "a333b"], subject.match(re));
+re.lastIndex = padding.length + 1;
+assertEquals("a22b", re.exec(subject)[0]);
+assertEquals(padding.length + 8, re.lastIndex);
+assertEquals("a333b", re.exec(subject)[0]);
+assertNull(re.exec(subject));
+assertEquals(0, re.lastIndex);
+
+assertEquals(padding + "<1> <22> x<333>",
+             subject.replace(/a(\d+)b/g, "<$1>"));
+assertEquals(repeat("-", 300),
+             repeat("ab", 300).replace(/a(?:b)/g, "-"));
+
+// lastIndex near the end of the subject.
+re = /abc/g;
+re.lastIndex = 3;
+assertNull(re.exec("abc"));
+re = /x.abc/g;
+re.lastIndex = padding.length - 1;
+assertNull(re.exec(padding + "abc"));
+
+// Two-byte literals and subjects.
+test(/\u1234bc/, "abc \u1234bc", 4, "\u1234bc");
+test(/a\u1234/, "\u1234a a\u1234", 3, "a\u1234");
+test(/a\u1234/, "abcd", -1);
+
+// Ignore case regexps are not searched for literally.
+test(/foo/i, "FOO", 0, "FOO");
+test(/x+FOO/i, "xXfoo", 0, "xXfoo");
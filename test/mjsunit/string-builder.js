@@ -0,0 +1,108 @@
+// Copyright 2008 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Array.prototype.join, JSON.stringify and String.prototype.replace build
+// their results in a growable buffer that is widened to two-byte
+// characters when the first non-ASCII string is added.
+
+function repeat(string, count) {
+  var result = "";
+  for (var i = 0; i < count; i++) result += string;
+  return result;
+}
+
+// Joins that grow the buffer several times, with the first non-ASCII
+// string at different positions.
+for (var n = 0; n < 70; n += 3) {
+  var parts = [];
+  var expected = "";
+  for (var i = 0; i < n; i++) {
+    var part = (i == (n >> 1)) ? "\u00e9\u4e2d" : "part" + i;
+    parts.push(part);
+    expected += (i == 0 ? "" : "--") + part;
+  }
+  assertEquals(expected, parts.join("--"));
+  assertEquals(expected.replace(/--/g, ""), parts.join(""));
+}
+
+var numbers = [];
+for (var i = 0; i < 1000; i++) numbers.push(i);
+var joined = numbers.join(",");
+assertEquals(3889, joined.length);
+assertEquals("0,1,2", joined.substring(0, 5));
+assertEquals("998,999", joined.substring(joined.length - 7));
+assertEquals(numbers, joined.split(",").map(Number));
+
+// Holes, undefined, null and a space separator.
+assertEquals("1----x----", [1, , "x", undefined, null].join("--"));
+assertEquals("", [].join("--"));
+assertEquals("", [undefined, null].join(""));
+
+// Sparse arrays.
+var sparse = [];
+sparse[10000] = "b";
+sparse[5] = "a";
+sparse[20000] = "\u1234";
+assertEquals("ab\u1234", sparse.join(""));
+
+// JSON.stringify drops the keys of undefined values and puts back the
+// closing brackets after removing the trailing comma.
+assertEquals('{"a":[],"b":{},"c":[null,null],"d":{},"e":"\u00e9"}',
+             JSON.stringify({a: [], b: {}, c: [undefined, function() {}],
+                             d: {x: undefined}, e: "\u00e9"}));
+assertEquals('{"b":2}', JSON.stringify({a: undefined, b: 2, c: undefined}));
+assertEquals('[[[]],{"x":[{}]}]', JSON.stringify([[[]], {x: [{}]}]));
+assertEquals(undefined, JSON.stringify(undefined));
+var big = [];
+for (var i = 0; i < 500; i++) big.push({key: "value" + i, index: i});
+assertEquals(big, JSON.parse(JSON.stringify(big)));
+
+// Replace with slices of the subject.
+var subject = repeat("abc", 100);
+assertEquals("a[b|a|cabc]cabc", "abcabc".replace("b", "[$&|$`|$']"));
+assertEquals("axa" + subject.substring(2),
+             subject.replace("b", "x$`"));
+assertEquals("x\u00e9y", "xay".replace("a", "\u00e9"));
+assertEquals("\u00e9-x-y", "\u00e9xy".replace(/x/, function(m) {
+  return "-" + m + "-";
+}));
+assertEquals(repeat("ab\u00e9c", 100),
+             subject.replace(/c/g, function() { return "\u00e9c"; }));
+
+// The builders are not affected by accessors on Object.prototype.
+Object.prototype.__defineSetter__("buffer", function(v) {
+  throw "buffer leaked";
+});
+Object.prototype.__defineSetter__("length", function(v) {
+  throw "length leaked";
+});
+assertEquals("1,2", [1, 2].join());
+assertEquals("axc", "abc".replace("b", "x"));
+assertEquals('{"a":[1]}', JSON.stringify({a: [1]}));
+delete Object.prototype.buffer;
+delete Object.prototype.length;
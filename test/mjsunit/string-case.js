@@ -69,3 +69,26 @@ for (var i = 1; i <= 128; i <<= 1); {
     }
   }
 }
+
+// Strings of all lengths around the sixteen-character blocks, made of
+// the letters and the characters next to them.
+var boundaries = "@AZ[`az{";
+var boundariesLower = "@az[`az{";
+var boundariesUpper = "@AZ[`AZ{";
+for (var length = 0; length < 40; length++) {
+  for (var offset = 0; offset < boundaries.length; offset++) {
+    var str = "";
+    var strLower = "";
+    var strUpper = "";
+    for (var i = 0; i < length; i++) {
+      var index = (i + offset) % boundaries.length;
+      str += boundaries.charAt(index);
+      strLower += boundariesLower.charAt(index);
+      strUpper += boundariesUpper.charAt(index);
+    }
+    assertEquals(strLower, str.toLowerCase());
+    assertEquals(strUpper, str.toUpperCase());
+    assertEquals(strLower, strLower.toLowerCase());
+    assertEquals(strUpper, strUpper.toUpperCase());
+  }
+}
@@ -0,0 +1,115 @@
+// Copyright 2008 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Test charCodeAt, indexOf, substring and atom regexps on long cons
+// strings, which are read without flattening them until repeated
+// accesses make flattening worthwhile.
+
+function makeRope(parts, count) {
+  var rope = "";
+  for (var i = 0; i < count; i++) rope += parts[i % parts.length] + i;
+  return rope;
+}
+
+function flatCopy(string) {
+  // Building the string from its characters gives a flat string with the
+  // same contents.
+  var chars = [];
+  for (var i = 0; i < string.length; i++) chars.push(string.charAt(i));
+  return chars.join("");
+}
+
+var parts = ["<li>", "{{name}}", "</li>\n", "\u1234\u5678", "ab", "c"];
+
+function checkRope(makeOne) {
+  var flat = flatCopy(makeOne());
+  var length = flat.length;
+
+  // charCodeAt on fresh ropes, so that they are never flattened.
+  for (var i = 0; i < length; i += 97) {
+    assertEquals(flat.charCodeAt(i), makeOne().charCodeAt(i));
+  }
+  assertTrue(isNaN(makeOne().charCodeAt(length)));
+
+  // Sequential charCodeAt on one rope, which eventually flattens it.
+  var rope = makeOne();
+  for (var i = 0; i < length; i++) {
+    assertEquals(flat.charCodeAt(i), rope.charCodeAt(i));
+  }
+
+  // indexOf with matches inside leaves and across leaf boundaries.
+  var patterns = ["{{name}}", "</li>\n<li>", "\u5678ab", "c1", "b2", "\n",
+                  "7c", "z", "\u1234", "</li>\n\u1234\u5678ab"];
+  for (var p = 0; p < patterns.length; p++) {
+    var pattern = patterns[p];
+    var index = -1;
+    rope = makeOne();
+    do {
+      var expected = flat.indexOf(pattern, index + 1);
+      index = rope.indexOf(pattern, index + 1);
+      assertEquals(expected, index, pattern);
+    } while (index >= 0);
+    assertEquals(flat.indexOf(pattern, 100), makeOne().indexOf(pattern, 100));
+    var regexp = new RegExp(pattern);
+    var match = regexp.exec(makeOne());
+    assertEquals(flat.indexOf(pattern), match === null ? -1 : match.index);
+    assertEquals(flat.split(pattern).length, makeOne().split(pattern).length);
+  }
+
+  // Substrings of fresh ropes.
+  for (var i = 0; i + 50 < length; i += 173) {
+    assertEquals(flat.substring(i, i + 50), makeOne().substring(i, i + 50));
+    assertEquals(flat.substring(i), makeOne().substring(i));
+  }
+  rope = makeOne();
+  for (var i = 0; i + 20 < length; i += 7) {
+    assertEquals(flat.substring(i, i + 20), rope.substring(i, i + 20));
+  }
+}
+
+checkRope(function() { return makeRope(parts, 300); });
+checkRope(function() { return makeRope(["x", "yy", "zzz"], 500); });
+// Long leaves, so that walking the rope stays cheaper than flattening it.
+var longParts = [];
+for (var i = 0; i < parts.length; i++) {
+  var part = "";
+  for (var j = 0; j < 40; j++) part += parts[(i + j) % parts.length];
+  longParts.push(part);
+}
+checkRope(function() { return makeRope(longParts, 60); });
+// Right-leaning and balanced ropes.
+checkRope(function() {
+  var rope = "";
+  for (var i = 0; i < 300; i++) rope = parts[i % parts.length] + i + rope;
+  return rope;
+});
+checkRope(function() {
+  var a = makeRope(parts, 100);
+  var b = makeRope(parts.slice(1), 100);
+  return (a + b) + (b + a);
+});
@@ -0,0 +1,99 @@
+// Copyright 2008 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Test string searches that filter candidate positions on the first and
+// last pattern characters, for one-byte and two-byte subjects and
+// patterns, with matches at every position around the filter's block
+// boundaries.
+
+function naiveIndexOf(subject, pattern, start) {
+  outer: for (var i = start; i + pattern.length <= subject.length; i++) {
+    for (var j = 0; j < pattern.length; j++) {
+      if (subject.charCodeAt(i + j) != pattern.charCodeAt(j)) continue outer;
+    }
+    return i;
+  }
+  return -1;
+}
+
+function repeat(string, count) {
+  var result = "";
+  for (var i = 0; i < count; i++) result += string;
+  return result;
+}
+
+function makePattern(length, filler) {
+  // First and last characters also appear in the filler so that there are
+  // many candidates that fail in the middle.
+  var pattern = "a";
+  for (var i = 1; i < length - 1; i++) {
+    pattern += (i % 3 == 0) ? "a" : filler;
+  }
+  if (length > 1) pattern += "z";
+  return pattern;
+}
+
+function check(subject, pattern) {
+  var description = pattern.length + ":" + subject.length;
+  var expected = naiveIndexOf(subject, pattern, 0);
+  assertEquals(expected, subject.indexOf(pattern), description);
+  if (expected >= 0) {
+    assertEquals(naiveIndexOf(subject, pattern, expected + 1),
+                 subject.indexOf(pattern, expected + 1), description);
+  }
+  var regexp = new RegExp(pattern.replace(/[\\^$*+?.()|[\]{}]/g, "\\$&"));
+  var match = regexp.exec(subject);
+  assertEquals(expected, match === null ? -1 : match.index, description);
+  assertEquals(subject.split(pattern).join(pattern), subject, description);
+}
+
+var fillers = ["b", "\u1234"];
+var subjectFillers = ["ab", "a\u1234z", "a\u0100"];
+for (var f = 0; f < fillers.length; f++) {
+  for (var length = 1; length <= 64; length += (length < 20 ? 1 : 11)) {
+    var pattern = makePattern(length, fillers[f]);
+    for (var s = 0; s < subjectFillers.length; s++) {
+      var prefix = repeat(subjectFillers[s], 40);
+      // Place a match at offsets that cover every position within a
+      // sixteen byte block, and check the near misses around it.
+      for (var offset = 0; offset < 34; offset++) {
+        var head = prefix.substring(0, offset);
+        check(head + pattern + prefix, pattern);
+        check(head + pattern.substring(0, length - 1), pattern);
+        check(head + pattern.substring(1), pattern);
+        check(head + pattern, pattern);
+      }
+    }
+  }
+}
+
+// Two-byte patterns never match one-byte subjects.
+assertEquals(-1, repeat("ab", 40).indexOf("a\u1234"));
+assertEquals(-1, repeat("ab", 40).indexOf("\u1234"));
+assertEquals(-1, repeat("ab", 40).indexOf("ab\u0100b"));
+assertEquals(-1, repeat("ab", 40).indexOf("\u0100"));
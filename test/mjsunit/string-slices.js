@@ -0,0 +1,136 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Flags: --expose-gc --expose-externalize-string
+
+// Long sub strings share the characters of the string they are taken
+// from.  They must behave exactly like flat strings.
+
+var s = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+var two_byte = s.replace(/m/g, "\u03bc");
+
+function flat(string) {
+  var result = "";
+  for (var i = 0; i < string.length; i++) {
+    result += String.fromCharCode(string.charCodeAt(i));
+  }
+  return result;
+}
+
+function checkSubstrings(string) {
+  for (var start = 0; start < string.length; start += 7) {
+    for (var end = start; end <= string.length; end += 5) {
+      var expected = flat(string).substring(start, end);
+      var sub = string.substring(start, end);
+      assertEquals(end - start, sub.length);
+      assertEquals(expected, sub);
+      assertEquals(expected, string.slice(start, end));
+      assertEquals(expected, string.substr(start, end - start));
+      for (var i = 0; i < sub.length; i++) {
+        assertEquals(string.charCodeAt(start + i), sub.charCodeAt(i));
+        assertEquals(string.charAt(start + i), sub.charAt(i));
+        assertEquals(string[start + i], sub[i]);
+      }
+      // Slices of slices.
+      assertEquals(expected.substring(1, expected.length - 1),
+                   sub.substring(1, sub.length - 1));
+      assertEquals(expected.substring(14), sub.substring(14));
+    }
+  }
+}
+
+checkSubstrings(s);
+checkSubstrings(two_byte);
+checkSubstrings(s + s + s);
+checkSubstrings(two_byte + s);
+
+var long_string = s;
+for (var i = 0; i < 6; i++) long_string += long_string;
+checkSubstrings(long_string.substring(0, 300));
+
+// Hashing, comparison and property keys.
+var slice = s.substring(5, 25);
+var copy = flat("fghijklmnopqrstuvwxy");
+assertTrue(slice == copy);
+assertEquals(0, slice.localeCompare(copy));
+assertTrue(slice < s.substring(6, 26));
+var object = {};
+object[slice] = 42;
+assertEquals(42, object[copy]);
+assertEquals(42, object["fghijklmnopqrstuvwxy"]);
+assertTrue(copy in object);
+assertEquals([copy], Object.keys(object));
+
+// Conversions and other string builtins.
+assertEquals("FGHIJKLMNOPQRSTUVWXY", slice.toUpperCase());
+assertEquals("fghijklmnopqrstuvwxy", s.substring(41, 61).toLowerCase());
+assertEquals("abcdefghijklmnop", ("   " + s).substring(0, 19).trim());
+assertEquals(s.substring(5, 25) + s.substring(30, 45),
+             flat(slice) + flat(s.substring(30, 45)));
+assertEquals(12, slice.indexOf("r"));
+assertEquals(["fghijk", "mnopqrstuvwxy"], slice.split("l"));
+assertEquals(1234567890123, Number(s.substring(27, 36) + "0123"));
+assertEquals(123456789, parseInt(s.substring(27, 36) + "abcdefghij"));
+
+// Regular expressions on slices.
+var match = /^(f\w+?)(k+)?l(.*)$/.exec(slice);
+assertEquals(["fghijklmnopqrstuvwxy", "fghij", "k", "mnopqrstuvwxy"],
+             match);
+assertEquals(0, match.index);
+assertEquals(null, /^a/.exec(slice));
+assertEquals(["\u03bcnopq"], /\u03bc\w{4}/.exec(two_byte.substring(10, 30)));
+assertEquals("fghijk-L-mnopqrstuvwxy", slice.replace(/l/, "-L-"));
+assertEquals("ghij", slice.match(/g\w{3}/)[0]);
+assertEquals(5, slice.search(/k/));
+assertEquals(["", ""], slice.split(/\w+/));
+
+// Slices survive garbage collection, whether or not they keep their
+// parent alive.
+var slices = [];
+for (var i = 0; i < 20; i++) {
+  var parent = long_string.substring(i, long_string.length - i) + i;
+  slices.push(parent.substring(100, 120));
+  slices.push(parent.substring(10, parent.length - 10));
+}
+gc();
+gc();
+for (var i = 0; i < 20; i++) {
+  assertEquals(long_string.substring(100 + i, 120 + i), slices[2 * i]);
+  var expected = long_string.substring(10 + i, long_string.length - i) + i;
+  assertEquals(expected.substring(0, expected.length - 10),
+               slices[2 * i + 1]);
+}
+
+// Slices of external strings.
+var external = flat(s + s);
+externalizeString(external, false);
+var external_slice = external.substring(20, 50);
+assertEquals((s + s).substring(20, 50), external_slice);
+assertEquals(["uvwxyz0"], /u\w{6}/.exec(external_slice));
+gc();
+assertEquals((s + s).substring(20, 50), external_slice);
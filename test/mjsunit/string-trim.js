@@ -0,0 +1,74 @@
+// Copyright 2008 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Trimming white space in strings of various lengths, with white space
+// runs that cross the sixteen-character blocks used by the ASCII scanner.
+
+var whiteSpace = " \t\n\u000b\f\r";
+
+function space(length) {
+  var result = "";
+  for (var i = 0; i < length; i++) {
+    result += whiteSpace.charAt(i % whiteSpace.length);
+  }
+  return result;
+}
+
+function text(length) {
+  var result = "";
+  for (var i = 0; i < length; i++) {
+    result += (i == 0 || i == length - 1) ? "x" : (i % 3 ? "y" : " ");
+  }
+  return result;
+}
+
+var lengths = [0, 1, 2, 15, 16, 17, 31, 32, 33, 40];
+for (var i = 0; i < lengths.length; i++) {
+  for (var j = 0; j < lengths.length; j++) {
+    for (var k = 0; k < lengths.length; k++) {
+      var left = space(lengths[i]);
+      var middle = text(lengths[j]);
+      var right = space(lengths[k]);
+      var str = left + middle + right;
+      assertEquals(middle, str.trim());
+      assertEquals(middle ? middle + right : "", str.trimLeft());
+      assertEquals(middle ? left + middle : "", str.trimRight());
+      // The same string when it is flat.
+      str = str.substring(0, str.length - 1) + str.substring(str.length - 1);
+      assertEquals(middle, str.trim());
+    }
+  }
+}
+
+// Characters next to the white space range are not trimmed.
+assertEquals("\u0008x\u000e", "\u0008x\u000e".trim());
+assertEquals("\u001fx!", "\u001fx!".trim());
+
+// Non-ASCII white space, including in otherwise ASCII strings.
+assertEquals("x", "\u00a0 \u0085 x \u200b".trim());
+assertEquals("x y", " \u2028 x y \u3000".trim());
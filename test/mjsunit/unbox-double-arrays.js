@@ -0,0 +1,175 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Flags: --expose-gc --unbox-double-arrays
+
+// Arrays of numbers grown with a double keep their elements unboxed.
+// They must behave exactly like arrays of boxed numbers.
+
+function doubles(n) {
+  var result = [];
+  for (var i = 0; i < n; i++) result.push(i + 0.5);
+  return result;
+}
+
+function checkDoubles(a, n) {
+  assertEquals(n, a.length);
+  for (var i = 0; i < n; i++) assertEquals(i + 0.5, a[i]);
+}
+
+var a = doubles(100);
+checkDoubles(a, 100);
+assertEquals(undefined, a[100]);
+assertEquals(undefined, a[-1]);
+assertFalse(100 in a);
+assertTrue(99 in a);
+
+// Indexed stores, both in place and growing the array.
+a[0] = 7;
+a[1] = 1.25;
+a[a.length] = 2.75;
+assertEquals(7, a[0]);
+assertEquals(1.25, a[1]);
+assertEquals(101, a.length);
+assertEquals(2.75, a[100]);
+
+// Smi-only arrays switch to doubles when a double is stored.
+var b = [1, 2, 3];
+for (var i = 3; i < 20; i++) b[i] = i / 4;
+assertEquals([1, 2, 3, 0.75, 1], b.slice(0, 5));
+
+// Holes are read through the prototype chain.
+var c = doubles(10);
+c[15] = 1.5;
+assertEquals(16, c.length);
+assertFalse(12 in c);
+assertEquals(undefined, c[12]);
+Array.prototype[12] = "proto";
+assertEquals("proto", c[12]);
+delete Array.prototype[12];
+delete c[3];
+assertFalse(3 in c);
+assertEquals(undefined, c[3]);
+assertEquals(["0", "1", "2", "4", "5", "6", "7", "8", "9", "15"],
+             Object.keys(c));
+var keys = [];
+for (var key in c) keys.push(key);
+assertEquals(Object.keys(c), keys);
+
+// NaN, -0 and infinities are stored faithfully and are not holes.
+var d = doubles(20);
+d[1] = NaN;
+d[2] = -0;
+d[3] = Infinity;
+d[4] = -Infinity;
+d[5] = 0 / 0;
+assertTrue(isNaN(d[1]));
+assertTrue(1 in d);
+assertEquals(-Infinity, 1 / d[2]);
+assertEquals(Infinity, d[3]);
+assertEquals(-Infinity, d[4]);
+assertTrue(isNaN(d[5]));
+assertEquals(3, d.indexOf(Infinity));
+
+// Storing something else than a number boxes the elements again.
+var e = doubles(30);
+e[5] = "five";
+e[6] = {};
+assertEquals("five", e[5]);
+assertEquals("object", typeof e[6]);
+assertEquals(7.5, e[7]);
+e.push("x", 1.5);
+assertEquals(32, e.length);
+assertEquals("x", e[30]);
+
+// Pushing non-numbers onto a double array.
+var f = doubles(20);
+assertEquals(22, f.push(1.5, null));
+assertEquals(null, f[21]);
+checkDoubles(f.slice(0, 20), 20);
+
+// Length changes.
+var g = doubles(50);
+g.length = 10;
+checkDoubles(g, 10);
+assertFalse(10 in g);
+g.length = 40;
+assertFalse(10 in g);
+assertEquals(40, g.length);
+g[39] = 0.25;
+assertEquals(0.25, g[39]);
+
+// Array builtins.
+var h = doubles(40);
+assertEquals([2.5, 3.5, 4.5], h.slice(2, 5));
+assertEquals([38.5, 39.5], h.slice(-2));
+var hh = h.concat(h, doubles(3));
+assertEquals(83, hh.length);
+assertEquals(39.5, hh[39]);
+assertEquals(0.5, hh[40]);
+assertEquals(2.5, hh[82]);
+assertEquals(h.concat(["x"]).length, 41);
+assertEquals("x", h.concat([1, "x"])[41]);
+assertEquals(39.5, h.pop());
+assertEquals(0.5, h.shift());
+assertEquals(38, h.length);
+assertEquals(1.5, h[0]);
+h.reverse();
+assertEquals(38.5, h[0]);
+h.sort(function(x, y) { return x - y; });
+assertEquals(1.5, h[0]);
+assertEquals(38.5, h[37]);
+assertEquals("1.5,2.5,3.5", h.slice(0, 3).join());
+assertEquals([2.5, 3.5], h.splice(1, 2));
+assertEquals(36, h.length);
+assertEquals(4.5, h[1]);
+
+// Sorting arrays with holes moves the holes to the end.
+var s = [];
+for (var i = 0; i < 20; i++) s[i] = (20 - i) / 2;
+delete s[3];
+delete s[7];
+s.sort(function(x, y) { return x - y; });
+assertEquals(20, s.length);
+assertEquals(0.5, s[0]);
+assertEquals(10, s[17]);
+assertFalse(18 in s);
+assertFalse(19 in s);
+
+// Elements survive garbage collection in both generations.
+var gc_array = doubles(1000);
+gc();
+gc();
+checkDoubles(gc_array, 1000);
+
+// Sparse stores make the array a dictionary.
+var sparse = doubles(10);
+sparse[1000000] = 2.5;
+assertEquals(1000001, sparse.length);
+assertEquals(2.5, sparse[1000000]);
+checkDoubles(sparse.slice(0, 10), 10);
@@ -426,6 +426,8 @@
         '../../src/regexp-macro-assembler-tracer.h',
         '../../src/regexp-macro-assembler.cc',
         '../../src/regexp-macro-assembler.h',
+        '../../src/regexp-nfa.cc',
+        '../../src/regexp-nfa.h',
         '../../src/regexp-stack.cc',
         '../../src/regexp-stack.h',
         '../../src/register-allocator.h',